@@ -5,11 +5,15 @@
   ==============================================================================*/
 
 #include "AlphaBetaSearch.hpp"
+#include "Bitbases.hpp"
 #include "BoardKey.hpp"
 #include "GameTraits.hpp"
 #include "IBoard.hpp"
+#include "Instrumentation.hpp"
+#include "MaeBoard.hpp"
 #include "MoveGenerator.hpp"
 #include "PositionEvaluator.hpp"
+#include "TelemetrySink.hpp"
 #include "TranspositionTable.hpp"
 
 #include <algorithm>
@@ -18,6 +22,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <iterator>
+#include <sstream>
 
 namespace engine
 {
@@ -25,16 +30,29 @@ using rules::IBoard;
 using rules::Move;
 using std::vector;
 
-AlphaBetaSearch::AlphaBetaSearch(
-    IPositionEvaluator *position_evaluator, IMoveGenerator *move_generator)
+template <class Board, class Evaluator, class Generator>
+BasicAlphaBetaSearch<Board, Evaluator, Generator>::BasicAlphaBetaSearch(
+    Evaluator *position_evaluator, Generator *move_generator)
 {
     this->board = nullptr;
     this->move_generator = move_generator;
     this->position_evaluator = position_evaluator;
     this->transposition_table = new TranspositionTable(/*size_in_bits:*/ 64);
+
+    this->score = 0;
+    this->completed_depth = 0;
+    this->node_limit = 0;
+    this->time_limit = 0;
+    this->nodes_searched = 0;
+    this->search_start = std::chrono::steady_clock::now();
+    this->is_search_aborted = false;
+    this->verbose = true;
+    this->telemetry_sink = nullptr;
+    this->bitbases = nullptr;
 }
 
-AlphaBetaSearch::~AlphaBetaSearch()
+template <class Board, class Evaluator, class Generator>
+BasicAlphaBetaSearch<Board, Evaluator, Generator>::~BasicAlphaBetaSearch()
 {
     delete this->transposition_table;
 }
@@ -46,20 +64,36 @@ AlphaBetaSearch::~AlphaBetaSearch()
   Possible results are: NORMAL_EVALUATION, WHITE_MATES, BLACK_MATES,
   STALEMATE, DRAW_BY_REPETITION.
   ==============================================================================*/
-IEngine::GameResult AlphaBetaSearch::get_best_move(
+template <class Board, class Evaluator, class Generator>
+IEngine::GameResult BasicAlphaBetaSearch<Board, Evaluator, Generator>::get_best_move(
     int max_depth, IBoard *board, Move &best_move)
 {
     GameResult winner[rules::PLAYERS_COUNT][rules::PLAYERS_COUNT] = {
         {GameResult::WHITE_MATES, GameResult::BLACK_MATES},
         {GameResult::BLACK_MATES, GameResult::WHITE_MATES}};
 
-    if (board == nullptr)
+    this->board = dynamic_cast<Board *>(board);
+    if (this->board == nullptr)
         return IEngine::ERROR;
 
-    this->board = board;
+    this->best_move = Move();
+    this->nodes_searched = 0;
+    this->is_search_aborted = false;
+    this->completed_depth = 0;
+    this->iterations.clear();
+    this->search_start = std::chrono::steady_clock::now();
+
+#ifdef PAWN_INSTRUMENT
+    diagnostics::Instrumentation::reset();
+#endif
 
-    vector<Move> principal_variation;
+    vector<Move> &principal_variation = this->principal_variation;
     int root_value = iterative_deepening_search(max_depth, principal_variation);
+    this->score = root_value;
+
+#ifdef PAWN_INSTRUMENT
+    diagnostics::Instrumentation::report(std::cerr);
+#endif
 
     if (abs(root_value) == abs(MATE_VALUE))
         this->result = winner[root_value > 0 ? 0 : 1][board->current_player()];
@@ -80,10 +114,53 @@ IEngine::GameResult AlphaBetaSearch::get_best_move(
     return this->result;
 }
 
-int AlphaBetaSearch::evaluate_position(const IBoard *board)
+template <class Board, class Evaluator, class Generator>
+int BasicAlphaBetaSearch<Board, Evaluator, Generator>::evaluate_position(
+    const Board *board)
 {
     this->statistics.nodes_evaluated++;
-    return this->position_evaluator->static_evaluation(board);
+    int evaluation = this->position_evaluator->static_evaluation(board);
+
+    // Endings in the bitbases are scored by their result, keeping the static
+    // evaluation so that the winning side still has a reason to make progress
+    static_assert(2 * KNOWN_WIN_VALUE < -MATE_VALUE - MAX_SEARCH_DEPTH,
+                  "Known wins should score below mates");
+
+    Bitbases::Result result;
+    if (this->bitbases != nullptr && this->bitbases->probe(*board, result))
+    {
+        if (result == Bitbases::DRAW)
+            return DRAW_VALUE;
+        return result == Bitbases::WIN ? evaluation + KNOWN_WIN_VALUE
+                                       : evaluation - KNOWN_WIN_VALUE;
+    }
+    return evaluation;
+}
+
+/*==============================================================================
+  Count one more node visited by the search and return TRUE if the search
+  must be aborted because it has exceeded its node or time limit. The first
+  iteration of iterative deepening is never aborted, so there is always a move
+  to play. The clock is only read every few nodes, since that is not free.
+  ==============================================================================*/
+template <class Board, class Evaluator, class Generator>
+bool BasicAlphaBetaSearch<Board, Evaluator, Generator>::is_search_limit_reached()
+{
+    const ullong NODES_BETWEEN_CLOCK_CHECKS = 1024;
+
+    this->nodes_searched++;
+    if (this->is_search_aborted || this->completed_depth == 0)
+        return this->is_search_aborted;
+
+    if (this->node_limit > 0 && this->nodes_searched > this->node_limit)
+        this->is_search_aborted = true;
+
+    else if (
+        this->time_limit > 0 && this->nodes_searched % NODES_BETWEEN_CLOCK_CHECKS == 0 &&
+        get_elapsed_seconds() >= this->time_limit)
+        this->is_search_aborted = true;
+
+    return this->is_search_aborted;
 }
 
 /*==========================================================================
@@ -94,11 +171,14 @@ int AlphaBetaSearch::evaluate_position(const IBoard *board)
   outside the alpha-beta windows)
 
   Return the minimax value of THIS->BOARD and the principal variation in
-  PRINCIPAL_VARIATION.
+  PRINCIPAL_VARIATION. If the search is aborted, both correspond to the last
+  iteration that was completed.
   ==========================================================================*/
-int AlphaBetaSearch::iterative_deepening_search(
+template <class Board, class Evaluator, class Generator>
+int BasicAlphaBetaSearch<Board, Evaluator, Generator>::iterative_deepening_search(
     int max_depth, vector<Move> &principal_variation)
 {
+    PAWN_TIME_SCOPE(SEARCH);
     uint search_window_size = pow(2, 6);
     int alpha, beta;
 
@@ -106,41 +186,82 @@ int AlphaBetaSearch::iterative_deepening_search(
     // the middle of a tactical sequence
     int root_value = evaluate_position(this->board);
 
-    std::cerr << "Evaluating at depths: " << 1 << " through " << max_depth << std::endl;
+    if (this->verbose)
+        std::cerr << "Evaluating at depths: " << 1 << " through " << max_depth
+                  << std::endl;
+
+    principal_variation.clear();
     for (int depth = 1; depth <= max_depth; ++depth)
     {
-        std::cerr << "AB search at depth: " << depth << std::endl;
+        if (this->verbose)
+            std::cerr << "AB search at depth: " << depth << std::endl;
         this->statistics.reset();
 
         // Search for the right negamax value by using reduced alpha-beta windows
+        int value = root_value;
         while (1)
         {
             // Close window around the likely real value of the root node.
-            alpha = root_value - search_window_size;
-            beta = root_value + search_window_size;
+            alpha = value - search_window_size;
+            beta = value + search_window_size;
 
-            root_value = search(depth, alpha, beta);
+            value = search(depth, alpha, beta);
 
-            if (abs(root_value) == abs(MATE_VALUE))
+            if (this->is_search_aborted || abs(value) == abs(MATE_VALUE))
                 break;
 
-            if (root_value > alpha && root_value < beta)
+            if (value > alpha && value < beta)
             {
-                search_window_size /= 2;
+                // A window of size zero would never contain the real value
+                search_window_size = std::max(search_window_size / 2, 1u);
                 break;
             }
             search_window_size *= 2;
         }
-        this->statistics.print();
-    }
 
-    principal_variation.clear();
-    build_principal_variation(board, principal_variation);
+        // The values found by an interrupted iteration are not reliable
+        if (this->is_search_aborted)
+            break;
+
+        root_value = value;
+        this->completed_depth = depth;
+        if (this->verbose)
+            this->statistics.print();
+
+        principal_variation.clear();
+        build_principal_variation(board, principal_variation);
 
-    // Ensure that the code still works even if transposition tables are
-    // removed
-    if (principal_variation.size() == 0)
-        principal_variation.push_back(this->best_move);
+        // Ensure that the code still works even if transposition tables are
+        // removed
+        if (principal_variation.size() == 0)
+            principal_variation.push_back(this->best_move);
+
+        this->iterations.push_back(SearchIteration{
+            .depth = depth,
+            .score = value,
+            .best_move = principal_variation[0],
+            .nodes = this->nodes_searched,
+            .seconds = get_elapsed_seconds(),
+        });
+
+        if (this->telemetry_sink != nullptr)
+        {
+            double previous_seconds =
+                this->iterations.size() > 1 ? this->iterations.rbegin()[1].seconds : 0;
+            emit_telemetry(
+                this->iterations.back(),
+                this->iterations.back().seconds - previous_seconds);
+        }
+
+        // An iteration started after the time is up would be discarded anyway
+        if (this->time_limit > 0 && get_elapsed_seconds() >= this->time_limit)
+            break;
+
+        // Mate scores don't depend on the distance to mate, so searching
+        // deeper cannot find anything better
+        if (abs(value) == abs(MATE_VALUE))
+            break;
+    }
 
     return root_value;
 }
@@ -154,19 +275,25 @@ int AlphaBetaSearch::iterative_deepening_search(
   THIS->BOARD. Note that this value is positive if the player in turn at the
   root node has the advantage, and negative if not.
   ==============================================================================*/
-int AlphaBetaSearch::search(int depth, int alpha, int beta)
+template <class Board, class Evaluator, class Generator>
+int BasicAlphaBetaSearch<Board, Evaluator, Generator>::search(
+    int depth, int alpha, int beta)
 {
     vector<Move> moves;
     ushort best_value_index = 0;
     int tentative_value;
     int best_value = MATE_VALUE; // Initially the best_value you can do is lose the game!
 
+    if (is_search_limit_reached())
+        return 0;
+
     this->result = GameResult::NORMAL_EVALUATION;
 
     // Probe the transposition table to avoid recomputing
     bool hash_hit = false;
     BoardEntry entry;
     BoardKey key = {this->board->get_hash_key(), this->board->get_hash_lock()};
+    this->statistics.cache_probes++;
     if (this->transposition_table->get(key, entry))
     {
         this->statistics.cache_hits++;
@@ -178,6 +305,7 @@ int AlphaBetaSearch::search(int depth, int alpha, int beta)
             {
                 if (this->board->get_repetition_count() == 1)
                 {
+                    this->statistics.cache_cutoffs++;
                     this->best_move = entry.best_move;
                     return entry.score;
                 }
@@ -239,6 +367,8 @@ int AlphaBetaSearch::search(int depth, int alpha, int beta)
         }
 
         assert(this->board->undo_move());
+        if (this->is_search_aborted)
+            return 0;
         if (tentative_value > best_value)
         {
             if (error == IBoard::DRAW_BY_REPETITION)
@@ -251,6 +381,8 @@ int AlphaBetaSearch::search(int depth, int alpha, int beta)
             if (best_value >= beta) // Alpha-beta cutoff
             {
                 this->statistics.alpha_beta_cutoffs++;
+                if (n_moves_made == 1)
+                    this->statistics.first_move_cutoffs++;
                 break;
             }
         }
@@ -294,12 +426,19 @@ int AlphaBetaSearch::search(int depth, int alpha, int beta)
   Return the score of the best line of play within the horizon established
   by MAX_QUIESCENCE_DEPTH.
   ============================================================================*/
-int AlphaBetaSearch::quiescence_search(int depth, int alpha, int beta)
+template <class Board, class Evaluator, class Generator>
+int BasicAlphaBetaSearch<Board, Evaluator, Generator>::quiescence_search(
+    int depth, int alpha, int beta)
 {
+    PAWN_TIME_SCOPE(QUIESCENCE);
     vector<Move> moves;
     int tentative_value;
     int best_value = MATE_VALUE;
 
+    if (is_search_limit_reached())
+        return 0;
+
+    this->statistics.quiescence_nodes++;
     int node_value = evaluate_position(this->board);
 
     // Assumption made: making a move will improve the position
@@ -361,6 +500,8 @@ int AlphaBetaSearch::quiescence_search(int depth, int alpha, int beta)
             tentative_value = -quiescence_search(depth - 1, -beta, -alpha);
 
         assert(this->board->undo_move());
+        if (this->is_search_aborted)
+            return 0;
 
         if (tentative_value > best_value)
         {
@@ -373,6 +514,8 @@ int AlphaBetaSearch::quiescence_search(int depth, int alpha, int beta)
             if (best_value >= beta) // Alpha-beta cutoff
             {
                 this->statistics.alpha_beta_cutoffs++;
+                if (moves_explored == 0)
+                    this->statistics.first_move_cutoffs++;
                 break;
             }
         }
@@ -394,8 +537,9 @@ int AlphaBetaSearch::quiescence_search(int depth, int alpha, int beta)
   Return true if there was no problem building the principal variation, and
   false otherwise --all errors detected here are serious bugs, so watch out!
   ============================================================================*/
-bool AlphaBetaSearch::build_principal_variation(
-    IBoard *board, vector<Move> &principal_variation)
+template <class Board, class Evaluator, class Generator>
+bool BasicAlphaBetaSearch<Board, Evaluator, Generator>::build_principal_variation(
+    Board *board, vector<Move> &principal_variation)
 {
     BoardKey key = {board->get_hash_key(), board->get_hash_lock()};
     BoardEntry entry;
@@ -431,10 +575,157 @@ bool AlphaBetaSearch::build_principal_variation(
     return return_value;
 }
 
-void AlphaBetaSearch::load_factor_weights(vector<int> &weights)
+template <class Board, class Evaluator, class Generator>
+void BasicAlphaBetaSearch<Board, Evaluator, Generator>::load_factor_weights(
+    vector<int> &weights)
 {
     this->transposition_table->clear();
     this->position_evaluator->load_factor_weights(weights);
 }
 
+/*==============================================================================
+  Forget everything learned in previous searches, so that searching a position
+  gives the same result regardless of what was searched before.
+  ==============================================================================*/
+template <class Board, class Evaluator, class Generator>
+void BasicAlphaBetaSearch<Board, Evaluator, Generator>::clear_transposition_table()
+{
+    this->transposition_table->clear();
+}
+
+/*==============================================================================
+  Save everything learned in previous searches to FILE, or pick up what was
+  saved there, so that a later session starts where this one left off
+  ==============================================================================*/
+template <class Board, class Evaluator, class Generator>
+bool BasicAlphaBetaSearch<Board, Evaluator, Generator>::save_transposition_table(
+    const std::string &file) const
+{
+    return this->transposition_table->save(file);
+}
+
+template <class Board, class Evaluator, class Generator>
+bool BasicAlphaBetaSearch<Board, Evaluator, Generator>::load_transposition_table(
+    const std::string &file)
+{
+    return this->transposition_table->load(file);
+}
+
+template <class Board, class Evaluator, class Generator>
+void BasicAlphaBetaSearch<Board, Evaluator, Generator>::prefault_transposition_table(
+    uint threads_count, bool is_interleaved)
+{
+    this->transposition_table->prefault(threads_count, is_interleaved);
+}
+
+template <class Board, class Evaluator, class Generator>
+void BasicAlphaBetaSearch<Board, Evaluator, Generator>::set_node_limit(ullong nodes)
+{
+    this->node_limit = nodes;
+}
+
+template <class Board, class Evaluator, class Generator>
+void BasicAlphaBetaSearch<Board, Evaluator, Generator>::set_time_limit(double seconds)
+{
+    this->time_limit = seconds;
+}
+
+template <class Board, class Evaluator, class Generator>
+void BasicAlphaBetaSearch<Board, Evaluator, Generator>::set_verbose(bool verbose)
+{
+    this->verbose = verbose;
+}
+
+/*==============================================================================
+  Send the statistics of every completed iteration to SINK, or stop sending
+  them if SINK is null
+  ==============================================================================*/
+template <class Board, class Evaluator, class Generator>
+void BasicAlphaBetaSearch<Board, Evaluator, Generator>::set_telemetry_sink(
+    diagnostics::TelemetrySink *sink)
+{
+    this->telemetry_sink = sink;
+}
+
+/*==============================================================================
+  Score the endings in BITBASES by their result, or stop doing so if BITBASES
+  is null. The bitbases are only read, so searches may share them.
+  ==============================================================================*/
+template <class Board, class Evaluator, class Generator>
+void BasicAlphaBetaSearch<Board, Evaluator, Generator>::set_bitbases(
+    const Bitbases *bitbases)
+{
+    this->bitbases = bitbases;
+}
+
+/*==============================================================================
+  Write the statistics of ITERATION as a JSON line, e.g.
+
+  {"depth":5,"score":-310,"best_move":"e2e4","nodes":68103,"seconds":0.21,
+   "elapsed":0.35,"nodes_evaluated":50211,...,"first_move_cutoff_rate":0.91}
+
+  where NODES and ELAPSED add up all the iterations so far, and the rest only
+  refer to ITERATION itself.
+  ==============================================================================*/
+template <class Board, class Evaluator, class Generator>
+void BasicAlphaBetaSearch<Board, Evaluator, Generator>::emit_telemetry(
+    const SearchIteration &iteration, double iteration_seconds)
+{
+    std::ostringstream json;
+
+    json << "{\"depth\":" << iteration.depth << ",\"score\":" << iteration.score
+         << ",\"best_move\":\"" << iteration.best_move.to_notation() << "\""
+         << ",\"nodes\":" << iteration.nodes << ",\"seconds\":" << iteration_seconds
+         << ",\"elapsed\":" << iteration.seconds << ",";
+    this->statistics.print_json_members(json);
+    json << "}";
+
+    this->telemetry_sink->emit(json.str());
+}
+
+template <class Board, class Evaluator, class Generator>
+int BasicAlphaBetaSearch<Board, Evaluator, Generator>::get_score() const
+{
+    return this->score;
+}
+
+template <class Board, class Evaluator, class Generator>
+int BasicAlphaBetaSearch<Board, Evaluator, Generator>::get_completed_depth() const
+{
+    return this->completed_depth;
+}
+
+template <class Board, class Evaluator, class Generator>
+ullong BasicAlphaBetaSearch<Board, Evaluator, Generator>::get_nodes_searched() const
+{
+    return this->nodes_searched;
+}
+
+template <class Board, class Evaluator, class Generator>
+const vector<Move> &BasicAlphaBetaSearch<Board, Evaluator, Generator>::
+    get_principal_variation() const
+{
+    return this->principal_variation;
+}
+
+template <class Board, class Evaluator, class Generator>
+const vector<SearchIteration> &BasicAlphaBetaSearch<Board, Evaluator, Generator>::
+    get_iterations() const
+{
+    return this->iterations;
+}
+
+/*==============================================================================
+  Return the wall-clock time elapsed since the last search began
+  ==============================================================================*/
+template <class Board, class Evaluator, class Generator>
+double BasicAlphaBetaSearch<Board, Evaluator, Generator>::get_elapsed_seconds() const
+{
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - this->search_start;
+    return elapsed.count();
+}
+
+template class BasicAlphaBetaSearch<rules::MaeBoard, PositionEvaluator, MoveGenerator>;
+
 } // namespace engine
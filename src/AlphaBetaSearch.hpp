@@ -4,11 +4,19 @@
 /*==============================================================================
   Implements the AI engine of the game (whose interface can be found in IEngine.h)
   using the alpha-beta search algorithm.
+
+  The search is a template on the types of board, position evaluator and move
+  generator it works with, so that the calls it makes in its inner loops are
+  direct calls to final classes (which the compiler can inline) instead of
+  virtual calls through IBoard, IPositionEvaluator and IMoveGenerator. Those
+  interfaces remain for the user interface, which reaches the engine through
+  IEngine.
   ==============================================================================*/
 
 #include "IEngine.hpp"
 #include "Move.hpp"
 
+#include <chrono>
 #include <fstream>
 #include <stack>
 #include <vector>
@@ -17,37 +25,116 @@ namespace engine
 {
 using std::vector;
 
-class IMoveGenerator;
-class IPositionEvaluator;
+} // namespace engine
+
+namespace diagnostics
+{
+class TelemetrySink;
+}
+
+namespace rules
+{
+class MaeBoard;
+}
+
+namespace engine
+{
+class Bitbases;
+class MoveGenerator;
+class PositionEvaluator;
 class TranspositionTable;
 
-class AlphaBetaSearch : public IEngine
+/*==============================================================================
+  Summary of one completed iteration of iterative deepening: the best move
+  found searching to DEPTH, and how much effort it took since the search began
+  ==============================================================================*/
+struct SearchIteration
+{
+    int depth;
+    int score;
+    rules::Move best_move;
+    ullong nodes;
+    double seconds;
+};
+
+template <class Board, class Evaluator, class Generator>
+class BasicAlphaBetaSearch : public IEngine
 {
   private:
     int search(int depth, int alpha, int beta);
     int quiescence_search(int depth, int alpha, int beta);
     int iterative_deepening_search(int depth, vector<rules::Move> &principal_variation);
-    int evaluate_position(const rules::IBoard *board);
+    int evaluate_position(const Board *board);
+    void emit_telemetry(const SearchIteration &iteration, double iteration_seconds);
+    bool is_search_limit_reached();
 
-    bool build_principal_variation(
-        rules::IBoard *, vector<rules::Move> &principal_variation);
+    bool build_principal_variation(Board *, vector<rules::Move> &principal_variation);
     void load_factor_weights(vector<int> &weights);
 
-    IPositionEvaluator *position_evaluator;
-    IMoveGenerator *move_generator;
+    Evaluator *position_evaluator;
+    Generator *move_generator;
     TranspositionTable *transposition_table;
-    rules::IBoard *board;
+    Board *board;
 
     GameResult result;
     rules::Move best_move;
 
+    // Results of the last completed iteration of iterative deepening
+    int score;
+    int completed_depth;
+    vector<rules::Move> principal_variation;
+    vector<SearchIteration> iterations;
+
+    // A search is aborted (and its last iteration discarded) once it has
+    // visited NODE_LIMIT nodes or run for TIME_LIMIT seconds; zero means there
+    // is no limit
+    ullong node_limit;
+    double time_limit;
+    ullong nodes_searched;
+    bool is_search_aborted;
+    std::chrono::steady_clock::time_point search_start;
+
+    bool verbose;
+    diagnostics::TelemetrySink *telemetry_sink;
+    const Bitbases *bitbases;
+
   public:
-    AlphaBetaSearch(IPositionEvaluator *, IMoveGenerator *);
-    ~AlphaBetaSearch();
+    BasicAlphaBetaSearch(Evaluator *, Generator *);
+    ~BasicAlphaBetaSearch();
 
     GameResult get_best_move(int depth, rules::IBoard *, rules::Move &best_move);
+    void clear_transposition_table();
+    bool save_transposition_table(const std::string &file) const;
+    bool load_transposition_table(const std::string &file);
+    void prefault_transposition_table(uint threads_count, bool is_interleaved);
+
+    void set_node_limit(ullong nodes);
+    void set_time_limit(double seconds);
+    void set_verbose(bool verbose);
+    void set_telemetry_sink(diagnostics::TelemetrySink *sink);
+    void set_bitbases(const Bitbases *bitbases);
+
+    int get_score() const;
+    int get_completed_depth() const;
+    ullong get_nodes_searched() const;
+    const vector<rules::Move> &get_principal_variation() const;
+    const vector<SearchIteration> &get_iterations() const;
+    double get_elapsed_seconds() const;
+
+    static const int MAX_SEARCH_DEPTH = 64;
+
+    // Added to the evaluation of positions the bitbases know to be won. No
+    // static evaluation comes near it (all the material of a side is worth a
+    // few million), and a known win plus any evaluation stays well below
+    // mate, so mates, known wins and evaluations never mix up in the TT.
+    static const int KNOWN_WIN_VALUE = util::constants::INFINITUM / 8;
 };
 
+// The only instantiation, in AlphaBetaSearch.cpp. GET_BEST_MOVE fails on any
+// board that is not a MaeBoard.
+using AlphaBetaSearch =
+    BasicAlphaBetaSearch<rules::MaeBoard, PositionEvaluator, MoveGenerator>;
+
 } // namespace engine
 
 #endif // ALPHA_BETA_SEARCH_H
@@ -0,0 +1,205 @@
+#include "BatchAnalyzer.hpp"
+#include "AlphaBetaSearch.hpp"
+#include "EpdReader.hpp"
+#include "FenReader.hpp"
+#include "MaeBoard.hpp"
+#include "MoveGenerator.hpp"
+#include "PositionEvaluator.hpp"
+#include "SanNotation.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace engine
+{
+using rules::MaeBoard;
+using rules::Move;
+using serialization::EpdReader;
+using serialization::EpdRecord;
+using serialization::FenReader;
+using serialization::SanNotation;
+using std::string;
+
+namespace
+{
+// Score of a mate on the board, in EPD
+const int EPD_MATE_SCORE = 32767;
+
+} // anonymous namespace
+
+struct BatchAnalyzer::Worker
+{
+    Worker() : search(&evaluator, &generator)
+    {
+        search.set_verbose(false);
+    }
+
+    MaeBoard board;
+    PositionEvaluator evaluator;
+    MoveGenerator generator;
+    AlphaBetaSearch search;
+};
+
+BatchAnalyzer::BatchAnalyzer(uint threads_count, int max_depth, ullong node_limit)
+{
+    this->max_depth = max_depth;
+
+    for (uint i = 0; i < std::max(threads_count, 1u); ++i)
+    {
+        this->workers.emplace_back(new Worker());
+        this->workers.back()->search.set_node_limit(node_limit);
+    }
+}
+
+BatchAnalyzer::~BatchAnalyzer()
+{
+}
+
+void BatchAnalyzer::set_telemetry_sink(diagnostics::TelemetrySink *sink)
+{
+    for (auto &worker : this->workers)
+        worker->search.set_telemetry_sink(sink);
+}
+
+/*==============================================================================
+  Analyze every position in POSITIONS and write one result per position to
+  RESULTS, in input order. Return the number of positions analyzed.
+  ==============================================================================*/
+ullong BatchAnalyzer::analyze(std::istream &positions, std::ostream &results)
+{
+    EpdReader reader(positions);
+    ullong positions_read = 0;
+    uint running_workers = this->workers.size();
+
+    // Results that cannot be written yet because an earlier one is pending
+    std::map<ullong, string> finished;
+    std::mutex mutex;
+    std::condition_variable result_ready;
+
+    auto work = [&](Worker &worker) {
+        while (true)
+        {
+            EpdRecord record;
+            ullong index;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!reader.next(record))
+                    break;
+                index = positions_read++;
+            }
+
+            string result = analyze_position(worker, record);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                finished[index] = result;
+            }
+            result_ready.notify_one();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        running_workers--;
+        result_ready.notify_one();
+    };
+
+    std::vector<std::thread> threads;
+    for (auto &worker : this->workers)
+        threads.emplace_back(work, std::ref(*worker));
+
+    ullong next_result = 0;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (running_workers > 0 || !finished.empty())
+        {
+            result_ready.wait(lock, [&] {
+                return running_workers == 0 || finished.count(next_result) > 0;
+            });
+
+            for (auto iter = finished.find(next_result); iter != finished.end();
+                 iter = finished.find(++next_result))
+            {
+                results << iter->second << std::endl;
+                finished.erase(iter);
+            }
+        }
+    }
+
+    for (auto &thread : threads)
+        thread.join();
+
+    return next_result;
+}
+
+string BatchAnalyzer::analyze_position(Worker &worker, const EpdRecord &record)
+{
+    std::ostringstream result;
+
+    if (record.position.empty() ||
+        !FenReader(record.position, &worker.board).load_position())
+    {
+        result << record.position << " c0 \"invalid position\";";
+        return result.str();
+    }
+
+    // Clearing the cache makes every result independent of which thread
+    // analyzed which positions before
+    worker.search.clear_transposition_table();
+
+    auto start = std::chrono::steady_clock::now();
+    Move best_move;
+    worker.search.get_best_move(this->max_depth, &worker.board, best_move);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    result << record.position;
+    if (!best_move.is_null())
+        result << " bm " << SanNotation::to_san(&worker.board, best_move) << ";";
+
+    // Plies to mate are only known as far as the principal variation shows
+    const std::vector<Move> &principal_variation =
+        worker.search.get_principal_variation();
+    int score = worker.search.get_score();
+    int centipawns = worker.evaluator.to_centipawns(score);
+    if (abs(score) == abs(IEngine::MATE_VALUE))
+    {
+        centipawns = EPD_MATE_SCORE - principal_variation.size();
+        if (score == IEngine::MATE_VALUE)
+            centipawns = -centipawns;
+    }
+
+    result << " ce " << centipawns << ";"
+           << " acd " << worker.search.get_completed_depth() << ";"
+           << " acn " << worker.search.get_nodes_searched() << ";"
+           << " acs " << std::fixed << std::setprecision(3) << elapsed.count() << ";";
+
+    if (!principal_variation.empty() && !principal_variation[0].is_null())
+    {
+        // Each move is written in SAN on the position the ones before it lead
+        // to, so they are played on the board and then taken back
+        result << " pv";
+        uint moves_made = 0;
+        for (Move move : principal_variation)
+        {
+            string san = SanNotation::to_san(&worker.board, move);
+            if (san.empty())
+                break;
+            result << " " << san;
+            worker.board.make_move(move, true);
+            ++moves_made;
+        }
+        for (; moves_made > 0; --moves_made)
+            worker.board.undo_move();
+        result << ";";
+    }
+
+    if (record.has_operation("id"))
+        result << " id \"" << record.get_operation("id") << "\";";
+
+    return result.str();
+}
+
+} // namespace engine
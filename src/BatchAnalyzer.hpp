@@ -0,0 +1,61 @@
+#ifndef BATCH_ANALYZER_H
+#define BATCH_ANALYZER_H
+
+/*==============================================================================
+  Analyzes a set of independent positions (read as EPD records) using several
+  threads at once. Every thread owns a complete engine (board, move generator,
+  evaluator and search), so threads never share mutable state and throughput
+  scales with the number of cores.
+
+  Results are written as EPD records in the same order as the input, as soon
+  as all the positions before them have been analyzed:
+
+  <position> bm <move>; ce <score>; acd <depth>; acn <nodes>; acs <seconds>; pv <moves>;
+
+  Moves are in Standard Algebraic Notation, so the results can be read back
+  as a test suite. Scores are in centipawns, from the point of view of the
+  side to move; a side that mates in N plies scores 32767 - N (and the mated
+  side the opposite), as is the convention in EPD.
+  ==============================================================================*/
+
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "type_aliases.hpp"
+
+namespace serialization
+{
+struct EpdRecord;
+}
+
+namespace diagnostics
+{
+class TelemetrySink;
+}
+
+namespace engine
+{
+class BatchAnalyzer
+{
+  public:
+    BatchAnalyzer(uint threads_count, int max_depth, ullong node_limit);
+    ~BatchAnalyzer();
+
+    ullong analyze(std::istream &positions, std::ostream &results);
+    void set_telemetry_sink(diagnostics::TelemetrySink *sink);
+
+  private:
+    struct Worker;
+
+    std::string analyze_position(Worker &, const serialization::EpdRecord &);
+
+    int max_depth;
+    std::vector<std::unique_ptr<Worker>> workers;
+};
+
+} // namespace engine
+
+#endif // BATCH_ANALYZER_H
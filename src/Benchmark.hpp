@@ -0,0 +1,53 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+/*==============================================================================
+  Searches a fixed set of positions to a fixed depth, one after the other and
+  from an empty transposition table, and reports the nodes searched and the
+  time it took.
+
+  The total number of nodes only depends on how the engine searches, not on
+  how fast the machine is, so it serves as a signature of the search: a change
+  that should not alter the search (e.g. a speed optimization) must leave it
+  unchanged, while nodes per second can be compared across builds and hosts.
+  ==============================================================================*/
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "type_aliases.hpp"
+
+namespace diagnostics
+{
+class TelemetrySink;
+}
+
+namespace engine
+{
+struct BenchmarkResult
+{
+    ullong positions;
+    ullong nodes;
+    double seconds;
+};
+
+class Benchmark
+{
+  public:
+    Benchmark(int depth);
+
+    BenchmarkResult run(std::ostream &report);
+    void set_telemetry_sink(diagnostics::TelemetrySink *sink);
+
+    static const int DEFAULT_DEPTH = 4;
+    static const std::vector<std::string> positions;
+
+  private:
+    int depth;
+    diagnostics::TelemetrySink *telemetry_sink;
+};
+
+} // namespace engine
+
+#endif // BENCHMARK_H
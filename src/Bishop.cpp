@@ -6,15 +6,6 @@
 
 namespace rules
 {
-Bishop::Bishop()
-{
-    compute_moves();
-}
-
-Bishop::~Bishop()
-{
-}
-
 /*==============================================================================
   Get all moves from SQUARE in the current BOARD assumming it is PLAYER'S turn
   to move (moves that may leave the king in check are also included)
@@ -54,25 +45,17 @@ bitboard Bishop::get_moves(uint square, Piece::Player player, const IBoard *boar
   Compute all moves a bishop can make from every square on the board assuming
   the board is empty.
   ==============================================================================*/
-void Bishop::compute_moves()
+constexpr Bishop::MoveTable Bishop::compute_moves()
 {
+    MoveTable table = {};
     int dx[Piece::RAY_DIRECTIONS_COUNT] = {+1, +1, -1, -1};
     int dy[Piece::RAY_DIRECTIONS_COUNT] = {-1, +1, +1, -1};
     bitboard one = 1;
 
-    for (auto square = BoardSquare::a8; square <= BoardSquare::h1; ++square)
-    {
-        for (uint ray = 0; ray < Piece::RAY_DIRECTIONS_COUNT; ++ray)
-            this->moves_from[square][ray] = 0;
-
-        this->all_moves_from[square] = 0;
-    }
-
     for (uint row = 0; row < BOARD_SIZE; ++row)
         for (uint col = 0; col < BOARD_SIZE; ++col)
         {
             auto square = BoardSquare(row * BOARD_SIZE + col);
-            Diagonal ray;
 
             /*--------------------------------------------------------------------
               Traverse all four directions a bishop can move to
@@ -84,7 +67,7 @@ void Bishop::compute_moves()
                  /   \     SW : South West
                 SW   SE
             ---------------------------------------------------------------------*/
-            for (ray = Piece::NORTH_EAST; ray <= Piece::NORTH_WEST; ++ray)
+            for (Diagonal ray = Piece::NORTH_EAST; ray <= Piece::NORTH_WEST; ++ray)
             {
                 int y = row;
                 int x = col;
@@ -92,13 +75,16 @@ void Bishop::compute_moves()
                 {
                     y += dy[ray];
                     x += dx[ray];
-                    this->moves_from[square][ray] |= (one << (y * BOARD_SIZE + x));
+                    table.moves_from[square][ray] |= (one << (y * BOARD_SIZE + x));
                 }
-                this->all_moves_from[square] |= this->moves_from[square][ray];
+                table.all_moves_from[square] |= table.moves_from[square][ray];
             }
         }
+    return table;
 }
 
+constexpr Bishop::MoveTable Bishop::move_table = Bishop::compute_moves();
+
 /*==============================================================================
   Return all possible moves from SQUARE, assuming the board is empty.
   ==============================================================================*/
@@ -107,7 +93,7 @@ bitboard
 Bishop::get_potential_moves(uint square, Player /* player */) const
 {
     if (IBoard::is_inside_board(square))
-        return this->all_moves_from[square];
+        return Bishop::move_table.all_moves_from[square];
 
     return 0;
 }
@@ -119,7 +105,7 @@ Bishop::get_potential_moves(uint square, Player /* player */) const
 bitboard Bishop::get_diagonal_ray_from(BoardSquare square, Diagonal direction) const
 {
     if (IBoard::is_inside_board(square))
-        return this->moves_from[square][direction];
+        return Bishop::move_table.moves_from[square][direction];
 
     return 0;
 }
@@ -0,0 +1,663 @@
+#include "Bitbases.hpp"
+#include "MaeBoard.hpp"
+#include "Move.hpp"
+#include "MoveGenerator.hpp"
+#include "bitboard.hpp"
+#include "util.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+namespace engine
+{
+using bits::bitboard;
+using rules::BoardSquare;
+using rules::IBoard;
+using rules::MaeBoard;
+using rules::Move;
+using rules::Piece;
+using std::string;
+using std::vector;
+
+namespace
+{
+const char FILE_MAGIC[] = "PAWNBB01";
+const uint MAGIC_SIZE = 8;
+const uint RESULTS_PER_WORD = 32;
+
+// Positions are handed out to threads in blocks of this many
+const ullong BLOCK_SIZE = 4096;
+
+// Generation also needs to tell the positions still unresolved, and those
+// resolved whose predecessors have not been looked at yet
+const unsigned char UNKNOWN = Bitbases::INVALID + 1;
+const unsigned char FRESH = 8;
+
+const char PIECE_LETTERS[] = "PNBRQK";
+
+// Order in which pieces appear in the name of an ending
+const Piece::Type NAME_ORDER[] = {Piece::QUEEN, Piece::ROOK, Piece::BISHOP,
+                                  Piece::KNIGHT, Piece::PAWN};
+
+} // anonymous namespace
+
+const char *const Bitbases::FILE_EXTENSION = ".bb";
+
+struct Bitbases::Worker
+{
+    MaeBoard board;
+    MoveGenerator generator;
+    vector<Move> moves;
+};
+
+Bitbases::Bitbases()
+{
+    this->max_pieces = 0;
+}
+
+Bitbases::~Bitbases()
+{
+}
+
+Bitbases::Result Bitbases::Table::get(ullong index) const
+{
+    ullong word = this->results[index / RESULTS_PER_WORD];
+    return Result((word >> 2 * (index % RESULTS_PER_WORD)) & 3);
+}
+
+/*==============================================================================
+  Generate the bitbase of ENDING (e.g. KRK) and those of the smaller endings it
+  can turn into, unless they are already loaded, using THREADS_COUNT threads
+  and writing the progress to REPORT. Return FALSE if ENDING is not a valid
+  name.
+  ==============================================================================*/
+bool Bitbases::generate(const string &ending, uint threads_count, std::ostream &report)
+{
+    std::unique_ptr<Table> table(new Table());
+    if (!parse_ending(ending, *table))
+        return false;
+
+    bool is_flipped;
+    if (find_table(table->material, is_flipped) != nullptr)
+        return true;
+
+    if (!generate_dependencies(*table, threads_count, report))
+        return false;
+
+    solve(*table, threads_count, report);
+
+    this->max_pieces = std::max<uint>(this->max_pieces, table->pieces.size());
+    this->tables.push_back(std::move(table));
+    return true;
+}
+
+/*==============================================================================
+  Write every bitbase to a file in DIRECTORY named after its ending. Return
+  FALSE if any of them cannot be written.
+  ==============================================================================*/
+bool Bitbases::save(const string &directory) const
+{
+    for (auto &table : this->tables)
+    {
+        std::ofstream file(
+            directory + "/" + table->name + FILE_EXTENSION, std::ios::binary);
+        file.write(FILE_MAGIC, MAGIC_SIZE);
+        for (ullong word : table->results)
+            util::write_binary(file, word);
+
+        if (!file.good())
+            return false;
+    }
+    return true;
+}
+
+/*==============================================================================
+  Load the bitbase in FILE, whose name (without the directory and extension)
+  is that of the ending. Return FALSE if it is not a complete bitbase.
+  ==============================================================================*/
+bool Bitbases::load(const string &file)
+{
+    string name = file.substr(file.find_last_of('/') + 1);
+    name = name.substr(0, name.find('.'));
+
+    std::unique_ptr<Table> table(new Table());
+    bool is_flipped;
+    if (!parse_ending(name, *table) || find_table(table->material, is_flipped))
+        return false;
+
+    std::ifstream input(file, std::ios::binary);
+    char magic[MAGIC_SIZE];
+    if (!input.read(magic, MAGIC_SIZE) || memcmp(magic, FILE_MAGIC, MAGIC_SIZE) != 0)
+        return false;
+
+    for (ullong &word : table->results)
+        if (!util::read_binary(input, word))
+            return false;
+
+    this->max_pieces = std::max<uint>(this->max_pieces, table->pieces.size());
+    this->tables.push_back(std::move(table));
+    return true;
+}
+
+/*==============================================================================
+  Load every bitbase file in DIRECTORY. Return the number of bitbases loaded.
+  ==============================================================================*/
+uint Bitbases::load_directory(const string &directory)
+{
+    DIR *entries = opendir(directory.c_str());
+    if (entries == nullptr)
+        return 0;
+
+    vector<string> files;
+    const size_t extension_size = strlen(FILE_EXTENSION);
+    while (struct dirent *entry = readdir(entries))
+    {
+        string name = entry->d_name;
+        size_t extension_start = name.size() - extension_size;
+        if (name.size() > extension_size &&
+            name.compare(extension_start, extension_size, FILE_EXTENSION) == 0)
+            files.push_back(directory + "/" + name);
+    }
+    closedir(entries);
+
+    uint loaded = 0;
+    for (const string &file : files)
+        loaded += load(file);
+    return loaded;
+}
+
+/*==============================================================================
+  Look up the position on BOARD in the bitbases. Return FALSE if there is no
+  bitbase for its material; otherwise RESULT tells what the side to move can
+  achieve. This costs a population count when the board has more pieces than
+  any bitbase, and a handful of table comparisons otherwise.
+  ==============================================================================*/
+bool Bitbases::probe(const MaeBoard &board, Result &result) const
+{
+    if (bits::count_ones(board.get_all_pieces()) > this->max_pieces)
+        return false;
+
+    Material material;
+    count_material(board, material);
+
+    bool is_flipped;
+    const Table *table = find_table(material, is_flipped);
+    if (table == nullptr)
+        return false;
+
+    result = table->get(compute_index(*table, board, is_flipped));
+    return result != INVALID;
+}
+
+vector<string> Bitbases::get_endings() const
+{
+    vector<string> endings;
+    for (auto &table : this->tables)
+        endings.push_back(table->name);
+    return endings;
+}
+
+/*==============================================================================
+  Fill TABLE with the pieces of ENDING, a name such as KRKP with the white
+  pieces first, and size its results. Return FALSE if ENDING is not made of
+  two kings and at most MAX_PIECES pieces in all.
+  ==============================================================================*/
+bool Bitbases::parse_ending(const string &ending, Table &table)
+{
+    if (ending.size() > MAX_PIECES || ending.empty() || ending[0] != 'K')
+        return false;
+
+    table.name = ending;
+    memset(table.material, 0, sizeof(table.material));
+    table.pieces.clear();
+    table.colors.clear();
+
+    Piece::Player player = Piece::WHITE;
+    for (uint i = 0; i < ending.size(); ++i)
+    {
+        const char *letter = strchr(PIECE_LETTERS, ending[i]);
+        if (letter == nullptr || *letter == '\0')
+            return false;
+
+        Piece::Type type = Piece::Type(letter - PIECE_LETTERS);
+        if (type == Piece::KING && i > 0)
+        {
+            if (player == Piece::BLACK)
+                return false;
+            player = Piece::BLACK;
+        }
+
+        table.material[player][type]++;
+        table.pieces.push_back(type);
+        table.colors.push_back(player);
+    }
+
+    if (player != Piece::BLACK || table.pieces.size() < 3)
+        return false;
+
+    table.positions_count = 2;
+    for (uint i = 0; i < table.pieces.size(); ++i)
+        table.positions_count *= rules::BOARD_SQUARES_COUNT;
+
+    table.results.assign(
+        (table.positions_count + RESULTS_PER_WORD - 1) / RESULTS_PER_WORD, 0);
+    return true;
+}
+
+void Bitbases::count_material(const MaeBoard &board, Material &material)
+{
+    for (Piece::Player player = Piece::WHITE; player <= Piece::BLACK; ++player)
+        for (Piece::Type type = Piece::PAWN; type <= Piece::KING; ++type)
+            material[player][type] = bits::count_ones(board.get_pieces(player, type));
+}
+
+/*==============================================================================
+  Return the index in TABLE of the position on BOARD, which must have the
+  material of TABLE, or that of TABLE with the colors swapped if IS_FLIPPED.
+  Pieces of the same kind are taken in square order; any order would do,
+  since generation fills in every permutation.
+  ==============================================================================*/
+ullong Bitbases::compute_index(const Table &table, const MaeBoard &board, bool is_flipped)
+{
+    const uint FLIP_ROWS = 56;
+
+    Piece::Player player = board.current_player();
+    ullong index = is_flipped ? Piece::Player(1 - player) : player;
+
+    bitboard taken = 0;
+    for (uint i = 0; i < table.pieces.size(); ++i)
+    {
+        Piece::Player color = table.colors[i];
+        if (is_flipped)
+            color = Piece::Player(1 - color);
+
+        bitboard pieces = board.get_pieces(color, table.pieces[i]) & ~taken;
+        int square = bits::lsb_position(pieces);
+        taken |= bits::to_bitboard[square];
+
+        index *= rules::BOARD_SQUARES_COUNT;
+        index += is_flipped ? square ^ FLIP_ROWS : square;
+    }
+    return index;
+}
+
+/*==============================================================================
+  Return the table for MATERIAL, setting IS_FLIPPED if the table has it with
+  the colors swapped, or null if there is none
+  ==============================================================================*/
+const Bitbases::Table *Bitbases::find_table(
+    const Material &material, bool &is_flipped) const
+{
+    const size_t side_size = sizeof(material[0]);
+
+    for (auto &table : this->tables)
+    {
+        if (memcmp(table->material, material, sizeof(Material)) == 0)
+        {
+            is_flipped = false;
+            return table.get();
+        }
+        const Material &own = table->material;
+        if (memcmp(own[Piece::WHITE], material[Piece::BLACK], side_size) == 0 &&
+            memcmp(own[Piece::BLACK], material[Piece::WHITE], side_size) == 0)
+        {
+            is_flipped = true;
+            return table.get();
+        }
+    }
+    return nullptr;
+}
+
+/*==============================================================================
+  Generate the bitbases of the endings TABLE turns into after a capture or a
+  promotion (to a queen, as MaeBoard always promotes), except the one with
+  bare kings, which is a draw
+  ==============================================================================*/
+bool Bitbases::generate_dependencies(
+    const Table &table, uint threads_count, std::ostream &report)
+{
+    auto name = [](const Material &material) {
+        string sides[rules::PLAYERS_COUNT];
+        for (Piece::Player player = Piece::WHITE; player <= Piece::BLACK; ++player)
+        {
+            sides[player] = "K";
+            for (Piece::Type type : NAME_ORDER)
+                sides[player].append(material[player][type], PIECE_LETTERS[type]);
+        }
+
+        // The side with more pieces, or stronger ones, goes first
+        const string strength = "KPNBRQ";
+        auto is_stronger = [&](const string &a, const string &b) {
+            if (a.size() != b.size())
+                return a.size() > b.size();
+            for (uint i = 0; i < a.size(); ++i)
+                if (a[i] != b[i])
+                    return strength.find(a[i]) > strength.find(b[i]);
+            return false;
+        };
+        return is_stronger(sides[Piece::BLACK], sides[Piece::WHITE])
+                   ? sides[Piece::BLACK] + sides[Piece::WHITE]
+                   : sides[Piece::WHITE] + sides[Piece::BLACK];
+    };
+
+    for (Piece::Player player = Piece::WHITE; player <= Piece::BLACK; ++player)
+        for (Piece::Type type = Piece::PAWN; type <= Piece::QUEEN; ++type)
+        {
+            if (table.material[player][type] == 0)
+                continue;
+
+            Material smaller;
+            memcpy(smaller, table.material, sizeof(Material));
+            smaller[player][type]--;
+            bool is_bare_kings = table.pieces.size() == 3;
+            if (!is_bare_kings && !generate(name(smaller), threads_count, report))
+                return false;
+
+            if (type == Piece::PAWN)
+            {
+                smaller[player][Piece::QUEEN]++;
+                if (!generate(name(smaller), threads_count, report))
+                    return false;
+            }
+        }
+    return true;
+}
+
+/*==============================================================================
+  Compute the results of every position of TABLE by retrograde analysis (see
+  the header), with THREADS_COUNT threads
+  ==============================================================================*/
+void Bitbases::solve(Table &table, uint threads_count, std::ostream &report)
+{
+    auto start = std::chrono::steady_clock::now();
+    const uint pieces_count = table.pieces.size();
+
+    // Besides its state, every unknown position counts its moves that have
+    // not been found to lose yet (to a won position)
+    std::unique_ptr<std::atomic<unsigned char>[]> states(
+        new std::atomic<unsigned char>[table.positions_count]);
+    std::unique_ptr<std::atomic<unsigned char>[]> moves_left(
+        new std::atomic<unsigned char>[table.positions_count]);
+    for (ullong i = 0; i < table.positions_count; ++i)
+    {
+        states[i].store(INVALID, std::memory_order_relaxed);
+        moves_left[i].store(0, std::memory_order_relaxed);
+    }
+
+    // Pieces of the same kind, next to each other in the table, are only
+    // looked at in square order; the other permutations are copied at the end
+    bool is_same_kind[MAX_PIECES] = {};
+    for (uint i = 1; i < pieces_count; ++i)
+        is_same_kind[i] = table.pieces[i] == table.pieces[i - 1] &&
+                          table.colors[i] == table.colors[i - 1];
+
+    // Set SQUARES to those of the pieces of position INDEX; return the side to
+    // move
+    auto decode = [&](ullong index, uint *squares) {
+        for (uint i = pieces_count; i-- > 0;)
+        {
+            squares[i] = index % rules::BOARD_SQUARES_COUNT;
+            index /= rules::BOARD_SQUARES_COUNT;
+        }
+        return Piece::Player(index);
+    };
+
+    // Return the index of the position with PLAYER to move and the pieces on
+    // SQUARES, taking pieces of the same kind in square order
+    auto encode = [&](const uint *squares, Piece::Player player) {
+        uint sorted[MAX_PIECES];
+        std::copy(squares, squares + pieces_count, sorted);
+        for (uint i = 1; i < pieces_count; ++i)
+            for (uint j = i; j > 0 && is_same_kind[j] && sorted[j - 1] > sorted[j]; --j)
+                std::swap(sorted[j - 1], sorted[j]);
+
+        ullong index = player;
+        for (uint i = 0; i < pieces_count; ++i)
+            index = index * rules::BOARD_SQUARES_COUNT + sorted[i];
+        return index;
+    };
+
+    auto place_pieces = [&](MaeBoard &board, const uint *squares, Piece::Player player) {
+        board.clear();
+        for (uint i = 0; i < pieces_count; ++i)
+            board.add_piece(BoardSquare(squares[i]), table.pieces[i], table.colors[i]);
+
+        for (Piece::Player side = Piece::WHITE; side <= Piece::BLACK; ++side)
+        {
+            board.set_castling_privilege(side, rules::KING_SIDE, false);
+            board.set_castling_privilege(side, rules::QUEEN_SIDE, false);
+        }
+        board.set_player_in_turn(player);
+    };
+
+    // Set up position INDEX on the board of WORKER; return FALSE if illegal
+    auto set_up_position = [&](Worker &worker, ullong index) {
+        uint squares[MAX_PIECES];
+        Piece::Player player = decode(index, squares);
+
+        bitboard occupied = 0;
+        uint kings[rules::PLAYERS_COUNT] = {};
+        for (uint i = 0; i < pieces_count; ++i)
+        {
+            uint row = squares[i] / rules::BOARD_SIZE;
+            if ((occupied & bits::to_bitboard[squares[i]]) ||
+                (table.pieces[i] == Piece::PAWN && (row == 0 || row == 7)))
+                return false;
+
+            occupied |= bits::to_bitboard[squares[i]];
+            if (table.pieces[i] == Piece::KING)
+                kings[table.colors[i]] = squares[i];
+        }
+
+        int row_distance = abs(int(kings[0] / 8) - int(kings[1] / 8));
+        int column_distance = abs(int(kings[0] % 8) - int(kings[1] % 8));
+        if (row_distance <= 1 && column_distance <= 1)
+            return false;
+
+        // The side that just moved cannot have left its king in check
+        MaeBoard &board = worker.board;
+        place_pieces(board, squares, Piece::Player(1 - player));
+        if (board.is_king_in_check())
+            return false;
+
+        board.set_player_in_turn(player);
+        return true;
+    };
+
+    // Play the moves of position INDEX once, resolving it if its moves out of
+    // the ending (or the lack of moves) decide it, and counting those that
+    // stay in it otherwise
+    auto initialize = [&](Worker &worker, ullong index) -> unsigned char {
+        MaeBoard &board = worker.board;
+        worker.moves.clear();
+        worker.generator.generate_moves(&board, worker.moves);
+
+        bool has_moves = false;
+        uint count = 0;
+        for (Move &move : worker.moves)
+        {
+            if (board.make_move(move, true) == IBoard::KING_LEFT_IN_CHECK)
+                continue;
+
+            has_moves = true;
+            Material material;
+            count_material(board, material);
+
+            Result result = DRAW;
+            bool is_inside = memcmp(material, table.material, sizeof(Material)) == 0;
+            if (!is_inside && !probe(board, result))
+                result = DRAW;
+            board.undo_move();
+
+            if (!is_inside && result == LOSS)
+                return WIN;
+
+            // A move to a draw is never lost, so it is never taken off
+            if (is_inside || result == DRAW)
+                count++;
+        }
+
+        if (!has_moves)
+            return board.is_king_in_check() ? LOSS : DRAW;
+        if (count == 0)
+            return LOSS;
+
+        moves_left[index].store(count, std::memory_order_relaxed);
+        return UNKNOWN;
+    };
+
+    // Go through the moves that lead to CHILD, just resolved, by taking them
+    // back. Return the number of positions they resolve.
+    auto propagate = [&](Worker &worker, ullong child, unsigned char state) {
+        uint squares[MAX_PIECES];
+        Piece::Player mover = Piece::Player(1 - decode(child, squares));
+        MaeBoard &board = worker.board;
+        place_pieces(board, squares, mover);
+        bitboard empty = ~board.get_all_pieces();
+
+        ullong resolved = 0;
+        for (uint i = 0; i < pieces_count; ++i)
+        {
+            if (table.colors[i] != mover)
+                continue;
+
+            // Pieces other than pawns move back the way they move forward
+            uint square = squares[i];
+            bitboard origins = 0;
+            if (table.pieces[i] != Piece::PAWN)
+                origins = board.get_moves(table.pieces[i], BoardSquare(square)) & empty;
+            else
+            {
+                // A pawn steps back one square, or two from its fourth row,
+                // but never onto its first row
+                int step = rules::BOARD_SIZE;
+                if (mover == Piece::BLACK)
+                    step = -step;
+                uint row = square / rules::BOARD_SIZE;
+                uint back = square + step;
+                uint first_row = mover == Piece::WHITE ? 7 : 0;
+                uint fourth_row = mover == Piece::WHITE ? 4 : 3;
+
+                bitboard one_back = bits::to_bitboard[back] & empty;
+                if (back / rules::BOARD_SIZE != first_row && one_back)
+                {
+                    origins = one_back;
+                    if (row == fourth_row)
+                        origins |= bits::to_bitboard[back + step] & empty;
+                }
+            }
+
+            while (origins)
+            {
+                int origin = bits::lsb_position(origins);
+                origins &= origins - 1;
+
+                squares[i] = origin;
+                ullong parent = encode(squares, mover);
+                squares[i] = square;
+
+                // Illegal parents were marked invalid up front
+                if (states[parent].load(std::memory_order_relaxed) != UNKNOWN)
+                    continue;
+
+                unsigned char expected = UNKNOWN;
+                if (state == LOSS)
+                    resolved += states[parent].compare_exchange_strong(
+                        expected, WIN | FRESH, std::memory_order_relaxed);
+                else if (moves_left[parent].fetch_sub(1, std::memory_order_relaxed) == 1)
+                    resolved += states[parent].compare_exchange_strong(
+                        expected, LOSS | FRESH, std::memory_order_relaxed);
+            }
+        }
+        return resolved;
+    };
+
+    vector<std::unique_ptr<Worker>> workers;
+    for (uint i = 0; i < std::max(threads_count, 1u); ++i)
+        workers.emplace_back(new Worker());
+
+    // Run VISIT on every position, in blocks split among the threads; return
+    // the sum of what it returns
+    auto run_pass = [&](std::function<ullong(Worker &, ullong)> visit) {
+        std::atomic<ullong> next_block(0), total(0);
+        auto work = [&](Worker &worker) {
+            ullong begin;
+            while ((begin = next_block.fetch_add(BLOCK_SIZE)) < table.positions_count)
+            {
+                ullong end = std::min(begin + BLOCK_SIZE, table.positions_count);
+                ullong sum = 0;
+                for (ullong i = begin; i < end; ++i)
+                    sum += visit(worker, i);
+                total += sum;
+            }
+        };
+
+        vector<std::thread> threads;
+        for (auto &worker : workers)
+            threads.emplace_back(work, std::ref(*worker));
+        for (auto &thread : threads)
+            thread.join();
+        return total.load();
+    };
+
+    // The first pass plays the moves of every position
+    run_pass([&](Worker &worker, ullong index) -> ullong {
+        uint squares[MAX_PIECES];
+        Piece::Player player = decode(index, squares);
+        if (encode(squares, player) != index || !set_up_position(worker, index))
+            return 0;
+
+        unsigned char state = initialize(worker, index);
+        if (state == WIN || state == LOSS)
+            state |= FRESH;
+        states[index].store(state, std::memory_order_relaxed);
+        return 0;
+    });
+
+    // Later passes only take back the moves into positions resolved by the
+    // previous one (or by this one, which only speeds things up)
+    ullong resolved = 0;
+    uint pass = 1;
+    do
+    {
+        resolved = run_pass([&](Worker &worker, ullong index) -> ullong {
+            unsigned char state = states[index].load(std::memory_order_relaxed);
+            if (!(state & FRESH))
+                return 0;
+
+            state &= ~FRESH;
+            states[index].store(state, std::memory_order_relaxed);
+            return propagate(worker, index, state);
+        });
+        pass++;
+    } while (resolved > 0);
+
+    ullong counts[INVALID + 1] = {};
+    for (ullong i = 0; i < table.positions_count; ++i)
+    {
+        uint squares[MAX_PIECES];
+        Piece::Player player = decode(i, squares);
+        ullong canonical = encode(squares, player);
+        unsigned char state = states[canonical].load(std::memory_order_relaxed);
+        if (state == UNKNOWN)
+            state = DRAW;
+
+        counts[state]++;
+        table.results[i / RESULTS_PER_WORD] |= ullong(state)
+                                               << 2 * (i % RESULTS_PER_WORD);
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    report << table.name << ": " << counts[WIN] << " won, " << counts[DRAW] << " drawn, "
+           << counts[LOSS] << " lost (" << pass << " passes, " << elapsed.count()
+           << "s)" << std::endl;
+}
+
+} // namespace engine
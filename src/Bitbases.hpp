@@ -0,0 +1,105 @@
+#ifndef BITBASES_H
+#define BITBASES_H
+
+/*==============================================================================
+  Endgame bitbases: for every position of an ending with a few pieces (KPK,
+  KRK, KRKP...), whether the side to move wins, draws or loses with perfect
+  play, in two bits per position.
+
+  A position is indexed by the side to move and the square of every piece, in
+  the order of the name of the ending: white king, white pieces, black king,
+  black pieces. Positions with the colors swapped (KKP for KPK) are looked up
+  mirrored vertically. Indices that are not legal positions (two pieces on a
+  square, pawns on the first or last row, the side not to move in check) are
+  wasted, which keeps the index trivial to compute.
+
+  Bitbases are generated by retrograde analysis. A first pass plays the moves
+  of every position with MaeBoard and MoveGenerator: mates are lost, and
+  stalemates drawn; moves that leave the ending (a capture or a promotion) are
+  looked up in the bitbases of smaller endings, which are generated first; the
+  other moves are counted. Then every pass takes back the moves into the
+  positions resolved by the one before, marking as won the positions with a
+  move to a lost one, and as lost those whose last move not yet known to lose
+  leads to a won one, until a pass resolves nothing. Whatever is left is a
+  draw. Only one order of identical pieces is solved, and copied to the
+  others. Passes split the positions among threads. En passant captures are
+  ignored, since the index does not record them.
+  ==============================================================================*/
+
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "GameTraits.hpp"
+#include "Piece.hpp"
+#include "type_aliases.hpp"
+
+namespace rules
+{
+class MaeBoard;
+}
+
+namespace engine
+{
+class Bitbases
+{
+  public:
+    // From the point of view of the side to move
+    enum Result
+    {
+        DRAW,
+        WIN,
+        LOSS,
+        INVALID
+    };
+
+    Bitbases();
+    ~Bitbases();
+
+    bool generate(const std::string &ending, uint threads_count, std::ostream &report);
+    bool save(const std::string &directory) const;
+    bool load(const std::string &file);
+    uint load_directory(const std::string &directory);
+
+    bool probe(const rules::MaeBoard &, Result &result) const;
+    std::vector<std::string> get_endings() const;
+
+    static const uint MAX_PIECES = 4;
+    static const char *const FILE_EXTENSION;
+
+  private:
+    typedef uint Material[rules::PLAYERS_COUNT][rules::PIECE_KINDS_COUNT];
+
+    struct Table
+    {
+        std::string name;
+        Material material;
+        std::vector<rules::Piece::Type> pieces;
+        std::vector<rules::Piece::Player> colors;
+        ullong positions_count;
+
+        // Two bits per position
+        std::vector<ullong> results;
+
+        Result get(ullong index) const;
+    };
+
+    struct Worker;
+
+    static bool parse_ending(const std::string &ending, Table &table);
+    static void count_material(const rules::MaeBoard &, Material &material);
+    static ullong compute_index(const Table &, const rules::MaeBoard &, bool is_flipped);
+
+    const Table *find_table(const Material &material, bool &is_flipped) const;
+    bool generate_dependencies(
+        const Table &, uint threads_count, std::ostream &report);
+    void solve(Table &, uint threads_count, std::ostream &report);
+
+    std::vector<std::unique_ptr<Table>> tables;
+    uint max_pieces;
+};
+
+} // namespace engine
+
+#endif // BITBASES_H
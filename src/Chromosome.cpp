@@ -1,9 +1,7 @@
 #include <cmath>
 #include <cstdlib>
-#include <ctime>
 
 #include "Chromosome.hpp"
-#include "IBoard.hpp"
 #include "util.hpp"
 
 namespace learning
@@ -13,48 +11,26 @@ using std::vector;
 
 Chromosome::Chromosome()
 {
-    initialize_data();
+    initialize_data(0);
 }
 
 // Create a random chromosome
-Chromosome::Chromosome(uint features_count)
+Chromosome::Chromosome(uint features_count, util::Random &random)
 {
-    initialize_data();
+    initialize_data(features_count * BITS_PER_FEATURE);
 
-    for (uint i = 0; i < features_count * BITS_PER_FEATURE; ++i)
-    {
-        this->gene_string.push_back((rand() & 1) ? true : false);
-    }
-}
-
-Chromosome::Chromosome(const Chromosome &copy)
-{
-    this->selection_probability = copy.selection_probability;
-    this->cumulative_probability = copy.cumulative_probability;
-    this->fitness = copy.fitness;
-
-    this->game_duration = copy.game_duration;
-    this->material_balance = copy.material_balance;
-    this->result = copy.result;
-
-    for (uint i = 0; i < copy.gene_string.size(); ++i)
-        this->gene_string.push_back(copy.get_gene(i));
+    for (ullong &word : this->gene_words)
+        word = random.next();
+    clear_unused_genes();
 }
 
 Chromosome::Chromosome(const vector<int> &features)
 {
-    initialize_data();
+    initialize_data(features.size() * BITS_PER_FEATURE);
     encode(features);
 }
 
-Chromosome::Chromosome(const vector<bool> &genes)
-{
-    initialize_data();
-    gene_string = genes;
-    decode(features);
-}
-
-void Chromosome::initialize_data()
+void Chromosome::initialize_data(uint genes_count)
 {
     this->fitness = 0.0;
     this->selection_probability = 0.0;
@@ -63,108 +39,121 @@ void Chromosome::initialize_data()
     this->result = ERROR;
     this->game_duration = 0;
     this->material_balance = 0;
+
+    this->genes_count = genes_count;
+    this->gene_words.assign((genes_count + BITS_PER_WORD - 1) / BITS_PER_WORD, 0);
 }
 
-void Chromosome::decode(vector<int> &features)
+// Keep the bits past the last gene at 0, so that whole words can be compared
+void Chromosome::clear_unused_genes()
 {
-    int feature_value = 0;
+    uint used_bits = this->genes_count % BITS_PER_WORD;
+    if (used_bits != 0)
+        this->gene_words.back() &= (1uLL << used_bits) - 1;
+}
 
+void Chromosome::decode(vector<int> &features) const
+{
     features.clear();
-    for (uint i = 0, j = 0; i < this->gene_string.size(); ++i, ++j)
+    for (uint locus = 0; locus + BITS_PER_FEATURE <= this->genes_count;
+         locus += BITS_PER_FEATURE)
     {
-        if (this->gene_string[i])
-        {
-            feature_value |= (1 << j);
-        }
-
-        if (i % BITS_PER_FEATURE == (BITS_PER_FEATURE - 1))
-        {
-            features.push_back(feature_value);
-            feature_value = 0;
-            j = 0;
-        }
+        uint word = locus / BITS_PER_WORD, offset = locus % BITS_PER_WORD;
+
+        // A feature may straddle two words
+        ullong bits = this->gene_words[word] >> offset;
+        if (offset + BITS_PER_FEATURE > BITS_PER_WORD)
+            bits |= this->gene_words[word + 1] << (BITS_PER_WORD - offset);
+
+        features.push_back((int)(bits & ((1u << BITS_PER_FEATURE) - 1)));
     }
 }
 
-// Mutate random genes in the chromosome with the given PROBABILITY
-void Chromosome::mutate(double probability)
+/*==============================================================================
+  Flip every gene with the given PROBABILITY. Rather than drawing a number per
+  gene, draw the distance to the next gene flipped, which follows a geometric
+  distribution, so that the cost depends on the number of genes flipped only.
+  ==============================================================================*/
+void Chromosome::mutate(double probability, util::Random &random)
 {
-    for (uint i = 1; i <= this->features.size(); ++i)
+    if (probability <= 0.0)
+        return;
+    if (probability >= 1.0)
     {
-        if ((RAND_MAX * probability) <= rand())
-        {
-            uint position = rand() % this->gene_string.size();
-            flip(position);
-        }
+        for (ullong &word : this->gene_words)
+            word = ~word;
+        clear_unused_genes();
+        return;
     }
-}
 
-// Combine two chromosomes to produce two offspring
-void Chromosome::reproduce(Chromosome &other, std::pair<Chromosome, Chromosome> &children)
-{
-    ushort half = this->gene_string.size() / 2;
-
-    vector<bool> first_born;
-    vector<bool> second_born;
-
-    for (uint k = 0; k < this->gene_string.size(); ++k)
+    double log_complement = std::log(1.0 - probability);
+    for (double locus = -1;;)
     {
-        first_born.push_back(false);
-        second_born.push_back(false);
+        // 1 - next_double() is never 0, so its logarithm is finite
+        locus += 1 + std::floor(std::log(1.0 - random.next_double()) / log_complement);
+        if (locus >= this->genes_count)
+            break;
+        flip((uint)locus);
     }
+}
 
-    uint i = 0;
-    for (; i < half; ++i)
-    {
-        first_born[i] = this->gene_string[i];
-        second_born[i] = other.gene_string[i];
+// Combine two chromosomes to produce two offspring, each one with the first
+// half of the genes of a parent and the second half of the other's
+void Chromosome::reproduce(
+    const Chromosome &other, std::pair<Chromosome, Chromosome> &children) const
+{
+    uint half = this->genes_count / 2;
 
-        first_born[half + i] = other.gene_string[half + i];
-        second_born[half + i] = this->gene_string[half + i];
-    }
+    children.first.initialize_data(this->genes_count);
+    children.second.initialize_data(this->genes_count);
 
-    if (util::is_odd(this->gene_string.size()))
+    for (uint word = 0; word < this->gene_words.size(); ++word)
     {
-        first_born[i] = other.gene_string[i];
-        second_born[i] = this->gene_string[i];
+        // Bits of this word that belong to the first half
+        uint first_bit = word * BITS_PER_WORD;
+        ullong first_half = 0;
+        if (half >= first_bit + BITS_PER_WORD)
+            first_half = ~0uLL;
+        else if (half > first_bit)
+            first_half = (1uLL << (half - first_bit)) - 1;
+
+        children.first.gene_words[word] = (this->gene_words[word] & first_half) |
+                                          (other.gene_words[word] & ~first_half);
+        children.second.gene_words[word] = (other.gene_words[word] & first_half) |
+                                           (this->gene_words[word] & ~first_half);
     }
-
-    children.first = Chromosome(first_born);
-    children.second = Chromosome(second_born);
 }
 
 void Chromosome::flip(uint position)
 {
-    if (position < this->gene_string.size())
-        this->gene_string[position] = !this->gene_string[position];
+    if (position < this->genes_count)
+        this->gene_words[position / BITS_PER_WORD] ^= 1uLL << (position % BITS_PER_WORD);
 }
 
 void Chromosome::set(uint position)
 {
-    if (position < this->gene_string.size())
-        this->gene_string[position] = true;
+    if (position < this->genes_count)
+        this->gene_words[position / BITS_PER_WORD] |= 1uLL << (position % BITS_PER_WORD);
 }
 
-void Chromosome::encode(const vector<int> &features)
+void Chromosome::unset(uint position)
 {
-    uint locus = 0;
+    if (position < this->genes_count)
+        this->gene_words[position / BITS_PER_WORD] &=
+            ~(1uLL << (position % BITS_PER_WORD));
+}
 
+void Chromosome::encode(const vector<int> &features)
+{
     for (uint i = 0; i < features.size(); ++i)
-    {
-        int feature_value = features[i];
-        for (uint j = 0; j < BITS_PER_FEATURE; ++j, ++locus)
-        {
-            if (feature_value & (1 << j))
-                this->gene_string.push_back(true);
-            else
-                this->gene_string.push_back(false);
-        }
-    }
+        for (uint j = 0; j < BITS_PER_FEATURE; ++j)
+            if (features[i] & (1 << j))
+                set(i * BITS_PER_FEATURE + j);
 }
 
 uint Chromosome::features_count() const
 {
-    return this->gene_string.size() / BITS_PER_FEATURE;
+    return this->genes_count / BITS_PER_FEATURE;
 }
 
 double Chromosome::get_fitness() const
@@ -174,17 +163,18 @@ double Chromosome::get_fitness() const
 
 bool Chromosome::get_gene(uint position) const
 {
-    if (position < this->gene_string.size())
-        return this->gene_string[position];
+    if (position >= this->genes_count)
+        return false;
 
-    return false;
+    return (this->gene_words[position / BITS_PER_WORD] >> (position % BITS_PER_WORD)) & 1;
 }
 
 string Chromosome::get_genes() const
 {
-    string genes = "";
-    for (uint i = 0; i < this->gene_string.size(); ++i)
-        genes += (this->gene_string[i] ? "1" : "0");
+    string genes(this->genes_count, '0');
+    for (uint i = 0; i < this->genes_count; ++i)
+        if (get_gene(i))
+            genes[i] = '1';
     return genes;
 }
 
@@ -243,16 +233,49 @@ void Chromosome::set_result(Chromosome::Outcome result)
     this->result = result;
 }
 
-bool Chromosome::operator==(const Chromosome &other) const
+/*==============================================================================
+  Write the chromosome, genes and game statistics, to the binary stream OUT
+  ==============================================================================*/
+void Chromosome::write(std::ostream &out) const
+{
+    util::write_binary(out, this->genes_count);
+    for (ullong word : this->gene_words)
+        util::write_binary(out, word);
+
+    util::write_binary(out, this->fitness);
+    util::write_binary(out, this->selection_probability);
+    util::write_binary(out, this->cumulative_probability);
+    util::write_binary(out, this->result);
+    util::write_binary(out, this->game_duration);
+    util::write_binary(out, this->material_balance);
+}
+
+// Read a chromosome written by write. Return FALSE if IN ends too soon.
+bool Chromosome::read(std::istream &in)
 {
-    if (this->gene_string.size() != other.gene_string.size())
+    const uint MAX_GENES_COUNT = 1 << 20;
+
+    uint genes_count;
+    if (!util::read_binary(in, genes_count) || genes_count > MAX_GENES_COUNT)
         return false;
 
-    for (uint i = 0, n = other.gene_string.size(); i < n; ++i)
-        if (this->gene_string[i] != other.gene_string[i])
+    initialize_data(genes_count);
+    for (ullong &word : this->gene_words)
+        if (!util::read_binary(in, word))
             return false;
+    clear_unused_genes();
+
+    return util::read_binary(in, this->fitness) &&
+           util::read_binary(in, this->selection_probability) &&
+           util::read_binary(in, this->cumulative_probability) &&
+           util::read_binary(in, this->result) &&
+           util::read_binary(in, this->game_duration) &&
+           util::read_binary(in, this->material_balance);
+}
 
-    return true;
+bool Chromosome::operator==(const Chromosome &other) const
+{
+    return this->genes_count == other.genes_count && this->gene_words == other.gene_words;
 }
 
 bool Chromosome::operator<(const Chromosome &other) const
@@ -263,30 +286,12 @@ bool Chromosome::operator<(const Chromosome &other) const
     return this->fitness < other.fitness;
 }
 
-Chromosome &Chromosome::operator=(const Chromosome &other)
-{
-    this->fitness = other.fitness;
-    this->selection_probability = other.selection_probability;
-    this->cumulative_probability = other.cumulative_probability;
-    this->result = other.result;
-    this->game_duration = other.game_duration;
-    this->material_balance = other.material_balance;
-
-    this->gene_string.clear();
-    for (uint i = 0; i < other.gene_string.size(); ++i)
-        this->gene_string.push_back(other.get_gene(i));
-
-    return *this;
-}
-
 std::ostream &operator<<(std::ostream &out, const Chromosome &other)
 {
     out << "Fitness:\t" << other.fitness << '\n';
     out << "Game result:\t" << other.result << '\n';
     out << "Game duration:\t" << other.game_duration << '\n';
-    for (uint i = 0; i < other.gene_string.size(); ++i)
-        out << (other.gene_string[i] ? '1' : '0');
-    out << "\n\n";
+    out << other.get_genes() << "\n\n";
 
     return out;
 }
@@ -7,6 +7,9 @@
 
   The weights in the evaluation function characterize the playing nature of the
   engine, including strength but also style (e.g. aggresive vs cautious)
+
+  Genes are packed 64 to a word, so that copying, crossing over and comparing
+  chromosomes work on whole words instead of single bits.
   ==============================================================================*/
 
 #include <iostream>
@@ -14,6 +17,7 @@
 #include <vector>
 
 #include "type_aliases.hpp"
+#include "util.hpp"
 
 namespace learning
 {
@@ -24,10 +28,8 @@ class Chromosome
 {
   public:
     Chromosome();
-    Chromosome(uint features_count);
-    Chromosome(const Chromosome &);
+    Chromosome(uint features_count, util::Random &random);
     Chromosome(const vector<int> &features);
-    Chromosome(const vector<bool> &genes);
 
     enum Outcome
     {
@@ -37,9 +39,10 @@ class Chromosome
         ERROR
     };
 
-    void decode(vector<int> &features);
-    void mutate(double probability);
-    void reproduce(Chromosome &other, std::pair<Chromosome, Chromosome> &children);
+    void decode(vector<int> &features) const;
+    void mutate(double probability, util::Random &random);
+    void reproduce(
+        const Chromosome &other, std::pair<Chromosome, Chromosome> &children) const;
 
     double get_fitness() const;
     bool get_gene(uint position) const;
@@ -61,17 +64,21 @@ class Chromosome
     void set_material_balance(int material);
     void set_result(Outcome result);
 
+    void write(std::ostream &out) const;
+    bool read(std::istream &in);
+
     bool operator==(const Chromosome &other) const;
     bool operator<(const Chromosome &other) const;
-    Chromosome &operator=(const Chromosome &other);
 
     friend std::ostream &operator<<(std::ostream &out, const Chromosome &other);
 
-  private:
     static const uint BITS_PER_FEATURE = 9;
 
-    vector<int> features;
-    vector<bool> gene_string;
+  private:
+    static const uint BITS_PER_WORD = 64;
+
+    vector<ullong> gene_words;
+    uint genes_count;
 
     double selection_probability;
     double cumulative_probability;
@@ -82,7 +89,8 @@ class Chromosome
     int material_balance;
 
     void encode(const vector<int> &features);
-    void initialize_data();
+    void initialize_data(uint genes_count);
+    void clear_unused_genes();
 };
 
 } // namespace learning
@@ -0,0 +1,109 @@
+#include "CommandLine.hpp"
+
+#include <cstdlib>
+
+namespace game_ui
+{
+using std::string;
+
+std::map<string, CommandLine::CommandKey> CommandLine::name_to_key = {
+    {"analyze-batch", ANALYZE_BATCH},
+    {"test-suite", TEST_SUITE},
+    {"bench", BENCH},
+    {"tournament", TOURNAMENT},
+    {"tune", TUNE},
+    {"bitbases", BITBASES},
+    {"convert", CONVERT},
+    {"datagen", DATAGEN},
+    {"perft", PERFT},
+};
+
+CommandLine::CommandLine(int argc, char **argv)
+{
+    this->valid = true;
+
+    // Options alone are those of the interactive engine
+    int first_argument = 1;
+    if (argc <= 1 || string(argv[1]).compare(0, 2, "--") == 0)
+        this->key = INTERACTIVE;
+    else
+    {
+        this->name = argv[first_argument++];
+        auto iter = CommandLine::name_to_key.find(this->name);
+        this->key = (iter != CommandLine::name_to_key.end() ? iter->second : UNKNOWN);
+    }
+
+    for (int i = first_argument; i < argc; ++i)
+    {
+        string argument = argv[i];
+        if (argument.compare(0, 2, "--") != 0)
+        {
+            this->arguments.push_back(argument);
+            continue;
+        }
+
+        // Every option takes exactly one value
+        if (i + 1 >= argc)
+        {
+            this->valid = false;
+            break;
+        }
+        this->options[argument.substr(2)] = argv[++i];
+    }
+}
+
+CommandLine::CommandKey CommandLine::get_key() const
+{
+    return this->key;
+}
+
+string CommandLine::get_name() const
+{
+    return this->name;
+}
+
+bool CommandLine::is_interactive() const
+{
+    return this->key == INTERACTIVE;
+}
+
+bool CommandLine::is_valid() const
+{
+    return this->valid && this->key != UNKNOWN;
+}
+
+const vector<string> &CommandLine::get_arguments() const
+{
+    return this->arguments;
+}
+
+bool CommandLine::has_option(const string &name) const
+{
+    return this->options.find(name) != this->options.end();
+}
+
+string CommandLine::get_option(const string &name, const string &default_value) const
+{
+    auto iter = this->options.find(name);
+    return iter != this->options.end() ? iter->second : default_value;
+}
+
+ullong CommandLine::get_option(const string &name, ullong default_value) const
+{
+    auto iter = this->options.find(name);
+    if (iter == this->options.end())
+        return default_value;
+
+    return strtoull(iter->second.c_str(), nullptr, 10);
+}
+
+double CommandLine::get_option(const string &name, double default_value) const
+{
+    auto iter = this->options.find(name);
+    if (iter == this->options.end())
+        return default_value;
+
+    return strtod(iter->second.c_str(), nullptr);
+}
+
+} // namespace game_ui
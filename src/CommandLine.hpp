@@ -0,0 +1,68 @@
+#ifndef COMMAND_LINE_H
+#define COMMAND_LINE_H
+
+/*==============================================================================
+  Represents the arguments the engine was started with. With no arguments, or
+  only options, the engine plays interactively (see UserCommand); otherwise
+  the first argument names an offline tool, followed by positional arguments
+  and options of the form --name value, e.g.
+
+  pawn analyze-batch positions.epd --threads 4 --depth 6
+  pawn --numa interleave
+  ==============================================================================*/
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "type_aliases.hpp"
+
+namespace game_ui
+{
+using std::string;
+using std::vector;
+
+class CommandLine
+{
+  public:
+    enum CommandKey
+    {
+        INTERACTIVE,
+        ANALYZE_BATCH,
+        TEST_SUITE,
+        BENCH,
+        TOURNAMENT,
+        TUNE,
+        BITBASES,
+        CONVERT,
+        DATAGEN,
+        PERFT,
+        UNKNOWN
+    };
+
+    CommandLine(int argc, char **argv);
+
+    CommandKey get_key() const;
+    string get_name() const;
+    bool is_interactive() const;
+    bool is_valid() const;
+
+    const vector<string> &get_arguments() const;
+    bool has_option(const string &name) const;
+    string get_option(const string &name, const string &default_value) const;
+    ullong get_option(const string &name, ullong default_value) const;
+    double get_option(const string &name, double default_value) const;
+
+  private:
+    CommandKey key;
+    string name;
+    bool valid;
+    vector<string> arguments;
+    std::map<string, string> options;
+
+    static std::map<string, CommandKey> name_to_key;
+};
+
+} // namespace game_ui
+
+#endif // COMMAND_LINE_H
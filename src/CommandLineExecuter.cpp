@@ -0,0 +1,752 @@
+#include "CommandLineExecuter.hpp"
+#include "AlphaBetaSearch.hpp"
+#include "BatchAnalyzer.hpp"
+#include "Benchmark.hpp"
+#include "Bitbases.hpp"
+#include "CommandLine.hpp"
+#include "DataGenerator.hpp"
+#include "EpdReader.hpp"
+#include "FenReader.hpp"
+#include "MaeBoard.hpp"
+#include "Perft.hpp"
+#include "PgnReader.hpp"
+#include "PositionRecord.hpp"
+#include "TelemetrySink.hpp"
+#include "TestSuiteRunner.hpp"
+#include "TexelTuner.hpp"
+#include "Tournament.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+namespace game_ui
+{
+using std::cerr;
+using std::endl;
+using std::string;
+using std::vector;
+
+using engine::AlphaBetaSearch;
+using engine::BatchAnalyzer;
+using engine::Benchmark;
+using engine::BenchmarkResult;
+using engine::Bitbases;
+using engine::Perft;
+using engine::PerftResult;
+using engine::SuiteResult;
+using engine::SprtSettings;
+using engine::TestSuiteRunner;
+using engine::Tournament;
+using engine::TournamentResult;
+using learning::DataGenerator;
+using learning::DataGeneratorResult;
+using learning::TexelTuner;
+using rules::MaeBoard;
+using serialization::EpdReader;
+using serialization::EpdRecord;
+using serialization::FenReader;
+using serialization::PgnGame;
+using serialization::PgnReader;
+using serialization::PositionRecord;
+using serialization::PositionRecordReader;
+using serialization::PositionRecordWriter;
+using diagnostics::TelemetrySink;
+
+int CommandLineExecuter::execute(const CommandLine &command_line)
+{
+    if (!command_line.is_valid())
+    {
+        print_usage();
+        return 1;
+    }
+
+    switch (command_line.get_key())
+    {
+    case CommandLine::ANALYZE_BATCH:
+        return analyze_batch(command_line);
+
+    case CommandLine::TEST_SUITE:
+        return run_test_suite(command_line);
+
+    case CommandLine::BENCH:
+        return run_benchmark(command_line);
+
+    case CommandLine::TOURNAMENT:
+        return run_tournament(command_line);
+
+    case CommandLine::TUNE:
+        return tune_evaluation(command_line);
+
+    case CommandLine::BITBASES:
+        return generate_bitbases(command_line);
+
+    case CommandLine::CONVERT:
+        return convert_dataset(command_line);
+
+    case CommandLine::DATAGEN:
+        return generate_data(command_line);
+
+    case CommandLine::PERFT:
+        return run_perft(command_line);
+
+    default:
+        print_usage();
+        return 1;
+    }
+}
+
+/*==============================================================================
+  pawn analyze-batch <epd-file> [--threads N] [--depth D] [--nodes N]
+                                [--output FILE]
+
+  Search every position in the EPD file, to depth D (5 by default) or until N
+  nodes have been visited, and write the results in the same order to FILE
+  (or to the standard output).
+  ==============================================================================*/
+int CommandLineExecuter::analyze_batch(const CommandLine &command_line)
+{
+    if (command_line.get_arguments().size() != 1)
+    {
+        print_usage();
+        return 1;
+    }
+
+    string positions_file = command_line.get_arguments()[0];
+    std::ifstream positions(positions_file);
+    if (!positions.good())
+    {
+        cerr << "Cannot open " << positions_file << endl;
+        return 1;
+    }
+
+    std::ofstream output_file;
+    if (command_line.has_option("output"))
+    {
+        output_file.open(command_line.get_option("output", ""));
+        if (!output_file.good())
+        {
+            cerr << "Cannot write to " << command_line.get_option("output", "") << endl;
+            return 1;
+        }
+    }
+    std::ostream &results = (output_file.is_open() ? output_file : std::cout);
+
+    ullong default_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    uint threads = command_line.get_option("threads", default_threads);
+    ullong nodes = command_line.get_option("nodes", 0uLL);
+
+    // A node limit alone lets iterative deepening go as deep as it can
+    ullong default_depth = (nodes > 0 ? AlphaBetaSearch::MAX_SEARCH_DEPTH : 5);
+    int depth = command_line.get_option("depth", default_depth);
+
+    std::ofstream telemetry_file;
+    std::unique_ptr<TelemetrySink> telemetry;
+    if (!open_telemetry_sink(command_line, telemetry_file, telemetry))
+        return 1;
+
+    BatchAnalyzer analyzer(threads, depth, nodes);
+    analyzer.set_telemetry_sink(telemetry.get());
+
+    auto start = std::chrono::steady_clock::now();
+    ullong positions_count = analyzer.analyze(positions, results);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    cerr << "Analyzed " << positions_count << " positions in " << elapsed.count()
+         << "s using " << threads << " thread(s)" << endl;
+
+    return 0;
+}
+
+/*==============================================================================
+  pawn test-suite <epd-file> [--time S] [--nodes N] [--depth D]
+
+  Search every position in the EPD file for S seconds (1 by default), N nodes
+  or D plies, whichever comes first, and report which ones were solved
+  according to their bm and am opcodes.
+  ==============================================================================*/
+int CommandLineExecuter::run_test_suite(const CommandLine &command_line)
+{
+    if (command_line.get_arguments().size() != 1)
+    {
+        print_usage();
+        return 1;
+    }
+
+    string suite_file = command_line.get_arguments()[0];
+    std::ifstream suite(suite_file);
+    if (!suite.good())
+    {
+        cerr << "Cannot open " << suite_file << endl;
+        return 1;
+    }
+
+    ullong nodes = command_line.get_option("nodes", 0uLL);
+    double default_time = (nodes > 0 ? 0.0 : 1.0);
+    double time = command_line.get_option("time", default_time);
+    int depth = command_line.get_option(
+        "depth", (ullong)AlphaBetaSearch::MAX_SEARCH_DEPTH);
+
+    std::ofstream telemetry_file;
+    std::unique_ptr<TelemetrySink> telemetry;
+    if (!open_telemetry_sink(command_line, telemetry_file, telemetry))
+        return 1;
+
+    TestSuiteRunner runner(depth, time, nodes);
+    runner.set_telemetry_sink(telemetry.get());
+    SuiteResult result = runner.run(suite, std::cout);
+
+    ullong tested = result.positions - result.skipped;
+    std::cout << std::endl
+              << "Solved " << result.solved << " of " << tested << " positions";
+    if (tested > 0)
+        std::cout << " (" << std::fixed << std::setprecision(1)
+                  << 100.0 * result.solved / tested << "%)";
+    std::cout << std::endl;
+
+    if (result.solved > 0)
+        std::cout << "Mean time to solution: " << std::setprecision(3)
+                  << result.solution_seconds / result.solved << "s" << std::endl;
+
+    std::cout << "Nodes searched: " << result.nodes << " in " << std::setprecision(3)
+              << result.seconds << "s";
+    if (result.seconds > 0)
+        std::cout << " (" << std::setprecision(0) << result.nodes / result.seconds
+                  << " nps)";
+    std::cout << std::endl;
+
+    return 0;
+}
+
+/*==============================================================================
+  pawn bench [--depth D]
+
+  Search the built-in benchmark positions to depth D and report the total
+  number of nodes searched, which must not change unless the search does, and
+  the speed of the search.
+  ==============================================================================*/
+int CommandLineExecuter::run_benchmark(const CommandLine &command_line)
+{
+    if (!command_line.get_arguments().empty())
+    {
+        print_usage();
+        return 1;
+    }
+
+    int depth = command_line.get_option("depth", (ullong)Benchmark::DEFAULT_DEPTH);
+    std::ofstream telemetry_file;
+    std::unique_ptr<TelemetrySink> telemetry;
+    if (!open_telemetry_sink(command_line, telemetry_file, telemetry))
+        return 1;
+
+    Benchmark benchmark(depth);
+    benchmark.set_telemetry_sink(telemetry.get());
+    BenchmarkResult result = benchmark.run(std::cerr);
+
+    std::cout << "===========================" << std::endl;
+    std::cout << "Depth          : " << depth << std::endl;
+    std::cout << "Total time (s) : " << std::fixed << std::setprecision(3)
+              << result.seconds << std::endl;
+    std::cout << "Nodes searched : " << result.nodes << std::endl;
+    std::cout << "Nodes/second   : " << std::setprecision(0)
+              << (result.seconds > 0 ? result.nodes / result.seconds : 0) << std::endl;
+
+    return 0;
+}
+
+/*==============================================================================
+  pawn tournament <openings-file> --candidate W --baseline W [--threads N]
+                  [--depth D] [--nodes N] [--pairs N] [--elo0 E] [--elo1 E]
+                  [--alpha A] [--beta B] [--pgn FILE]
+
+  Play pairs of games between two sets of evaluation weights (comma-separated
+  factor weights, e.g. 502,780,916,22, optionally followed by the piece values
+  from pawn to queen, as tune prints them) from the positions in the openings
+  file, an EPD or FEN file, until the SPRT accepts H0 (the candidate is E0 Elo
+  stronger, 0 by default) or H1 (it is E1 Elo stronger, 10 by default), or N
+  pairs (1000 by default) have been played. Every move is searched to depth D
+  (3 by default) or N nodes. The games are written in PGN to FILE, if given.
+  ==============================================================================*/
+int CommandLineExecuter::run_tournament(const CommandLine &command_line)
+{
+    vector<int> candidate, baseline;
+    if (command_line.get_arguments().size() != 1 ||
+        !read_weights(command_line.get_option("candidate", ""), candidate) ||
+        !read_weights(command_line.get_option("baseline", ""), baseline))
+    {
+        print_usage();
+        return 1;
+    }
+
+    string openings_file = command_line.get_arguments()[0];
+    std::ifstream openings_input(openings_file);
+    if (!openings_input.good())
+    {
+        cerr << "Cannot open " << openings_file << endl;
+        return 1;
+    }
+
+    vector<string> openings;
+    EpdReader reader(openings_input);
+    EpdRecord record;
+    MaeBoard board;
+    while (reader.next(record))
+        if (FenReader(record.position, &board).load_position())
+            openings.push_back(record.position);
+
+    if (openings.empty())
+    {
+        cerr << "No valid positions in " << openings_file << endl;
+        return 1;
+    }
+
+    ullong default_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    uint threads = command_line.get_option("threads", default_threads);
+    ullong nodes = command_line.get_option("nodes", 0uLL);
+    ullong default_depth = (nodes > 0 ? AlphaBetaSearch::MAX_SEARCH_DEPTH : 3);
+    int depth = command_line.get_option("depth", default_depth);
+    ullong max_pairs = command_line.get_option("pairs", 1000uLL);
+
+    SprtSettings sprt;
+    sprt.elo0 = command_line.get_option("elo0", 0.0);
+    sprt.elo1 = command_line.get_option("elo1", 10.0);
+    sprt.alpha = command_line.get_option("alpha", 0.05);
+    sprt.beta = command_line.get_option("beta", 0.05);
+
+    std::ofstream pgn_file;
+    if (command_line.has_option("pgn"))
+    {
+        pgn_file.open(command_line.get_option("pgn", ""));
+        if (!pgn_file.good())
+        {
+            cerr << "Cannot write to " << command_line.get_option("pgn", "") << endl;
+            return 1;
+        }
+    }
+
+    Tournament tournament(threads, depth, nodes);
+    tournament.set_players(candidate, baseline);
+    tournament.set_sprt(sprt);
+    tournament.set_pgn_output(pgn_file.is_open() ? &pgn_file : nullptr);
+    TournamentResult result = tournament.run(openings, max_pairs, std::cerr);
+
+    std::cout << "Games          : " << result.wins + result.losses + result.draws
+              << " (+" << result.wins << " -" << result.losses << " =" << result.draws
+              << ")" << endl;
+    std::cout << "Score          : " << std::fixed << std::setprecision(3)
+              << result.get_score() << " (" << std::setprecision(1) << result.get_elo()
+              << " Elo)" << endl;
+    std::cout << "LLR            : " << std::setprecision(2)
+              << result.log_likelihood_ratio << " [" << sprt.get_lower_bound() << ", "
+              << sprt.get_upper_bound() << "]" << endl;
+    std::cout << "Decision       : "
+              << (result.decision == TournamentResult::H1_ACCEPTED   ? "H1 accepted"
+                  : result.decision == TournamentResult::H0_ACCEPTED ? "H0 accepted"
+                                                                     : "undecided")
+              << endl;
+
+    return 0;
+}
+
+/*==============================================================================
+  pawn tune <dataset-file> [--threads N] [--iterations I] [--rate R]
+
+  Tune the evaluation weights and piece values on the positions of the dataset
+  file, EPD records labeled with the result of their game in the c9 opcode or
+  position records (see convert), taking I gradient steps (500 by default) of
+  R units (1 by default).
+  ==============================================================================*/
+int CommandLineExecuter::tune_evaluation(const CommandLine &command_line)
+{
+    if (command_line.get_arguments().size() != 1)
+    {
+        print_usage();
+        return 1;
+    }
+
+    string dataset_file = command_line.get_arguments()[0];
+    std::ifstream dataset(dataset_file);
+    if (!dataset.good())
+    {
+        cerr << "Cannot open " << dataset_file << endl;
+        return 1;
+    }
+
+    ullong default_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    uint threads = command_line.get_option("threads", default_threads);
+    uint iterations = command_line.get_option("iterations", 500uLL);
+    double learning_rate = command_line.get_option("rate", 1.0);
+
+    TexelTuner tuner(threads);
+    auto start = std::chrono::steady_clock::now();
+    PositionRecordReader records;
+    ullong positions =
+        (records.open(dataset_file) ? tuner.load(records) : tuner.load(dataset));
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    cerr << "Loaded " << positions << " positions in " << elapsed.count() << "s" << endl;
+
+    if (positions == 0)
+    {
+        cerr << "No labeled positions in " << dataset_file << endl;
+        return 1;
+    }
+
+    tuner.tune(iterations, learning_rate, cerr);
+
+    auto print_list = [](const vector<int> &values) {
+        for (uint i = 0; i < values.size(); ++i)
+            std::cout << (i > 0 ? "," : "") << values[i];
+        std::cout << endl;
+    };
+
+    std::cout << "Error          : " << std::fixed << std::setprecision(6)
+              << tuner.get_error() << endl;
+    std::cout << "Factor weights : ";
+    print_list(tuner.get_factor_weights());
+    std::cout << "Piece values   : ";
+    print_list(tuner.get_piece_values());
+
+    // Both together, as tournament takes them
+    vector<int> weights = tuner.get_factor_weights();
+    for (int value : tuner.get_piece_values())
+        weights.push_back(value);
+    std::cout << "Weights        : ";
+    print_list(weights);
+
+    return 0;
+}
+
+/*==============================================================================
+  pawn bitbases <directory> [--endings E1,E2,...] [--threads N]
+
+  Generate the bitbases of the given endings (KPK, KRK and KQK by default),
+  and of the smaller endings they turn into, and write them to the directory,
+  where the engine looks for them when it plays.
+  ==============================================================================*/
+int CommandLineExecuter::generate_bitbases(const CommandLine &command_line)
+{
+    if (command_line.get_arguments().size() != 1)
+    {
+        print_usage();
+        return 1;
+    }
+
+    string directory = command_line.get_arguments()[0];
+    ullong default_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    uint threads = command_line.get_option("threads", default_threads);
+    std::istringstream endings(command_line.get_option("endings", "KPK,KRK,KQK"));
+
+    Bitbases bitbases;
+    string ending;
+    while (std::getline(endings, ending, ','))
+        if (!bitbases.generate(ending, threads, cerr))
+        {
+            cerr << "Invalid ending " << ending << " (at most " << Bitbases::MAX_PIECES
+                 << " pieces, e.g. KRKP)" << endl;
+            return 1;
+        }
+
+    if (!bitbases.save(directory))
+    {
+        cerr << "Cannot write to " << directory << endl;
+        return 1;
+    }
+    return 0;
+}
+
+/*==============================================================================
+  pawn convert <input-file> <dataset-file>
+
+  Append the labeled positions of the input file to the dataset file, as
+  position records. A PGN input file (.pgn) gives every position of its
+  games, labeled with the result of the game; any other file is read as EPD,
+  labeled with the result in the c9 opcode and the score in the ce opcode.
+  ==============================================================================*/
+int CommandLineExecuter::convert_dataset(const CommandLine &command_line)
+{
+    const string PGN_EXTENSION = ".pgn";
+
+    if (command_line.get_arguments().size() != 2)
+    {
+        print_usage();
+        return 1;
+    }
+
+    string input_file = command_line.get_arguments()[0];
+    std::ifstream input(input_file);
+    if (!input.good())
+    {
+        cerr << "Cannot open " << input_file << endl;
+        return 1;
+    }
+
+    string dataset_file = command_line.get_arguments()[1];
+    PositionRecordWriter writer;
+    if (!writer.open(dataset_file))
+    {
+        cerr << "Cannot write to " << dataset_file << endl;
+        return 1;
+    }
+
+    MaeBoard board;
+    PositionRecord record;
+    ullong positions = 0, skipped = 0;
+    auto add_position = [&](PositionRecord::Result result, const short *score) {
+        if (PositionRecord::pack(board, result, record, score) && writer.write(record))
+            positions++;
+        else
+            skipped++;
+    };
+
+    bool is_pgn = input_file.size() >= PGN_EXTENSION.size() &&
+                  input_file.compare(
+                      input_file.size() - PGN_EXTENSION.size(), string::npos,
+                      PGN_EXTENSION) == 0;
+    if (is_pgn)
+    {
+        PgnReader reader(input);
+        PgnGame game;
+        vector<rules::Move> moves;
+        while (reader.next(game))
+        {
+            // Positions are recorded from the last, taking the moves back
+            if (!game.play(&board, moves))
+            {
+                skipped++;
+                continue;
+            }
+
+            PositionRecord::Result result = PositionRecord::parse_result(game.result);
+            for (size_t i = 0; i < moves.size(); ++i)
+            {
+                board.undo_move();
+                add_position(result, nullptr);
+            }
+        }
+    }
+    else
+    {
+        EpdReader reader(input);
+        EpdRecord epd_record;
+        while (reader.next(epd_record))
+        {
+            if (!FenReader(epd_record.position, &board).load_position())
+            {
+                skipped++;
+                continue;
+            }
+
+            // EPD scores are for the side to move
+            short score = 0;
+            bool has_score = epd_record.has_operation("ce");
+            if (has_score)
+            {
+                string ce = epd_record.get_operation("ce");
+                long centipawns = strtol(ce.c_str(), nullptr, 10);
+
+                // EPD mate scores count down from 32767 by the plies to mate
+                if (std::abs(centipawns) > PositionRecord::MAX_SCORE)
+                    centipawns = (centipawns > 0 ? 1 : -1) * PositionRecord::MATE_SCORE;
+                bool is_whites_turn = board.current_player() == rules::Piece::WHITE;
+                score = (is_whites_turn ? centipawns : -centipawns);
+            }
+
+            add_position(
+                PositionRecord::parse_result(epd_record.get_operation("c9")),
+                has_score ? &score : nullptr);
+        }
+    }
+
+    if (!writer.close())
+    {
+        cerr << "Cannot write to " << dataset_file << endl;
+        return 1;
+    }
+
+    std::cout << "Positions      : " << positions << endl;
+    std::cout << "Skipped        : " << skipped << endl;
+    return 0;
+}
+
+/*==============================================================================
+  pawn datagen <dataset-file> [--games G] [--threads N] [--depth D] [--nodes N]
+                              [--seed S]
+
+  Play G games (100 by default) of the engine against itself, searching every
+  move to depth D (3 by default) or N nodes, and append the positions searched
+  to the dataset file as position records, labeled with the score of the
+  search and the result of the game. Games start with random moves drawn from
+  seed S, so different seeds give different games.
+  ==============================================================================*/
+int CommandLineExecuter::generate_data(const CommandLine &command_line)
+{
+    if (command_line.get_arguments().size() != 1)
+    {
+        print_usage();
+        return 1;
+    }
+
+    string dataset_file = command_line.get_arguments()[0];
+    PositionRecordWriter writer;
+    if (!writer.open(dataset_file))
+    {
+        cerr << "Cannot write to " << dataset_file << endl;
+        return 1;
+    }
+
+    ullong default_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    uint threads = command_line.get_option("threads", default_threads);
+    ullong nodes = command_line.get_option("nodes", 0uLL);
+    ullong default_depth = (nodes > 0 ? AlphaBetaSearch::MAX_SEARCH_DEPTH : 3);
+    int depth = command_line.get_option("depth", default_depth);
+    ullong games = command_line.get_option("games", 100uLL);
+    ullong seed = command_line.get_option("seed", 1uLL);
+
+    DataGenerator generator(threads, depth, nodes, seed);
+    auto start = std::chrono::steady_clock::now();
+    DataGeneratorResult result = generator.run(games, writer, cerr);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    if (!writer.close() || result.games < games)
+    {
+        cerr << "Cannot write to " << dataset_file << endl;
+        return 1;
+    }
+
+    std::cout << "Games          : " << result.games << " (+" << result.white_wins
+              << " -" << result.black_wins << " =" << result.draws << ")" << endl;
+    std::cout << "Positions      : " << result.positions << endl;
+    std::cout << "Positions/sec  : " << (ullong)(result.positions / elapsed.count())
+              << endl;
+    return 0;
+}
+
+/*==============================================================================
+  pawn perft [--depth D] [--fen FEN] [--threads N] [--hash B]
+
+  Count the leaves of the tree of legal moves of the position FEN (the
+  initial one by default) down to depth D (5 by default), on N threads, with
+  a hash table of 2^B entries, and print the count under every legal move.
+  ==============================================================================*/
+int CommandLineExecuter::run_perft(const CommandLine &command_line)
+{
+    if (!command_line.get_arguments().empty())
+    {
+        print_usage();
+        return 1;
+    }
+
+    string fen = command_line.get_option("fen", string(FenReader::START_POSITION));
+    MaeBoard board;
+    if (!FenReader(fen, &board).load_position())
+    {
+        cerr << "Invalid position " << fen << endl;
+        return 1;
+    }
+
+    ullong default_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    uint threads = command_line.get_option("threads", default_threads);
+    int depth = command_line.get_option("depth", 5uLL);
+    uint hash_bits = std::min(
+        command_line.get_option("hash", (ullong)Perft::DEFAULT_HASH_SIZE_IN_BITS),
+        (ullong)Perft::MAX_HASH_SIZE_IN_BITS);
+
+    Perft perft(threads, hash_bits);
+    PerftResult result = perft.run(board, depth);
+
+    for (auto &move : result.moves)
+        std::cout << move.first.to_notation() << ": " << move.second << endl;
+    std::cout << "===========================" << endl;
+    std::cout << "Depth          : " << depth << endl;
+    std::cout << "Total time (s) : " << std::fixed << std::setprecision(3)
+              << result.seconds << endl;
+    std::cout << "Nodes          : " << result.nodes << endl;
+    std::cout << "Nodes/second   : " << std::setprecision(0)
+              << (result.seconds > 0 ? result.nodes / result.seconds : 0) << endl;
+    return 0;
+}
+
+/*==============================================================================
+  Create in TELEMETRY the sink requested with the option --telemetry FILE, if
+  any, where FILE may be - for the standard error. Return FALSE if FILE cannot
+  be written.
+  ==============================================================================*/
+bool CommandLineExecuter::open_telemetry_sink(
+    const CommandLine &command_line, std::ofstream &telemetry_file,
+    std::unique_ptr<TelemetrySink> &telemetry)
+{
+    if (!command_line.has_option("telemetry"))
+        return true;
+
+    string file_name = command_line.get_option("telemetry", "");
+    if (file_name == "-")
+    {
+        telemetry.reset(new TelemetrySink(std::cerr));
+        return true;
+    }
+
+    telemetry_file.open(file_name);
+    if (!telemetry_file.good())
+    {
+        cerr << "Cannot write to " << file_name << endl;
+        return false;
+    }
+    telemetry.reset(new TelemetrySink(telemetry_file));
+    return true;
+}
+
+/*==============================================================================
+  Parse the comma-separated integers in LIST into WEIGHTS. Return FALSE if
+  there are none or any of them is not a number.
+  ==============================================================================*/
+bool CommandLineExecuter::read_weights(const string &list, vector<int> &weights)
+{
+    std::istringstream items(list);
+    string item;
+
+    weights.clear();
+    while (std::getline(items, item, ','))
+    {
+        char *end;
+        long weight = strtol(item.c_str(), &end, 10);
+        if (item.empty() || *end != '\0')
+            return false;
+        weights.push_back(weight);
+    }
+    return !weights.empty();
+}
+
+void CommandLineExecuter::print_usage()
+{
+    cerr << "usage: pawn [--numa first-touch|interleave]" << endl;
+    cerr << "       pawn analyze-batch <epd-file> [--threads N] [--depth D] [--nodes N] "
+            "[--output FILE]"
+         << endl;
+    cerr << "       pawn test-suite <epd-file> [--time S] [--nodes N] [--depth D]" << endl;
+    cerr << "       pawn bench [--depth D]" << endl;
+    cerr << "       pawn tournament <openings-file> --candidate W --baseline W "
+            "[--threads N] [--depth D] [--nodes N] [--pairs N] [--elo0 E] [--elo1 E] "
+            "[--alpha A] [--beta B] [--pgn FILE]"
+         << endl;
+    cerr << "       pawn tune <dataset-file> [--threads N] [--iterations I] [--rate R]"
+         << endl;
+    cerr << "       pawn bitbases <directory> [--endings E1,E2,...] [--threads N]"
+         << endl;
+    cerr << "       pawn convert <input-file> <dataset-file>" << endl;
+    cerr << "       pawn datagen <dataset-file> [--games G] [--threads N] [--depth D] "
+            "[--nodes N] [--seed S]"
+         << endl;
+    cerr << "       pawn perft [--depth D] [--fen FEN] [--threads N] [--hash B]" << endl;
+    cerr << endl;
+    cerr << "analyze-batch, test-suite and bench accept --telemetry FILE (or - for "
+            "stderr) to write search statistics as JSON lines."
+         << endl;
+}
+
+} // namespace game_ui
@@ -0,0 +1,49 @@
+#ifndef COMMAND_LINE_EXECUTER_H
+#define COMMAND_LINE_EXECUTER_H
+
+/*==============================================================================
+  Runs the offline tools that can be requested from the command line (see
+  CommandLine), as opposed to the interactive commands run by
+  UserCommandExecuter.
+  ==============================================================================*/
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace diagnostics
+{
+class TelemetrySink;
+}
+
+namespace game_ui
+{
+class CommandLine;
+
+class CommandLineExecuter
+{
+  public:
+    int execute(const CommandLine &);
+
+  private:
+    int analyze_batch(const CommandLine &);
+    int run_test_suite(const CommandLine &);
+    int run_benchmark(const CommandLine &);
+    int run_tournament(const CommandLine &);
+    int tune_evaluation(const CommandLine &);
+    int generate_bitbases(const CommandLine &);
+    int convert_dataset(const CommandLine &);
+    int generate_data(const CommandLine &);
+    int run_perft(const CommandLine &);
+
+    static bool open_telemetry_sink(
+        const CommandLine &, std::ofstream &telemetry_file,
+        std::unique_ptr<diagnostics::TelemetrySink> &telemetry);
+    static bool read_weights(const std::string &list, std::vector<int> &weights);
+    static void print_usage();
+};
+
+} // namespace game_ui
+
+#endif // COMMAND_LINE_EXECUTER_H
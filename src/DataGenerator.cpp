@@ -0,0 +1,183 @@
+#include "DataGenerator.hpp"
+#include "AlphaBetaSearch.hpp"
+#include "MaeBoard.hpp"
+#include "MoveGenerator.hpp"
+#include "PositionEvaluator.hpp"
+#include "PositionRecord.hpp"
+#include "SanNotation.hpp"
+#include "util.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+namespace learning
+{
+using engine::AlphaBetaSearch;
+using engine::IEngine;
+using engine::MoveGenerator;
+using engine::PositionEvaluator;
+using rules::IBoard;
+using rules::MaeBoard;
+using rules::Move;
+using rules::Piece;
+using serialization::PositionRecord;
+using serialization::PositionRecordWriter;
+using serialization::SanNotation;
+using std::endl;
+using std::vector;
+
+struct DataGenerator::Worker
+{
+    Worker() : search(&evaluator, &generator)
+    {
+        search.set_verbose(false);
+    }
+
+    MaeBoard board;
+    PositionEvaluator evaluator;
+    MoveGenerator generator;
+    AlphaBetaSearch search;
+
+    // The positions of the game being played, and the game's result so far
+    vector<PositionRecord> records;
+    PositionRecord::Result result;
+};
+
+DataGenerator::DataGenerator(
+    uint threads_count, int max_depth, ullong node_limit, ullong seed)
+{
+    this->max_depth = max_depth;
+    this->seed = seed;
+
+    for (uint i = 0; i < std::max(threads_count, 1u); ++i)
+    {
+        this->workers.emplace_back(new Worker());
+        this->workers.back()->search.set_node_limit(node_limit);
+    }
+}
+
+DataGenerator::~DataGenerator()
+{
+}
+
+/*==============================================================================
+  Play GAMES_COUNT games and write their positions to WRITER, reporting the
+  progress to REPORT every now and then. Games whose positions could not be
+  written are not counted.
+  ==============================================================================*/
+DataGeneratorResult DataGenerator::run(
+    ullong games_count, PositionRecordWriter &writer, std::ostream &report)
+{
+    const ullong GAMES_BETWEEN_REPORTS = 100;
+
+    DataGeneratorResult result = {};
+    std::atomic<ullong> next_game(0);
+    std::mutex mutex;
+
+    auto work = [&](Worker &worker) {
+        for (ullong game = next_game++; game < games_count; game = next_game++)
+        {
+            if (!play_game(worker, game, writer))
+                continue;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            result.games++;
+            result.positions += worker.records.size();
+            result.white_wins += worker.result == PositionRecord::WHITE_WINS;
+            result.black_wins += worker.result == PositionRecord::BLACK_WINS;
+            result.draws += worker.result == PositionRecord::DRAW;
+
+            if (result.games % GAMES_BETWEEN_REPORTS == 0)
+                report << "Games " << result.games << ": " << result.positions
+                       << " positions  +" << result.white_wins << " -"
+                       << result.black_wins << " =" << result.draws << endl;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (auto &worker : this->workers)
+        threads.emplace_back(work, std::ref(*worker));
+    for (auto &thread : threads)
+        thread.join();
+
+    return result;
+}
+
+/*==============================================================================
+  Play game number GAME on WORKER: some random moves first, then the moves the
+  engine finds best, recording every position searched along with its score.
+  Return FALSE if its positions could not be written to WRITER.
+  ==============================================================================*/
+bool DataGenerator::play_game(Worker &worker, ullong game, PositionRecordWriter &writer)
+{
+    util::Random random(this->seed + game);
+    IBoard *board = &worker.board;
+    vector<Move> moves;
+
+    // Restart the random moves until they leave a game that goes on
+    do
+    {
+        worker.board.reset();
+        for (uint ply = 0; ply < RANDOM_PLIES; ++ply)
+        {
+            SanNotation::get_legal_moves(board, moves);
+            if (moves.empty())
+                break;
+
+            Move move = moves[random.next_below(moves.size())];
+            board->make_move(move, /* is_computer_move: */ true);
+        }
+        SanNotation::get_legal_moves(board, moves);
+    } while (moves.empty());
+
+    worker.search.clear_transposition_table();
+    worker.records.clear();
+    worker.result = PositionRecord::DRAW;
+
+    for (uint ply = RANDOM_PLIES; ply < MAX_GAME_PLIES; ++ply)
+    {
+        SanNotation::get_legal_moves(board, moves);
+        if (moves.empty())
+        {
+            if (board->is_king_in_check())
+                worker.result = (board->current_player() == Piece::WHITE
+                                     ? PositionRecord::BLACK_WINS
+                                     : PositionRecord::WHITE_WINS);
+            break;
+        }
+
+        Move move;
+        worker.search.get_best_move(this->max_depth, board, move);
+        if (move.is_null())
+            move = moves.front();
+
+        // Scores are recorded in centipawns, from white's point of view
+        int score = worker.search.get_score();
+        if (std::abs(score) == std::abs(IEngine::MATE_VALUE))
+            score = (score > 0 ? 1 : -1) * PositionRecord::MATE_SCORE;
+        else
+        {
+            score = worker.evaluator.to_centipawns(score);
+            score = std::max(std::min<int>(score, PositionRecord::MAX_SCORE),
+                             -PositionRecord::MAX_SCORE);
+        }
+        short white_score = (board->current_player() == Piece::WHITE ? score : -score);
+
+        PositionRecord record;
+        if (PositionRecord::pack(*board, PositionRecord::DRAW, record, &white_score))
+            worker.records.push_back(record);
+
+        if (board->make_move(move, /* is_computer_move: */ true) ==
+            IBoard::DRAW_BY_REPETITION)
+            break;
+    }
+
+    for (PositionRecord &record : worker.records)
+        record.result = worker.result;
+    return writer.write(worker.records.data(), worker.records.size());
+}
+
+} // namespace learning
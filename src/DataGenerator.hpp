@@ -0,0 +1,73 @@
+#ifndef DATA_GENERATOR_H
+#define DATA_GENERATOR_H
+
+/*==============================================================================
+  Generates training data by self-play: the engine plays games against itself
+  at a low depth (or a fixed number of nodes per move), and every position it
+  searches is recorded with the score of the search and, once the game is
+  over, the result of the game.
+
+  Games start with a few random moves, so that they do not all repeat the
+  same few lines. The random moves of a game only depend on the seed and the
+  number of the game, so the same settings always produce the same games,
+  whichever thread plays them.
+
+  Games are played on several threads at once, every thread owning a board
+  and an engine. A thread keeps the positions of the game it is playing and
+  writes them all at once when the game ends, straight to the shared dataset
+  file (see PositionRecordWriter, which needs no locks), so threads never
+  wait for each other. Positions appear in the file in the order games end.
+  ==============================================================================*/
+
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include "type_aliases.hpp"
+
+namespace serialization
+{
+class PositionRecordWriter;
+}
+
+namespace learning
+{
+struct DataGeneratorResult
+{
+    ullong games;
+    ullong positions;
+
+    // Games won by white and black, and drawn
+    ullong white_wins;
+    ullong black_wins;
+    ullong draws;
+};
+
+class DataGenerator
+{
+  public:
+    DataGenerator(uint threads_count, int max_depth, ullong node_limit, ullong seed);
+    ~DataGenerator();
+
+    DataGeneratorResult run(
+        ullong games_count, serialization::PositionRecordWriter &,
+        std::ostream &report);
+
+    static const uint RANDOM_PLIES = 8;
+
+    // Games still running then are drawn
+    static const uint MAX_GAME_PLIES = 400;
+
+  private:
+    struct Worker;
+
+    bool play_game(Worker &, ullong game, serialization::PositionRecordWriter &);
+
+    int max_depth;
+    ullong seed;
+    std::vector<std::unique_ptr<Worker>> workers;
+};
+
+} // namespace learning
+
+#endif // DATA_GENERATOR_H
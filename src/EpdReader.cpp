@@ -0,0 +1,113 @@
+#include "EpdReader.hpp"
+#include "FenReader.hpp"
+
+#include <cctype>
+#include <sstream>
+
+namespace serialization
+{
+using std::string;
+
+static string trim(const string &text)
+{
+    string::size_type begin = text.find_first_not_of(" \t\r\n");
+    if (begin == string::npos)
+        return "";
+
+    string::size_type end = text.find_last_not_of(" \t\r\n");
+    return text.substr(begin, end - begin + 1);
+}
+
+static bool is_number(const string &token)
+{
+    if (token.empty())
+        return false;
+
+    for (char c : token)
+        if (!isdigit(c))
+            return false;
+    return true;
+}
+
+bool EpdRecord::has_operation(const string &opcode) const
+{
+    return this->operations.find(opcode) != this->operations.end();
+}
+
+string EpdRecord::get_operation(const string &opcode) const
+{
+    auto iter = this->operations.find(opcode);
+    return iter != this->operations.end() ? iter->second : "";
+}
+
+EpdReader::EpdReader(std::istream &input) : input(input)
+{
+}
+
+/*=============================================================================
+  Return TRUE if another record could be read into RECORD, skipping blank and
+  comment (#) lines; return FALSE when the input has been exhausted. Malformed
+  lines are returned verbatim as the position of a record with no operations.
+  =============================================================================*/
+bool EpdReader::next(EpdRecord &record)
+{
+    string line;
+
+    while (std::getline(this->input, line))
+    {
+        line = trim(line);
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        if (!parse(line, record))
+            record.position = line;
+        return true;
+    }
+    return false;
+}
+
+bool EpdReader::parse(const string &line, EpdRecord &record)
+{
+    std::istringstream tokens(line);
+    string token;
+
+    record.position.clear();
+    record.operations.clear();
+
+    for (uint i = 0; i < FenReader::POSITION_FIELDS_COUNT; ++i)
+    {
+        if (!(tokens >> token))
+            return false;
+        record.position += (i > 0 ? " " : "") + token;
+    }
+
+    // Skip the halfmove clock and fullmove number if this is a full FEN
+    std::streampos operations_start = tokens.tellg();
+    string halfmove, fullmove;
+    if (!(tokens >> halfmove >> fullmove) || !is_number(halfmove) || !is_number(fullmove))
+    {
+        tokens.clear();
+        tokens.seekg(operations_start);
+    }
+
+    string operation;
+    while (std::getline(tokens, operation, ';'))
+    {
+        operation = trim(operation);
+        if (operation.empty())
+            continue;
+
+        string::size_type split = operation.find_first_of(" \t");
+        string opcode = operation.substr(0, split);
+        string operand = split == string::npos ? "" : trim(operation.substr(split));
+
+        if (operand.size() >= 2 && operand.front() == '"' && operand.back() == '"')
+            operand = operand.substr(1, operand.size() - 2);
+
+        record.operations[opcode] = operand;
+    }
+
+    return true;
+}
+
+} // namespace serialization
@@ -0,0 +1,45 @@
+#ifndef EPD_READER_H
+#define EPD_READER_H
+
+/*==============================================================================
+  Reads Extended Position Description (EPD) records one line at a time, e.g.
+
+  r1bqkb1r/pppp1ppp/2n2n2/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - bm Qxf7#; id "1";
+
+  Plain FEN lines (with their halfmove and fullmove counters) are accepted too,
+  in which case the record simply has no operations.
+  ==============================================================================*/
+
+#include <istream>
+#include <map>
+#include <string>
+
+namespace serialization
+{
+using std::string;
+
+struct EpdRecord
+{
+    // The position in FEN, restricted to the four fields EPD uses
+    string position;
+    std::map<string, string> operations;
+
+    bool has_operation(const string &opcode) const;
+    string get_operation(const string &opcode) const;
+};
+
+class EpdReader
+{
+  public:
+    EpdReader(std::istream &input);
+
+    bool next(EpdRecord &record);
+    static bool parse(const string &line, EpdRecord &record);
+
+  private:
+    std::istream &input;
+};
+
+} // namespace serialization
+
+#endif // EPD_READER_H
@@ -0,0 +1,170 @@
+#include "FenReader.hpp"
+#include "GameTraits.hpp"
+#include "Move.hpp"
+#include "bitboard.hpp"
+
+#include <cctype>
+#include <sstream>
+
+namespace serialization
+{
+using rules::BoardSquare;
+using rules::CastleSide;
+using rules::IBoard;
+using rules::Move;
+using rules::Piece;
+using std::string;
+
+constexpr const char *FenReader::START_POSITION;
+
+FenReader::FenReader(const string &fen, IBoard *board)
+{
+    this->fen = fen;
+    this->board = board;
+}
+
+/*=============================================================================
+  Return TRUE if THIS->FEN was a valid position and it was loaded into
+  THIS->BOARD; return FALSE otherwise (in which case the board is left empty)
+  =============================================================================*/
+bool FenReader::load_position()
+{
+    std::istringstream input(this->fen);
+    vector<string> fields;
+    string field;
+
+    while (fields.size() < POSITION_FIELDS_COUNT && input >> field)
+        fields.push_back(field);
+
+    this->board->clear();
+    if (fields.size() < POSITION_FIELDS_COUNT || !load_fields(fields))
+    {
+        this->board->clear();
+        return false;
+    }
+
+    return true;
+}
+
+/*=============================================================================
+  Load FIELDS into an empty THIS->BOARD. Return FALSE if any of them is not
+  valid.
+  =============================================================================*/
+bool FenReader::load_fields(const vector<string> &fields)
+{
+    if (!load_placement(fields[0]) || !load_turn(fields[1]) ||
+        !load_castling(fields[2]) || !load_en_passant(fields[3]))
+        return false;
+
+    // A position without exactly one king per side cannot be searched
+    for (Piece::Player player = Piece::WHITE; player <= Piece::BLACK; ++player)
+        if (bits::count_ones(this->board->get_pieces(player, Piece::KING)) != 1)
+            return false;
+
+    // The side not to move cannot be in check, or its king could be taken.
+    // Its king is looked at by handing it the turn for a moment.
+    Piece::Player player = (fields[1] == "w" ? Piece::WHITE : Piece::BLACK);
+    this->board->set_player_in_turn(Piece::Player(1 - player));
+    bool is_legal = !this->board->is_king_in_check();
+    this->board->set_player_in_turn(player);
+
+    return is_legal;
+}
+
+bool FenReader::load_placement(const string &placement)
+{
+    uint row = 0, column = 0;
+
+    for (char symbol : placement)
+    {
+        if (symbol == '/')
+        {
+            if (column != rules::BOARD_SIZE)
+                return false;
+            ++row;
+            column = 0;
+        }
+        else if (symbol >= '1' && symbol <= '8')
+        {
+            column += symbol - '0';
+        }
+        else
+        {
+            Piece::Type type;
+            Piece::Player player;
+
+            if (!get_piece(symbol, type, player) || row >= rules::BOARD_SIZE ||
+                column >= rules::BOARD_SIZE)
+                return false;
+
+            auto square = BoardSquare(row * rules::BOARD_SIZE + column);
+            if (!this->board->add_piece(square, type, player))
+                return false;
+            ++column;
+        }
+
+        if (column > rules::BOARD_SIZE)
+            return false;
+    }
+
+    return row == rules::BOARD_SIZE - 1 && column == rules::BOARD_SIZE;
+}
+
+bool FenReader::load_turn(const string &turn)
+{
+    if (turn != "w" && turn != "b")
+        return false;
+
+    this->board->set_player_in_turn(turn == "w" ? Piece::WHITE : Piece::BLACK);
+    return true;
+}
+
+bool FenReader::load_castling(const string &castling)
+{
+    if (castling != "-")
+        for (char symbol : castling)
+            if (string("KQkq").find(symbol) == string::npos)
+                return false;
+
+    // An empty board starts with all castling privileges granted
+    auto has = [&castling](char symbol) { return castling.find(symbol) != string::npos; };
+
+    if (!has('K'))
+        this->board->set_castling_privilege(Piece::WHITE, CastleSide::KING_SIDE, false);
+    if (!has('Q'))
+        this->board->set_castling_privilege(Piece::WHITE, CastleSide::QUEEN_SIDE, false);
+    if (!has('k'))
+        this->board->set_castling_privilege(Piece::BLACK, CastleSide::KING_SIDE, false);
+    if (!has('q'))
+        this->board->set_castling_privilege(Piece::BLACK, CastleSide::QUEEN_SIDE, false);
+
+    return true;
+}
+
+bool FenReader::load_en_passant(const string &en_passant)
+{
+    if (en_passant == "-")
+        return true;
+
+    BoardSquare square;
+    if (!Move::translate_to_square(en_passant, square))
+        return false;
+
+    this->board->set_en_passant_capture_square(square);
+    return true;
+}
+
+bool FenReader::get_piece(char symbol, Piece::Type &type, Piece::Player &player)
+{
+    static const string symbols = "pnbrqk";
+
+    string::size_type index = symbols.find(char(tolower(symbol)));
+    if (index == string::npos)
+        return false;
+
+    type = Piece::Type(index);
+    player = isupper(symbol) ? Piece::WHITE : Piece::BLACK;
+    return true;
+}
+
+} // namespace serialization
@@ -0,0 +1,49 @@
+#ifndef FEN_READER_H
+#define FEN_READER_H
+
+/*==============================================================================
+  Reads chess positions written in Forsyth-Edwards Notation (FEN), e.g.
+
+  rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1
+
+  Only the first four fields (placement, turn, castling and en-passant) are
+  required, so EPD positions can be loaded as well.
+  ==============================================================================*/
+
+#include <string>
+#include <vector>
+
+#include "IBoard.hpp"
+
+namespace serialization
+{
+using std::string;
+using std::vector;
+
+class FenReader
+{
+  public:
+    FenReader(const string &fen, rules::IBoard *board);
+
+    bool load_position();
+
+    static const uint POSITION_FIELDS_COUNT = 4;
+    static constexpr const char *START_POSITION =
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+  private:
+    string fen;
+    rules::IBoard *board;
+
+    bool load_fields(const vector<string> &fields);
+    bool load_placement(const string &placement);
+    bool load_turn(const string &turn);
+    bool load_castling(const string &castling);
+    bool load_en_passant(const string &en_passant);
+
+    static bool get_piece(char symbol, rules::Piece::Type &, rules::Piece::Player &);
+};
+
+} // namespace serialization
+
+#endif // FEN_READER_H
@@ -0,0 +1,74 @@
+#include "FenWriter.hpp"
+#include "Move.hpp"
+#include "bitboard.hpp"
+
+#include <algorithm>
+
+namespace serialization
+{
+using rules::BoardSquare;
+using rules::CastleSide;
+using rules::IBoard;
+using rules::Move;
+using rules::Piece;
+using std::string;
+
+string FenWriter::write(const IBoard &board)
+{
+    static const char SYMBOLS[] = "pnbrqk";
+
+    string fen;
+    for (uint row = 0; row < rules::BOARD_SIZE; ++row)
+    {
+        uint empty_squares = 0;
+        for (uint col = 0; col < rules::BOARD_SIZE; ++col)
+        {
+            BoardSquare square = BoardSquare(row * rules::BOARD_SIZE + col);
+            Piece::Type piece = board.get_piece(square);
+            if (piece == Piece::NULL_PIECE)
+            {
+                empty_squares++;
+                continue;
+            }
+
+            if (empty_squares > 0)
+                fen += char('0' + empty_squares);
+            empty_squares = 0;
+
+            char symbol = SYMBOLS[piece];
+            bool is_white = board.get_piece_color(square) == Piece::WHITE;
+            fen += (is_white ? char(toupper(symbol)) : symbol);
+        }
+
+        if (empty_squares > 0)
+            fen += char('0' + empty_squares);
+        if (row + 1 < rules::BOARD_SIZE)
+            fen += '/';
+    }
+
+    bool is_whites_turn = board.current_player() == Piece::WHITE;
+    fen += (is_whites_turn ? " w " : " b ");
+
+    string castling;
+    if (board.can_castle(Piece::WHITE, CastleSide::KING_SIDE))
+        castling += 'K';
+    if (board.can_castle(Piece::WHITE, CastleSide::QUEEN_SIDE))
+        castling += 'Q';
+    if (board.can_castle(Piece::BLACK, CastleSide::KING_SIDE))
+        castling += 'k';
+    if (board.can_castle(Piece::BLACK, CastleSide::QUEEN_SIDE))
+        castling += 'q';
+    fen += (castling.empty() ? "-" : castling);
+
+    string en_passant = "-";
+    if (board.get_en_passant_square())
+        Move::translate_to_notation(
+            BoardSquare(bits::msb_position(board.get_en_passant_square())), en_passant);
+    fen += " " + en_passant;
+
+    uint move_number = board.get_move_number() + (is_whites_turn ? 1 : 0);
+    fen += " 0 " + std::to_string(std::max(move_number, 1u));
+    return fen;
+}
+
+} // namespace serialization
@@ -0,0 +1,24 @@
+#ifndef FEN_WRITER_H
+#define FEN_WRITER_H
+
+/*==============================================================================
+  Writes chess positions in Forsyth-Edwards Notation (FEN), the inverse of
+  FenReader. Boards do not keep a halfmove clock, so it is always written as
+  0, and the fullmove number assumes the game started from move 1.
+  ==============================================================================*/
+
+#include <string>
+
+#include "IBoard.hpp"
+
+namespace serialization
+{
+class FenWriter
+{
+  public:
+    static std::string write(const rules::IBoard &board);
+};
+
+} // namespace serialization
+
+#endif // FEN_WRITER_H
@@ -1,81 +1,135 @@
 #include "FitnessEvaluator.hpp"
+#include "AlphaBetaSearch.hpp"
 #include "Chromosome.hpp"
 #include "IEngine.hpp"
 #include "MaeBoard.hpp"
 #include "Move.hpp"
+#include "MoveGenerator.hpp"
 #include "PositionEvaluator.hpp"
-#include "Timer.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>
+#include <thread>
 
 namespace learning
 {
 using rules::IBoard;
 using rules::Piece;
 
+using engine::AlphaBetaSearch;
 using engine::IEngine;
+using engine::MoveGenerator;
+using engine::PositionEvaluator;
 
-FitnessEvaluator::FitnessEvaluator(IEngine *chess_engine)
+struct FitnessEvaluator::Worker
 {
-    this->chess_engine = chess_engine;
-    this->board = new rules::MaeBoard();
-    this->evaluator = new engine::PositionEvaluator();
+    Worker()
+        : searches{{&evaluators[0], &generator}, {&evaluators[1], &generator}}
+    {
+        searches[0].set_verbose(false);
+        searches[1].set_verbose(false);
+    }
+
+    rules::MaeBoard board;
+    MoveGenerator generator;
+    PositionEvaluator referee;
+    PositionEvaluator evaluators[2];
+    AlphaBetaSearch searches[2];
+};
+
+FitnessEvaluator::FitnessEvaluator(uint threads_count)
+{
+    for (uint i = 0; i < std::max(threads_count, 1u); ++i)
+        this->workers.emplace_back(new Worker());
 }
 
 FitnessEvaluator::~FitnessEvaluator()
 {
-    delete this->board;
-    delete this->evaluator;
 }
 
 // Chromosome A is assumed to be stronger than B, though this may not be true
 double FitnessEvaluator::evaluate(Chromosome &a, Chromosome &b)
 {
-    double evaluation = 0.0;
-    std::vector<int> features[2];
+    std::vector<int> features;
+    a.decode(features);
+
+    return play_game(*this->workers.front(), features, b);
+}
+
+/*==============================================================================
+  Play REFERENCE (as white) against every one of CHALLENGERS, spreading the
+  games over all the workers, and record the outcome of every game in its
+  challenger
+  ==============================================================================*/
+void FitnessEvaluator::evaluate(
+    Chromosome &reference, std::vector<Chromosome> &challengers)
+{
+    std::vector<int> features;
+    reference.decode(features);
+
+    // Every game writes to its own challenger only, so there is nothing to lock
+    std::atomic<size_t> next_game(0);
+    auto work = [&](Worker &worker) {
+        for (size_t game = next_game++; game < challengers.size(); game = next_game++)
+            play_game(worker, features, challengers[game]);
+    };
+
+    std::vector<std::thread> threads;
+    for (auto &worker : this->workers)
+        threads.emplace_back(work, std::ref(*worker));
+
+    for (auto &thread : threads)
+        thread.join();
+}
 
-    a.decode(features[0]);
-    b.decode(features[1]);
+/*==============================================================================
+  Play a game between WHITE's weights and chromosome BLACK from the initial
+  position, and set BLACK's result, game duration, material balance and fitness
+  ==============================================================================*/
+double FitnessEvaluator::play_game(
+    Worker &worker, const std::vector<int> &white, Chromosome &black)
+{
+    double evaluation = 0.0;
+    std::vector<int> features[2] = {white, {}};
+    black.decode(features[1]);
 
-    /*--------------------------------------------------------------------------
-      Set up a game between the two and see who wins and by how much...
-      Use a single engine, just load and unload the factor weights after
-      every move...
-      -------------------------------------------------------------------------*/
-    auto timer = new diagnostics::Timer();
-    timer->start();
+    for (uint side = 0; side < 2; ++side)
+    {
+        worker.evaluators[side].load_factor_weights(features[side]);
+        worker.searches[side].clear_transposition_table();
+    }
 
-    this->board->reset();
+    IBoard *board = &worker.board;
+    board->reset();
 
     // Chromosome A plays white
     IEngine::GameResult result;
     uint turn = 0;
     do
     {
-        this->chess_engine->load_factor_weights(features[turn]);
-
         rules::Move move;
-        result = this->chess_engine->get_best_move(3, this->board, move);
+        result = worker.searches[turn].get_best_move(SEARCH_DEPTH, board, move);
         if (result == IEngine::WHITE_MATES || result == IEngine::BLACK_MATES ||
             result == IEngine::STALEMATE)
             break;
 
-        IBoard::Error error = this->board->make_move(move, true);
+        IBoard::Error error = board->make_move(move, true);
         if (error != IBoard::NO_ERROR && error != IBoard::DRAW_BY_REPETITION)
         {
             abort();
         }
         else if (error == IBoard::DRAW_BY_REPETITION)
         {
-            this->board->undo_move();
+            board->undo_move();
             result = IEngine::DRAW_BY_REPETITION;
             break;
         }
         turn = (turn + 1) % 2;
 
-        if (this->board->get_move_number() >= MAX_ALLOWED_MOVEMENTS)
+        if (board->get_move_number() >= MAX_ALLOWED_MOVEMENTS)
         {
-            int material = this->evaluator->evaluate_material(board);
+            int material = worker.referee.evaluate_material(board);
 
             if (material == 0)
             {
@@ -99,12 +153,10 @@ double FitnessEvaluator::evaluate(Chromosome &a, Chromosome &b)
         }
     } while (true);
 
-    timer->stop();
-
     if (result == IEngine::STALEMATE || result == IEngine::DRAW_BY_REPETITION)
     {
         evaluation = 1.0 / 2.0;
-        b.set_result(Chromosome::DRAW);
+        black.set_result(Chromosome::DRAW);
     }
     else
     {
@@ -113,20 +165,18 @@ double FitnessEvaluator::evaluate(Chromosome &a, Chromosome &b)
         if (result == IEngine::WHITE_MATES)
         {
             evaluation = 1 - evaluation;
-            b.set_result(Chromosome::LOSS);
+            black.set_result(Chromosome::LOSS);
         }
         else
         {
-            b.set_result(Chromosome::WIN);
+            black.set_result(Chromosome::WIN);
         }
 
-        b.set_game_duration(board->get_move_number());
+        black.set_game_duration(board->get_move_number());
     }
 
-    b.set_material_balance(this->evaluator->evaluate_material(board));
-    b.set_fitness(evaluation);
-
-    delete timer;
+    black.set_material_balance(worker.referee.evaluate_material(board));
+    black.set_fitness(evaluation);
 
     return evaluation;
 }
@@ -3,21 +3,21 @@
 
 /*==============================================================================
   Compares chess evaluation functions (encoded as chromosomes) in order to find
-  the best ones when running a genetic algorithm
+  the best ones when running a genetic algorithm.
+
+  The games of a generation are independent from each other, so they are played
+  on several threads at once. Every thread owns a board and one complete engine
+  per side, so threads never share mutable state and no weights need to be
+  swapped between half-moves. Both engines start every game with an empty
+  transposition table: the search has no random component, so the outcome of a
+  game only depends on the two chromosomes playing it, not on which thread
+  played it or what it played before.
   ==============================================================================*/
 
-#include "type_aliases.hpp"
-
-namespace engine
-{
-class IEngine;
-class PositionEvaluator;
-} // namespace engine
+#include <memory>
+#include <vector>
 
-namespace rules
-{
-class IBoard;
-}
+#include "type_aliases.hpp"
 
 namespace learning
 {
@@ -26,16 +26,21 @@ class Chromosome;
 class FitnessEvaluator
 {
   public:
-    FitnessEvaluator(engine::IEngine *);
+    FitnessEvaluator(uint threads_count);
     ~FitnessEvaluator();
 
     double evaluate(Chromosome &, Chromosome &);
+    void evaluate(Chromosome &reference, std::vector<Chromosome> &challengers);
+
     static const uint MAX_ALLOWED_MOVEMENTS = 70;
+    static const int SEARCH_DEPTH = 3;
 
   private:
-    rules::IBoard *board;
-    engine::IEngine *chess_engine;
-    engine::PositionEvaluator *evaluator;
+    struct Worker;
+
+    double play_game(Worker &, const std::vector<int> &white, Chromosome &black);
+
+    std::vector<std::unique_ptr<Worker>> workers;
 };
 
 } // namespace learning
@@ -1,6 +1,10 @@
 #include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstdio>
 #include <cstdlib>
+#include <fstream>
+#include <functional>
 #include <iostream>
 
 #include "Chromosome.hpp"
@@ -15,69 +19,162 @@ using std::vector;
 GeneticAlgorithm::GeneticAlgorithm(
     uint population_size, uint iterations_count, double mutation_probability,
     FitnessEvaluator *fitness_evaluator)
+    : random(DEFAULT_RANDOM_SEED)
 {
     this->population_size = population_size;
     this->iterations_count = iterations_count;
     this->mutation_probability = mutation_probability;
     this->fitness_evaluator = fitness_evaluator;
+    this->generation = 0;
+    this->is_resumed = false;
 }
 
+constexpr const char *GeneticAlgorithm::DEFAULT_CHECKPOINT_FILE;
+
 void GeneticAlgorithm::run()
 {
-    initialize_population();
+    if (!this->is_resumed)
+    {
+        initialize_population();
+        this->generation = 0;
+    }
 
     uint subpopulation_size = (uint)(this->population_size * SELECTION_PERCENTAGE);
     if (util::is_odd(subpopulation_size))
         ++subpopulation_size;
 
-    for (uint i = 0; i < this->iterations_count; ++i)
+    while (this->generation < this->iterations_count)
     {
         evaluate_population();
         set_actual_fitness();
 
         vector<Chromosome> parents;
-        parents.clear();
-        select_breeding_individuals(this->population, subpopulation_size, parents);
+        select_breeding_individuals(subpopulation_size, parents);
 
+        // Mate the parents in random pairs
         vector<Chromosome> offspring;
-        offspring.clear();
-        uint size = parents.size();
-        while (size >= 2)
+        for (uint size = parents.size(); size >= 2; size -= 2)
         {
-            std::pair<Chromosome, Chromosome> children;
+            std::swap(parents[this->random.next_below(size)], parents[size - 1]);
+            std::swap(parents[this->random.next_below(size - 1)], parents[size - 2]);
 
-            uint selected = rand() % size;
-            Chromosome individualA = parents[selected];
-            parents[selected] = parents[size - 1];
-            parents.pop_back();
-
-            selected = rand() % (--size);
-            Chromosome individualB = parents[selected];
-            parents[selected] = parents[size - 1];
-            parents.pop_back();
-
-            individualA.reproduce(individualB, children);
+            std::pair<Chromosome, Chromosome> children;
+            parents[size - 1].reproduce(parents[size - 2], children);
             offspring.push_back(children.first);
             offspring.push_back(children.second);
-
-            --size;
         }
 
         reduce_population(subpopulation_size);
         add_on_population(offspring);
 
-        uint individuals = rand() % population_size;
+        uint individuals = this->random.next_below(this->population_size);
         while (individuals)
         {
-            population[rand() % this->population_size].mutate(this->mutation_probability);
+            this->population[this->random.next_below(this->population_size)].mutate(
+                this->mutation_probability, this->random);
             --individuals;
         }
 
+        this->generation++;
+        if (!this->checkpoint_file.empty() && !save_checkpoint(this->checkpoint_file))
+            std::cerr << "Cannot write checkpoint " << this->checkpoint_file << '\n';
+
         if (converge())
             break;
     }
 }
 
+void GeneticAlgorithm::set_checkpoint_file(const std::string &file_name)
+{
+    this->checkpoint_file = file_name;
+}
+
+namespace
+{
+const char CHECKPOINT_MAGIC[8] = {'P', 'A', 'W', 'N', 'G', 'A', '0', '1'};
+}
+
+/*==============================================================================
+  Write the state of the run, as of the end of the last generation, to
+  FILE_NAME. The file is written under another name first and then renamed,
+  so an interruption never leaves a partial checkpoint behind.
+  ==============================================================================*/
+bool GeneticAlgorithm::save_checkpoint(const std::string &file_name) const
+{
+    std::string temporary_file = file_name + ".tmp";
+    {
+        std::ofstream out(temporary_file, std::ios::binary | std::ios::trunc);
+        if (!out.good())
+            return false;
+
+        ullong random_state[util::Random::STATE_SIZE];
+        this->random.get_state(random_state);
+
+        out.write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+        util::write_binary(out, this->generation);
+        util::write_binary(out, this->iterations_count);
+        util::write_binary(out, this->mutation_probability);
+        for (ullong word : random_state)
+            util::write_binary(out, word);
+
+        this->fittest_member.write(out);
+        util::write_binary(out, (uint)this->population.size());
+        for (const Chromosome &individual : this->population)
+            individual.write(out);
+
+        if (!out.flush())
+            return false;
+    }
+    return std::rename(temporary_file.c_str(), file_name.c_str()) == 0;
+}
+
+/*==============================================================================
+  Restore the run saved in FILE_NAME, so that the next call to run continues
+  with the generation after the last one saved. Return FALSE if the file
+  cannot be read, in which case the algorithm is left as it was.
+  ==============================================================================*/
+bool GeneticAlgorithm::load_checkpoint(const std::string &file_name)
+{
+    const uint MAX_POPULATION_SIZE = 1 << 24;
+
+    std::ifstream in(file_name, std::ios::binary);
+    char magic[sizeof(CHECKPOINT_MAGIC)];
+    if (!in.read(magic, sizeof(magic)) ||
+        !std::equal(magic, magic + sizeof(magic), CHECKPOINT_MAGIC))
+        return false;
+
+    uint generation, iterations_count, population_size;
+    double mutation_probability;
+    ullong random_state[util::Random::STATE_SIZE];
+    Chromosome fittest_member;
+
+    if (!util::read_binary(in, generation) || !util::read_binary(in, iterations_count) ||
+        !util::read_binary(in, mutation_probability))
+        return false;
+    for (ullong &word : random_state)
+        if (!util::read_binary(in, word))
+            return false;
+    if (!fittest_member.read(in) || !util::read_binary(in, population_size) ||
+        population_size > MAX_POPULATION_SIZE)
+        return false;
+
+    vector<Chromosome> population(population_size);
+    for (Chromosome &individual : population)
+        if (!individual.read(in))
+            return false;
+
+    this->generation = generation;
+    this->iterations_count = iterations_count;
+    this->mutation_probability = mutation_probability;
+    this->random.set_state(random_state);
+    this->fittest_member = fittest_member;
+    this->population.swap(population);
+    this->population_size = this->population.size();
+    this->is_resumed = true;
+
+    return true;
+}
+
 bool GeneticAlgorithm::converge()
 {
     return false;
@@ -87,21 +184,18 @@ void GeneticAlgorithm::reduce_population(uint size)
 {
     std::cerr << "Reducing this population . . ." << '\n';
 
+    // Remove the SIZE least fit individuals at once
     sort(this->population.begin(), this->population.end());
-
-    for (uint i = 0; i < size; ++i)
-        this->population.erase(this->population.begin());
+    this->population.erase(
+        this->population.begin(),
+        this->population.begin() + std::min<size_t>(size, this->population.size()));
 
     this->population_size = this->population.size();
 }
 
 void GeneticAlgorithm::add_on_population(const vector<Chromosome> &elements)
 {
-    uint size = elements.size();
-
-    for (uint i = 0; i < size; ++i)
-        this->population.push_back(elements[i]);
-
+    this->population.insert(this->population.end(), elements.begin(), elements.end());
     this->population_size = population.size();
 }
 
@@ -110,6 +204,11 @@ void GeneticAlgorithm::set_seed(Chromosome &seed)
     this->fittest_member = seed;
 }
 
+void GeneticAlgorithm::set_random_seed(ullong seed)
+{
+    this->random = util::Random(seed);
+}
+
 Chromosome GeneticAlgorithm::get_fittest_member()
 {
     return Chromosome(this->fittest_member);
@@ -120,13 +219,10 @@ Chromosome GeneticAlgorithm::get_fittest_member()
 void GeneticAlgorithm::initialize_population()
 {
     uint features_count = this->fittest_member.features_count();
-    vector<int> features;
 
+    this->population.clear();
     for (uint i = 0; i < this->population_size; ++i)
-    {
-        Chromosome individual(features_count);
-        this->population.push_back(individual);
-    }
+        this->population.emplace_back(features_count, this->random);
 }
 
 void GeneticAlgorithm::evaluate_population()
@@ -134,12 +230,10 @@ void GeneticAlgorithm::evaluate_population()
     uint best_index = 0;
     uint average_game_duration = 0;
 
+    this->fitness_evaluator->evaluate(this->fittest_member, this->population);
+
     for (uint i = 0; i < this->population.size(); ++i)
     {
-        double score =
-            this->fitness_evaluator->evaluate(this->fittest_member, population[i]);
-        this->population[i].set_fitness(score);
-
         average_game_duration += this->population[i].get_game_duration();
 
         if (this->fittest_member.get_fitness() < this->population[i].get_fitness())
@@ -149,12 +243,18 @@ void GeneticAlgorithm::evaluate_population()
     this->fittest_member = this->population[best_index];
 }
 
-// Use fitness proportionate selection here (aka roulette-wheel selection) to
-// a second chance to not-so-good candidate solutions.
+/*==============================================================================
+  Use fitness proportionate selection here (aka roulette-wheel selection) to
+  give a second chance to not-so-good candidate solutions. Individuals are
+  drawn without replacement, which is the same as giving each one the key
+  U^(1 / fitness), for U uniform in (0, 1), and taking the largest keys
+  (Efraimidis and Spirakis), so it takes a single pass over the population.
+  ==============================================================================*/
 void GeneticAlgorithm::select_breeding_individuals(
-    vector<Chromosome> &population, uint breeding_population_size,
-    vector<Chromosome> &selection)
+    uint breeding_population_size, vector<Chromosome> &selection)
 {
+    uint size = this->population.size();
+    breeding_population_size = std::min(breeding_population_size, size);
     if (breeding_population_size == 0)
         return;
 
@@ -162,39 +262,31 @@ void GeneticAlgorithm::select_breeding_individuals(
 
     sort(this->population.begin(), this->population.end());
 
-    for (uint i = 0; i < this->population.size(); ++i)
+    for (uint i = 0; i < size; ++i)
         population_fitness += this->population[i].get_fitness();
 
-    for (uint i = 0; i < this->population.size(); ++i)
+    double cumulative_probability = 0.0;
+    vector<std::pair<double, uint>> keys;
+    for (uint i = 0; i < size; ++i)
     {
         assert(this->population[i].get_fitness() != 0);
         this->population[i].set_selection_probability(
             this->population[i].get_fitness() / population_fitness);
-    }
 
-    double cumulative_probability = 0.0;
-    for (uint i = 0; i < this->population.size(); ++i)
-    {
         cumulative_probability += this->population[i].get_selection_probability();
-        population[i].set_cumulative_probability(cumulative_probability);
+        this->population[i].set_cumulative_probability(cumulative_probability);
+
+        // The logarithm of the key, which orders keys in the same way
+        double uniform = 1.0 - this->random.next_double();
+        keys.emplace_back(std::log(uniform) / this->population[i].get_fitness(), i);
     }
 
-    vector<Chromosome> eligible_population = this->population;
-    double random_number = util::random(util::constants::EPSILON, cumulative_probability);
+    std::nth_element(
+        keys.begin(), keys.begin() + breeding_population_size, keys.end(),
+        std::greater<std::pair<double, uint>>());
 
-    uint i = 0;
-    for (; i < eligible_population.size(); ++i)
-    {
-        if (random_number > eligible_population[i].get_cumulative_probability() &&
-            i + 1 < eligible_population.size())
-            continue;
-        else
-            break;
-    }
-    selection.push_back(this->population[i]);
-    eligible_population.erase(eligible_population.begin() + i);
-    select_breeding_individuals(
-        eligible_population, breeding_population_size - 1, selection);
+    for (uint i = 0; i < breeding_population_size; ++i)
+        selection.push_back(this->population[keys[i].second]);
 }
 
 void GeneticAlgorithm::set_actual_fitness()
@@ -8,9 +8,17 @@
   The idea is to think of evaluation functions as members of a population whose
   fitness is measured by having matches between pairs of them (keeping all other
   parts of the chess engine constant, e.g. the search algorithm)
+
+  A run can be checkpointed after every generation to a binary file holding
+  the population, the fittest member, the state of the random number
+  generator and the number of generations done, so that a run which is
+  interrupted can resume from its last generation and reach the same result.
   ==============================================================================*/
 
+#include <string>
+
 #include "Chromosome.hpp"
+#include "util.hpp"
 
 namespace learning
 {
@@ -24,17 +32,23 @@ class GeneticAlgorithm
         FitnessEvaluator *fitness);
 
     static constexpr double SELECTION_PERCENTAGE = 0.65;
+    static const ullong DEFAULT_RANDOM_SEED = 2718281828;
 
     void run();
     void set_seed(Chromosome &seed);
+    void set_random_seed(ullong seed);
     Chromosome get_fittest_member();
 
+    static constexpr const char *DEFAULT_CHECKPOINT_FILE = "training.checkpoint";
+    void set_checkpoint_file(const std::string &file_name);
+    bool save_checkpoint(const std::string &file_name) const;
+    bool load_checkpoint(const std::string &file_name);
+
   private:
     void initialize_population();
     void evaluate_population();
     void select_breeding_individuals(
-        std::vector<Chromosome> &population, uint breeding_population_size,
-        std::vector<Chromosome> &selection);
+        uint breeding_population_size, std::vector<Chromosome> &selection);
 
     void reduce_population(uint size);
     void add_on_population(const std::vector<Chromosome> &elements);
@@ -47,8 +61,12 @@ class GeneticAlgorithm
 
     uint population_size;
     uint iterations_count;
+    uint generation;
+    bool is_resumed;
+    std::string checkpoint_file;
     double mutation_probability;
     FitnessEvaluator *fitness_evaluator;
+    util::Random random;
 
     std::vector<Chromosome> population;
     Chromosome fittest_member;
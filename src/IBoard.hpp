@@ -12,6 +12,7 @@
 #include <string>
 
 #include "BoardTraits.hpp"
+#include "GameTraits.hpp"
 #include "Piece.hpp"
 
 namespace rules
@@ -93,14 +94,23 @@ class IBoard
     virtual void set_castling_privilege(
         Piece::Player player, CastleSide side, bool value) = 0;
 
-    static bool is_inside_board(int row, int col);
-    static bool is_inside_board(uint row, uint col);
-    static bool is_inside_board(uint square);
+    static constexpr bool is_inside_board(int row, int col)
+    {
+        return (row >= 0 && row < (int)BOARD_SIZE) && (col >= 0 && col < (int)BOARD_SIZE);
+    }
+    static constexpr bool is_inside_board(uint row, uint col)
+    {
+        return (row < BOARD_SIZE) && (col < BOARD_SIZE);
+    }
+    static constexpr bool is_inside_board(uint square)
+    {
+        return (square < BOARD_SQUARES_COUNT);
+    }
 
     friend std::ostream &operator<<(std::ostream &out, const IBoard &board);
 };
 
-inline BoardSquare &operator++(BoardSquare &square)
+constexpr BoardSquare &operator++(BoardSquare &square)
 {
     return (square = BoardSquare(square + 1));
 }
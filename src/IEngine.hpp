@@ -3,6 +3,7 @@
 
 #include "SearchStats.hpp"
 #include "util.hpp"
+#include <string>
 #include <vector>
 
 namespace rules
@@ -43,6 +44,9 @@ class IEngine
     virtual GameResult get_best_move(
         int max_depth, rules::IBoard *, rules::Move &best_move) = 0;
 
+    virtual bool save_transposition_table(const std::string &file) const = 0;
+    virtual bool load_transposition_table(const std::string &file) = 0;
+
     SearchStats statistics;
 };
 
@@ -0,0 +1,59 @@
+#include "Instrumentation.hpp"
+
+#include <iomanip>
+#include <sstream>
+
+namespace diagnostics
+{
+namespace
+{
+const char *const SUBSYSTEM_NAMES[] = {
+    "search", "quiescence", "move generation", "make move",
+    "undo move", "evaluation", "transposition table"};
+
+} // anonymous namespace
+
+thread_local Instrumentation::Counters
+    Instrumentation::counters[Instrumentation::SUBSYSTEMS_COUNT];
+thread_local ScopedTimer *Instrumentation::current_timer = nullptr;
+
+/*==============================================================================
+  Start counting again from zero, in the calling thread.
+  ==============================================================================*/
+void Instrumentation::reset()
+{
+    for (Counters &subsystem : Instrumentation::counters)
+        subsystem = Counters{0, 0};
+}
+
+/*==============================================================================
+  Write to OUTPUT the calls, ticks and share of the total ticks of every
+  subsystem, as counted in the calling thread since the last reset. The table
+  is written at once, so that tables of different threads do not interleave.
+  ==============================================================================*/
+void Instrumentation::report(std::ostream &output)
+{
+    ullong total_ticks = 0;
+    for (const Counters &subsystem : Instrumentation::counters)
+        total_ticks += subsystem.ticks;
+
+    std::ostringstream table;
+    table << std::setw(22) << std::left << "subsystem" << std::right << std::setw(12)
+          << "calls" << std::setw(16) << "ticks" << std::setw(9) << "share"
+          << std::setw(12) << "ticks/call" << std::endl;
+
+    for (uint i = 0; i < SUBSYSTEMS_COUNT; ++i)
+    {
+        const Counters &subsystem = Instrumentation::counters[i];
+        double share = total_ticks > 0 ? 100.0 * subsystem.ticks / total_ticks : 0;
+        table << std::setw(22) << std::left << SUBSYSTEM_NAMES[i] << std::right
+              << std::setw(12) << subsystem.calls << std::setw(16) << subsystem.ticks
+              << std::fixed << std::setprecision(1) << std::setw(8) << share << "%"
+              << std::setw(12)
+              << (subsystem.calls > 0 ? subsystem.ticks / subsystem.calls : 0)
+              << std::endl;
+    }
+    output << table.str() << std::flush;
+}
+
+} // namespace diagnostics
@@ -1,6 +1,3 @@
-#include <iostream>
-#include <memory>
-
 #include "BoardTraits.hpp"
 #include "IBoard.hpp"
 #include "King.hpp"
@@ -8,18 +5,6 @@
 
 namespace rules
 {
-const bool King::neighbors_computed = King::compute_neighbors();
-bitboard King::neighbors[BOARD_SQUARES_COUNT];
-
-King::King()
-{
-    compute_moves();
-}
-
-King::~King()
-{
-}
-
 /*=============================================================================
   Get all valid moves from SQUARE in the current BOARD, assumming it is
   PLAYER's turn to move (moves that leave the king in check are also included)
@@ -75,19 +60,22 @@ bitboard
 King::get_potential_moves(uint square, Player /* player */) const
 {
     if (IBoard::is_inside_board(square))
-        return this->moves_from[square];
+        return King::move_table.moves_from[square];
 
     return 0;
 }
 
-void King::compute_moves()
+/*=============================================================================
+  Compute all moves a king can make from every square on the board assuming
+  the board is empty, and the squares at a distance of one or two king moves
+  from every square
+  ============================================================================*/
+constexpr King::MoveTable King::compute_moves()
 {
+    MoveTable table = {};
     int dx[KING_MOVES_COUNT] = {-1, 0, +1, +1, +1, 0, -1, -1};
     int dy[KING_MOVES_COUNT] = {+1, +1, +1, 0, -1, -1, -1, 0};
 
-    for (uint square = 0; square < BOARD_SQUARES_COUNT; square++)
-        this->moves_from[square] = 0;
-
     for (uint row = 0; row < BOARD_SIZE; ++row)
         for (uint col = 0; col < BOARD_SIZE; ++col)
         {
@@ -117,37 +105,31 @@ void King::compute_moves()
                 int x = col + dx[jump];
 
                 if (IBoard::is_inside_board(y, x))
-                    this->moves_from[square] |= (bits::to_bitboard[y * BOARD_SIZE + x]);
+                    table.moves_from[square] |= (bits::to_bitboard[y * BOARD_SIZE + x]);
             }
         }
-}
-
-bitboard King::get_neighbors(uint position)
-{
-    if (IBoard::is_inside_board(position))
-        return neighbors[position];
-    return 0;
-}
-
-bool King::compute_neighbors()
-{
-    std::unique_ptr<Piece> king(new King());
 
     for (uint position = 0; position < BOARD_SQUARES_COUNT; ++position)
     {
-        bitboard neighborhood = king->get_potential_moves(position, Piece::WHITE);
+        bitboard neighborhood = table.moves_from[position];
         bitboard actual_neighbors = neighborhood;
-        int square = bits::msb_position(neighborhood);
 
-        while (neighborhood && square != -1)
-        {
-            actual_neighbors |= king->get_potential_moves(square, Piece::WHITE);
-            neighborhood ^= bits::to_bitboard[square];
-            square = bits::msb_position(neighborhood);
-        }
-        neighbors[position] = actual_neighbors ^ bits::to_bitboard[position];
+        for (uint square = 0; square < BOARD_SQUARES_COUNT; ++square)
+            if (neighborhood & bits::to_bitboard[square])
+                actual_neighbors |= table.moves_from[square];
+
+        table.neighbors[position] = actual_neighbors ^ bits::to_bitboard[position];
     }
-    return true;
+    return table;
+}
+
+constexpr King::MoveTable King::move_table = King::compute_moves();
+
+bitboard King::get_neighbors(uint position)
+{
+    if (IBoard::is_inside_board(position))
+        return King::move_table.neighbors[position];
+    return 0;
 }
 
 } // namespace rules
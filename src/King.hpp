@@ -16,21 +16,21 @@ class IBoard;
 class King : public Piece
 {
   public:
-    King();
-    ~King();
-
     bitboard get_moves(uint square, Player, const IBoard *) const;
     bitboard get_potential_moves(uint square, Player) const;
 
     static bitboard get_neighbors(uint position);
 
   private:
-    void compute_moves();
-    bitboard moves_from[BOARD_SQUARES_COUNT];
-
-    static bitboard neighbors[BOARD_SQUARES_COUNT];
-    static bool compute_neighbors();
-    const static bool neighbors_computed;
+    struct MoveTable
+    {
+        bitboard moves_from[BOARD_SQUARES_COUNT];
+        bitboard neighbors[BOARD_SQUARES_COUNT];
+    };
+
+    // Computed at compile time and shared by all kings
+    static constexpr MoveTable compute_moves();
+    static const MoveTable move_table;
 };
 
 } // namespace rules
@@ -9,15 +9,6 @@
 
 namespace rules
 {
-Knight::Knight()
-{
-    compute_moves();
-}
-
-Knight::~Knight()
-{
-}
-
 /*=============================================================================
   Get all valid moves from SQUARE in the current BOARD, assumming it is
   PLAYER's turn to move (moves that leave the king in check are also included)
@@ -38,7 +29,7 @@ bitboard
 Knight::get_potential_moves(uint square, Player /* player */) const
 {
     if (IBoard::is_inside_board(square))
-        return this->moves_from[square];
+        return Knight::move_table.moves_from[square];
 
     return 0;
 }
@@ -47,14 +38,12 @@ Knight::get_potential_moves(uint square, Player /* player */) const
   Compute all moves a bishop can make from every square on the board assuming
   the board is empty.
   ============================================================================*/
-void Knight::compute_moves()
+constexpr Knight::MoveTable Knight::compute_moves()
 {
+    MoveTable table = {};
     int dx[KNIGHT_MOVES_COUNT] = {+1, +2, +2, +1, -1, -2, -2, -1};
     int dy[KNIGHT_MOVES_COUNT] = {-2, -1, +1, +2, +2, +1, -1, -2};
 
-    for (uint square = 0; square < BOARD_SQUARES_COUNT; ++square)
-        this->moves_from[square] = 0;
-
     for (uint row = 0; row < BOARD_SIZE; ++row)
         for (uint col = 0; col < BOARD_SIZE; ++col)
         {
@@ -80,9 +69,12 @@ void Knight::compute_moves()
                 int y = row + dy[jump];
                 int x = col + dx[jump];
                 if (IBoard::is_inside_board(y, x))
-                    this->moves_from[square] |= (bits::to_bitboard[y * BOARD_SIZE + x]);
+                    table.moves_from[square] |= (bits::to_bitboard[y * BOARD_SIZE + x]);
             }
         }
+    return table;
 }
 
+constexpr Knight::MoveTable Knight::move_table = Knight::compute_moves();
+
 } // namespace rules
@@ -16,16 +16,18 @@ class IBoard;
 class Knight : public Piece
 {
   public:
-    Knight();
-    ~Knight();
-
     bitboard get_moves(uint square, Player, const IBoard *) const;
     bitboard get_potential_moves(uint square, Player) const;
 
   private:
-    void compute_moves();
-
-    bitboard moves_from[BOARD_SQUARES_COUNT];
+    struct MoveTable
+    {
+        bitboard moves_from[BOARD_SQUARES_COUNT];
+    };
+
+    // Computed at compile time and shared by all knights
+    static constexpr MoveTable compute_moves();
+    static const MoveTable move_table;
 };
 
 } // namespace rules
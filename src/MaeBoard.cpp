@@ -1,38 +1,58 @@
 #include "MaeBoard.hpp"
 #include "Bishop.hpp"
+#include "FenReader.hpp"
+#include "FenWriter.hpp"
 #include "GameReader.hpp"
+#include "Instrumentation.hpp"
 #include "King.hpp"
 #include "Knight.hpp"
 #include "Pawn.hpp"
 #include "Queen.hpp"
+#include "PgnWriter.hpp"
 #include "Rook.hpp"
+#include "SanNotation.hpp"
 #include "bitboard.hpp"
 #include "util.hpp"
 
+#include <fstream>
+
 namespace rules
 {
+using serialization::FenReader;
+using serialization::FenWriter;
 using serialization::GameReader;
+using serialization::PgnGame;
+using serialization::PgnWriter;
+using serialization::SanNotation;
 using std::string;
 
 const Square MaeBoard::EMPTY_SQUARE = {Piece::NULL_PLAYER, Piece::NULL_PIECE};
+const char *const MaeBoard::START_POSITION_FILE = "initial.in";
 
 /*=============================================================================
-  Build a new board as specified in the file initial.in
+  Build a new board in the start position (see MaeBoard::reset)
   ===========================================================================*/
 MaeBoard::MaeBoard()
 {
-    load_zobrist();
     load_support_data();
     reset();
 }
 
+/*=============================================================================
+  Build a new board with no pieces on it
+  ===========================================================================*/
+MaeBoard::MaeBoard(EmptyBoard)
+{
+    load_support_data();
+    clear();
+}
+
 /*=============================================================================
   Build a new board as specified in the file FILE_NAME (see initial.in for an
   example of the format used in load files)
   =============================================================================*/
 MaeBoard::MaeBoard(const string &file)
 {
-    load_zobrist();
     load_support_data();
     clear();
 
@@ -42,47 +62,70 @@ MaeBoard::MaeBoard(const string &file)
 
 MaeBoard::~MaeBoard()
 {
-    for (Piece::Type piece = Piece::PAWN; piece <= Piece::KING; ++piece)
-        delete this->chessmen[piece];
-
     this->position_counter.reset();
     while (!this->game_history.empty())
         this->game_history.pop();
 }
 
 /*=============================================================================
-  Create random 64-bit integers to help maintain the hash key for THIS board
+  Return a new board in the same position as THIS one, with the same history
+  of moves, so that moves can be taken back and repetitions detected on it as
+  on THIS board
+  =============================================================================*/
+std::unique_ptr<MaeBoard> MaeBoard::clone() const
+{
+    return std::unique_ptr<MaeBoard>(new MaeBoard(*this));
+}
+
+/*=============================================================================
+  Make THIS board a copy of OTHER, position and history of moves included.
+  Nothing is computed or read from disk, and the memory THIS board already
+  holds is reused where possible, which makes it cheap to reset the boards of
+  worker threads to a common position.
+  =============================================================================*/
+void MaeBoard::copy_from(const MaeBoard &other)
+{
+    *this = other;
+}
+
+/*=============================================================================
+  Create random 64-bit integers to help maintain the hash key of every board
 
   Things to consider include pieces, castling privileges, turn and en_passant
   capture possibility. A hash lock is also used to avoid collisions in the
   hash table that serves as dictionary of board configurations in the Search
   module.
+
+  The numbers come from a fixed seed, so hash keys are the same in every run
+  and on every platform.
   =============================================================================*/
-void MaeBoard::load_zobrist()
+constexpr MaeBoard::ZobristKeys MaeBoard::compute_zobrist()
 {
-    srand(RANDOM_SEED);
+    ZobristKeys keys = {};
+    ullong state = ZOBRIST_SEED;
 
     for (uint i = 0; i < Piece::PIECES_COUNT; ++i)
         for (uint j = 0; j < PLAYERS_COUNT; ++j)
             for (uint k = 0; k < BOARD_SQUARES_COUNT; ++k)
                 for (uint m = 0; m < HASH_KEYS_COUNT; ++m)
-                    this->zobrist[i][j][k][m] = util::random_ullong();
+                    keys.piece[i][j][k][m] = util::splitmix64(state);
 
-    this->turn_key = util::random_ullong();
-    this->castle_key[Piece::WHITE][KING_SIDE] = util::random_ullong();
-    this->castle_key[Piece::WHITE][QUEEN_SIDE] = util::random_ullong();
-    this->castle_key[Piece::BLACK][KING_SIDE] = util::random_ullong();
-    this->castle_key[Piece::BLACK][QUEEN_SIDE] = util::random_ullong();
+    keys.turn = util::splitmix64(state);
+    keys.castle[Piece::WHITE][KING_SIDE] = util::splitmix64(state);
+    keys.castle[Piece::WHITE][QUEEN_SIDE] = util::splitmix64(state);
+    keys.castle[Piece::BLACK][KING_SIDE] = util::splitmix64(state);
+    keys.castle[Piece::BLACK][QUEEN_SIDE] = util::splitmix64(state);
 
     // This is a waste of memory, since only 16 squares can be possible
     // en-passant capture squares, but this avoids dealing with awful offsets
     for (uint i = 0; i < BOARD_SQUARES_COUNT; ++i)
-        this->en_passant_key[i] = util::random_ullong();
+        keys.en_passant[i] = util::splitmix64(state);
 
-    this->hash_key = 0;
-    this->hash_lock = 0;
+    return keys;
 }
 
+constexpr MaeBoard::ZobristKeys MaeBoard::zobrist = MaeBoard::compute_zobrist();
+
 /*============================================================================
   Remove all the pieces from the board and reset game status, en-passant
   capture possibilities, current turn, castling privileges, etc.
@@ -126,14 +169,29 @@ void MaeBoard::clear()
   Set board to start a new game: put pieces in their initial positions, reset
   castling privileges, en-passant capture possibilities, and current turn.
 
-  Precondition: there exists a file initial.in in the current directory with
-  a valid initial chess configuration.
+  The start position is the one in the file initial.in, if there is such a
+  file in the current directory, or else the standard one. Either is loaded
+  only once, and copied from then on.
   ===========================================================================*/
 void MaeBoard::reset()
 {
-    clear();
-    if (!load_game("initial.in"))
-        clear();
+    copy_from(get_start_position());
+}
+
+const MaeBoard &MaeBoard::get_start_position()
+{
+    static const std::unique_ptr<MaeBoard> start_position = load_start_position();
+    return *start_position;
+}
+
+std::unique_ptr<MaeBoard> MaeBoard::load_start_position()
+{
+    std::unique_ptr<MaeBoard> board(new MaeBoard(EMPTY_BOARD));
+
+    if (!board->load_game(START_POSITION_FILE))
+        FenReader(FenReader::START_POSITION, board.get()).load_position();
+
+    return board;
 }
 
 /*=============================================================================
@@ -151,12 +209,48 @@ bool MaeBoard::load_game(const string &file)
 }
 
 /*=============================================================================
-  Return TRUE if the current game was successfully saved to FILENAME.
+  Return TRUE if the current game was successfully saved to FILENAME, in PGN.
+  The game is taken back to its first position, written as a FEN tag unless
+  it is the standard start position, and replayed to write its moves in SAN.
   ===========================================================================*/
 bool MaeBoard::save_game(const string &filename)
 {
-    // NOT YET IMPLEMENTED
-    return filename.size() > 0;
+    std::unique_ptr<MaeBoard> board = clone();
+    std::vector<Move> moves;
+    while (!board->game_history.empty())
+    {
+        moves.push_back(board->game_history.top().move);
+        if (!board->undo_move())
+            return false;
+    }
+
+    PgnGame game;
+    string fen = FenWriter::write(*board);
+    if (fen != FenReader::START_POSITION)
+    {
+        game.set_tag("SetUp", "1");
+        game.set_tag("FEN", fen);
+    }
+
+    for (auto move = moves.rbegin(); move != moves.rend(); ++move)
+    {
+        game.moves.push_back(SanNotation::to_san(board.get(), *move));
+        board->make_move(*move, /* is_computer_move: */ true);
+    }
+
+    std::vector<Move> legal_moves;
+    SanNotation::get_legal_moves(board.get(), legal_moves);
+    if (legal_moves.empty() && !board->is_king_in_check())
+        game.result = "1/2-1/2";
+    else if (legal_moves.empty())
+        game.result = (board->current_player() == Piece::WHITE ? "0-1" : "1-0");
+
+    std::ofstream output(filename);
+    if (!output.good())
+        return false;
+
+    PgnWriter(output).write(game);
+    return output.good();
 }
 
 /*=============================================================================
@@ -187,8 +281,8 @@ bool MaeBoard::add_piece(BoardSquare square, Piece::Type type, Piece::Player pla
     this->board[square].player = player;
     this->board[square].piece = type;
 
-    this->hash_key ^= zobrist[type][player][square][0];
-    this->hash_lock ^= zobrist[type][player][square][1];
+    this->hash_key ^= MaeBoard::zobrist.piece[type][player][square][0];
+    this->hash_lock ^= MaeBoard::zobrist.piece[type][player][square][1];
 
     return true;
 }
@@ -225,8 +319,8 @@ bool MaeBoard::remove_piece(BoardSquare square)
 
     this->board[square] = EMPTY_SQUARE;
 
-    this->hash_key ^= this->zobrist[piece][player][square][0];
-    this->hash_lock ^= this->zobrist[piece][player][square][1];
+    this->hash_key ^= MaeBoard::zobrist.piece[piece][player][square][0];
+    this->hash_lock ^= MaeBoard::zobrist.piece[piece][player][square][1];
 
     return true;
 }
@@ -241,6 +335,7 @@ bool MaeBoard::remove_piece(BoardSquare square)
   ===========================================================================*/
 MaeBoard::Error MaeBoard::make_move(Move &move, bool is_computer_move)
 {
+    PAWN_TIME_SCOPE(MAKE_MOVE);
     Error move_error;
 
     if (this->board[move.from()] == EMPTY_SQUARE)
@@ -334,6 +429,7 @@ MaeBoard::Error MaeBoard::make_move(Move &move, bool is_computer_move)
   ===========================================================================*/
 bool MaeBoard::undo_move()
 {
+    PAWN_TIME_SCOPE(UNDO_MOVE);
     if (this->game_history.empty())
         return false;
 
@@ -516,7 +612,7 @@ bitboard MaeBoard::attacks_to(BoardSquare location, bool include_king) const
 {
     bitboard attackers = 0;
     bitboard pawn_attacks;
-    Pawn *pawn = (Pawn *)this->chessmen[Piece::PAWN];
+    const Pawn *pawn = (const Pawn *)this->chessmen[Piece::PAWN];
     Piece::Type last_piece = (include_king ? Piece::KING : Piece::QUEEN);
 
     // Put a piece of TYPE in LOCATION and compute all its pseudo-moves.
@@ -544,7 +640,7 @@ bitboard MaeBoard::threats_to(BoardSquare location, Piece::Type type) const
 {
     bitboard attackers = 0;
     bitboard pawn_attackers;
-    Pawn *pawn = (Pawn *)this->chessmen[Piece::PAWN];
+    const Pawn *pawn = (const Pawn *)this->chessmen[Piece::PAWN];
 
     for (Piece::Type attacked = type; attacked > Piece::PAWN; --attacked)
     {
@@ -586,22 +682,22 @@ void MaeBoard::handle_en_passant_move(const Move &move)
         if (this->en_passant_capture_square)
         {
             int square = bits::msb_position(this->en_passant_capture_square);
-            this->hash_key ^= this->en_passant_key[square];
-            this->hash_lock ^= this->en_passant_key[square];
+            this->hash_key ^= MaeBoard::zobrist.en_passant[square];
+            this->hash_lock ^= MaeBoard::zobrist.en_passant[square];
         }
         this->en_passant_capture_square = 0;
         return;
     }
 
-    Pawn *pawn = (Pawn *)this->chessmen[Piece::PAWN];
+    const Pawn *pawn = (const Pawn *)this->chessmen[Piece::PAWN];
     int start = (int)move.from();
     int end = (int)move.to();
 
     if (this->en_passant_capture_square)
     {
         int square = bits::msb_position(this->en_passant_capture_square);
-        hash_key ^= this->en_passant_key[square];
-        hash_lock ^= this->en_passant_key[square];
+        hash_key ^= MaeBoard::zobrist.en_passant[square];
+        hash_lock ^= MaeBoard::zobrist.en_passant[square];
     }
     this->en_passant_capture_square = 0;
 
@@ -616,8 +712,8 @@ void MaeBoard::handle_en_passant_move(const Move &move)
 
         this->en_passant_capture_square = bits::to_bitboard[row + size];
         int square = bits::msb_position(this->en_passant_capture_square);
-        this->hash_key ^= this->en_passant_key[square];
-        this->hash_lock ^= this->en_passant_key[square];
+        this->hash_key ^= MaeBoard::zobrist.en_passant[square];
+        this->hash_lock ^= MaeBoard::zobrist.en_passant[square];
     }
 }
 
@@ -651,11 +747,11 @@ void MaeBoard::handle_castling_privileges(const Move &move)
         this->can_do_castle[player][QUEEN_SIDE] = false;
 
         // Update hash key and hash lock
-        this->hash_key ^= castle_key[player][KING_SIDE];
-        this->hash_key ^= castle_key[player][QUEEN_SIDE];
+        this->hash_key ^= MaeBoard::zobrist.castle[player][KING_SIDE];
+        this->hash_key ^= MaeBoard::zobrist.castle[player][QUEEN_SIDE];
 
-        this->hash_lock ^= castle_key[player][KING_SIDE];
-        this->hash_lock ^= castle_key[player][QUEEN_SIDE];
+        this->hash_lock ^= MaeBoard::zobrist.castle[player][KING_SIDE];
+        this->hash_lock ^= MaeBoard::zobrist.castle[player][QUEEN_SIDE];
     }
     // If anything moves from or to any of the board corners, castling is lost.
     else if (start == this->corner[player][KING_SIDE])
@@ -663,8 +759,8 @@ void MaeBoard::handle_castling_privileges(const Move &move)
         if (this->can_do_castle[player][KING_SIDE])
         {
             // Update hash key and hash lock
-            this->hash_key ^= castle_key[player][KING_SIDE];
-            this->hash_lock ^= castle_key[player][KING_SIDE];
+            this->hash_key ^= MaeBoard::zobrist.castle[player][KING_SIDE];
+            this->hash_lock ^= MaeBoard::zobrist.castle[player][KING_SIDE];
         }
         this->can_do_castle[player][KING_SIDE] = false;
     }
@@ -673,8 +769,8 @@ void MaeBoard::handle_castling_privileges(const Move &move)
         if (this->can_do_castle[player][QUEEN_SIDE])
         {
             // Update hash key and hash lock
-            this->hash_key ^= this->castle_key[player][QUEEN_SIDE];
-            this->hash_lock ^= this->castle_key[player][QUEEN_SIDE];
+            this->hash_key ^= MaeBoard::zobrist.castle[player][QUEEN_SIDE];
+            this->hash_lock ^= MaeBoard::zobrist.castle[player][QUEEN_SIDE];
         }
         this->can_do_castle[player][QUEEN_SIDE] = false;
     }
@@ -683,8 +779,8 @@ void MaeBoard::handle_castling_privileges(const Move &move)
         if (this->can_do_castle[opponent][QUEEN_SIDE])
         {
             // Update hash key and hash lock
-            this->hash_key ^= this->castle_key[opponent][KING_SIDE];
-            this->hash_lock ^= this->castle_key[opponent][KING_SIDE];
+            this->hash_key ^= MaeBoard::zobrist.castle[opponent][KING_SIDE];
+            this->hash_lock ^= MaeBoard::zobrist.castle[opponent][KING_SIDE];
         }
         this->can_do_castle[opponent][KING_SIDE] = false;
     }
@@ -693,8 +789,8 @@ void MaeBoard::handle_castling_privileges(const Move &move)
         if (this->can_do_castle[opponent][QUEEN_SIDE])
         {
             // Update hash key and hash lock
-            this->hash_key ^= this->castle_key[opponent][QUEEN_SIDE];
-            this->hash_lock ^= this->castle_key[opponent][QUEEN_SIDE];
+            this->hash_key ^= MaeBoard::zobrist.castle[opponent][QUEEN_SIDE];
+            this->hash_lock ^= MaeBoard::zobrist.castle[opponent][QUEEN_SIDE];
         }
         this->can_do_castle[opponent][QUEEN_SIDE] = false;
     }
@@ -716,17 +812,26 @@ void MaeBoard::handle_promotion_move(const Move &move)
 }
 
 /*=============================================================================
-  Create instances of Piece (Knight, Bishop, Queen, etc.) to aid in move
-  generation and checking whether moves are valid.
+  Point to the instances of Piece (Knight, Bishop, Queen, etc.) that aid in
+  move generation and checking whether moves are valid. Pieces have no state
+  of their own (their move tables are computed at compile time), so all boards
+  share the same ones.
   ===========================================================================*/
 void MaeBoard::load_chessmen()
 {
-    this->chessmen[Piece::ROOK] = new Rook();
-    this->chessmen[Piece::KNIGHT] = new Knight();
-    this->chessmen[Piece::BISHOP] = new Bishop();
-    this->chessmen[Piece::QUEEN] = new Queen();
-    this->chessmen[Piece::KING] = new King();
-    this->chessmen[Piece::PAWN] = new Pawn();
+    static const Rook rook;
+    static const Knight knight;
+    static const Bishop bishop;
+    static const Queen queen;
+    static const King king;
+    static const Pawn pawn;
+
+    this->chessmen[Piece::ROOK] = &rook;
+    this->chessmen[Piece::KNIGHT] = &knight;
+    this->chessmen[Piece::BISHOP] = &bishop;
+    this->chessmen[Piece::QUEEN] = &queen;
+    this->chessmen[Piece::KING] = &king;
+    this->chessmen[Piece::PAWN] = &pawn;
 }
 
 /*=============================================================================
@@ -779,8 +884,8 @@ void MaeBoard::change_turn()
     this->player = (this->opponent == Piece::WHITE ? Piece::BLACK : Piece::WHITE);
 
     // Update hash keys to reflect the turn
-    this->hash_key ^= this->turn_key;
-    this->hash_lock ^= this->turn_key;
+    this->hash_key ^= MaeBoard::zobrist.turn;
+    this->hash_lock ^= MaeBoard::zobrist.turn;
 }
 
 /*=============================================================================
@@ -792,71 +897,6 @@ bitboard MaeBoard::get_moves(Piece::Type piece, BoardSquare square) const
     return this->chessmen[piece]->get_moves(square, this->player, this);
 }
 
-bitboard MaeBoard::get_all_pieces() const
-{
-    return this->all_pieces;
-}
-
-bitboard MaeBoard::get_pieces(Piece::Player player) const
-{
-    return this->pieces[player];
-}
-
-bitboard MaeBoard::get_pieces(Piece::Player player, Piece::Type piece) const
-{
-    return this->piece[player][piece];
-}
-
-ullong MaeBoard::get_hash_key() const
-{
-    return this->hash_key;
-}
-
-ullong MaeBoard::get_hash_lock() const
-{
-    return this->hash_lock;
-}
-
-bool MaeBoard::is_en_passant_on() const
-{
-    return this->en_passant_capture_square != 0;
-}
-
-bool MaeBoard::can_castle(Piece::Player player, CastleSide side) const
-{
-    return this->can_do_castle[player][side];
-}
-
-bool MaeBoard::is_castled(Piece::Player player, CastleSide side) const
-{
-    return this->is_castled_[player][side];
-}
-
-bitboard MaeBoard::get_en_passant_square() const
-{
-    return this->en_passant_capture_square;
-}
-
-BoardSquare MaeBoard::get_initial_king_square(Piece::Player player) const
-{
-    return this->original_king_position[player];
-}
-
-Piece::Player MaeBoard::get_piece_color(BoardSquare square) const
-{
-    return this->board[square].player;
-}
-
-Piece::Player MaeBoard::current_player() const
-{
-    return this->player;
-}
-
-Piece::Type MaeBoard::get_piece(BoardSquare square) const
-{
-    return this->board[square].piece;
-}
-
 uint MaeBoard::get_move_number() const
 {
     uint game_moves = this->game_history.size();
@@ -885,20 +925,31 @@ void MaeBoard::set_game_status(GameStatus status)
 
 void MaeBoard::set_en_passant_capture_square(BoardSquare en_passant_capture_square)
 {
+    // Keep the hash key consistent with what handle_en_passant_move expects
+    if (this->en_passant_capture_square)
+    {
+        int square = bits::msb_position(this->en_passant_capture_square);
+        this->hash_key ^= MaeBoard::zobrist.en_passant[square];
+        this->hash_lock ^= MaeBoard::zobrist.en_passant[square];
+    }
     this->en_passant_capture_square = bits::to_bitboard[en_passant_capture_square];
+    this->hash_key ^= MaeBoard::zobrist.en_passant[en_passant_capture_square];
+    this->hash_lock ^= MaeBoard::zobrist.en_passant[en_passant_capture_square];
 }
 
 void MaeBoard::set_player_in_turn(Piece::Player player)
 {
+    bool was_whites_turn = this->is_whites_turn;
     this->is_whites_turn = (player == Piece::WHITE ? true : false);
     this->player = player;
     this->opponent = (this->player == Piece::WHITE ? Piece::BLACK : Piece::WHITE);
 
-    // a hash key for the turn is added to the board key when it's black's turn
-    if (!this->is_whites_turn)
+    // a hash key for the turn is in the board key while it's black's turn, so
+    // it is toggled whenever the turn changes
+    if (this->is_whites_turn != was_whites_turn)
     {
-        this->hash_key ^= this->turn_key;
-        this->hash_lock ^= this->turn_key;
+        this->hash_key ^= MaeBoard::zobrist.turn;
+        this->hash_lock ^= MaeBoard::zobrist.turn;
     }
 }
 
@@ -910,8 +961,8 @@ void MaeBoard::set_castling_privilege(Piece::Player player, CastleSide side, boo
     if (this->can_do_castle[player][side] == false)
     {
         // Update hash key and hash lock
-        this->hash_key ^= this->castle_key[player][side];
-        this->hash_lock ^= this->castle_key[player][side];
+        this->hash_key ^= MaeBoard::zobrist.castle[player][side];
+        this->hash_lock ^= MaeBoard::zobrist.castle[player][side];
     }
 }
 
@@ -6,13 +6,14 @@
 #include "GameTraits.hpp"
 #include "IBoard.hpp"
 #include "Square.hpp"
+#include <memory>
 #include <stack>
 
 namespace rules
 {
 using std::string;
 
-class MaeBoard : public IBoard
+class MaeBoard final : public IBoard
 {
   public:
     MaeBoard();
@@ -22,6 +23,9 @@ class MaeBoard : public IBoard
     void clear();
     void reset();
 
+    std::unique_ptr<MaeBoard> clone() const;
+    void copy_from(const MaeBoard &other);
+
     bool load_game(const string &file);
     bool save_game(const string &file);
 
@@ -65,15 +69,43 @@ class MaeBoard : public IBoard
     void set_player_in_turn(Piece::Player);
     void set_castling_privilege(Piece::Player, CastleSide, bool value);
 
+    // Seed of the random numbers that make up hash keys, which tells whether
+    // keys saved by another build of the program mean the same boards
+    static const ullong ZOBRIST_SEED = 8;
+
   private:
-    // Do not allow users of this class to make copies
-    MaeBoard(const MaeBoard &);
+    // Copies are only made explicitly, through clone and copy_from
+    MaeBoard(const MaeBoard &) = default;
+    MaeBoard &operator=(const MaeBoard &) = default;
+
+    enum EmptyBoard
+    {
+        EMPTY_BOARD
+    };
+    explicit MaeBoard(EmptyBoard);
+
+    static const MaeBoard &get_start_position();
+    static std::unique_ptr<MaeBoard> load_start_position();
 
     static const uint CASTLE_SIDES_COUNT = 2;
-    static const uint RANDOM_SEED = 8;
     static const uint HASH_KEYS_COUNT = 2;
+    static const char *const START_POSITION_FILE;
     static const Square EMPTY_SQUARE;
 
+    // Random numbers that make up the hash key (and lock) of a board
+    struct ZobristKeys
+    {
+        ullong piece[PIECE_KINDS_COUNT][PLAYERS_COUNT][BOARD_SQUARES_COUNT]
+                    [HASH_KEYS_COUNT];
+        ullong turn;
+        ullong castle[PLAYERS_COUNT][CASTLE_SIDES_COUNT];
+        ullong en_passant[BOARD_SQUARES_COUNT];
+    };
+
+    // Computed at compile time and shared by all boards
+    static constexpr ZobristKeys compute_zobrist();
+    static const ZobristKeys zobrist;
+
     // Basic board representation
     bitboard piece[PLAYERS_COUNT][PIECE_KINDS_COUNT];
     bitboard pieces[PLAYERS_COUNT];
@@ -81,13 +113,8 @@ class MaeBoard : public IBoard
     Square board[BOARD_SQUARES_COUNT];
 
     // Hash key information
-    ullong zobrist[PIECE_KINDS_COUNT][PLAYERS_COUNT][BOARD_SQUARES_COUNT]
-                  [HASH_KEYS_COUNT];
     ullong hash_key;
     ullong hash_lock;
-    ullong turn_key;
-    ullong castle_key[PLAYERS_COUNT][CASTLE_SIDES_COUNT];
-    ullong en_passant_key[BOARD_SQUARES_COUNT];
 
     // Special moves information
     bool can_do_castle[PLAYERS_COUNT][CASTLE_SIDES_COUNT];
@@ -108,7 +135,7 @@ class MaeBoard : public IBoard
     uint fifty_move_counter;
 
     std::stack<BoardConfiguration> game_history;
-    Piece *chessmen[PIECE_KINDS_COUNT];
+    const Piece *chessmen[PIECE_KINDS_COUNT];
 
     bitboard eighth_rank[PLAYERS_COUNT];
     BoardSquare corner[PLAYERS_COUNT][CASTLE_SIDES_COUNT];
@@ -122,12 +149,80 @@ class MaeBoard : public IBoard
 
     void load_chessmen();
     void load_support_data();
-    void load_zobrist();
 
     void save_restore_information(const Move &);
     void change_turn();
 };
 
+/*==============================================================================
+  Accessors are defined here so that code working on a MaeBoard directly
+  (rather than through IBoard) can have them inlined
+  ==============================================================================*/
+inline bitboard MaeBoard::get_all_pieces() const
+{
+    return this->all_pieces;
+}
+
+inline bitboard MaeBoard::get_pieces(Piece::Player player) const
+{
+    return this->pieces[player];
+}
+
+inline bitboard MaeBoard::get_pieces(Piece::Player player, Piece::Type piece) const
+{
+    return this->piece[player][piece];
+}
+
+inline ullong MaeBoard::get_hash_key() const
+{
+    return this->hash_key;
+}
+
+inline ullong MaeBoard::get_hash_lock() const
+{
+    return this->hash_lock;
+}
+
+inline bool MaeBoard::is_en_passant_on() const
+{
+    return this->en_passant_capture_square != 0;
+}
+
+inline bool MaeBoard::can_castle(Piece::Player player, CastleSide side) const
+{
+    return this->can_do_castle[player][side];
+}
+
+inline bool MaeBoard::is_castled(Piece::Player player, CastleSide side) const
+{
+    return this->is_castled_[player][side];
+}
+
+inline bitboard MaeBoard::get_en_passant_square() const
+{
+    return this->en_passant_capture_square;
+}
+
+inline BoardSquare MaeBoard::get_initial_king_square(Piece::Player player) const
+{
+    return this->original_king_position[player];
+}
+
+inline Piece::Player MaeBoard::get_piece_color(BoardSquare square) const
+{
+    return this->board[square].player;
+}
+
+inline Piece::Player MaeBoard::current_player() const
+{
+    return this->player;
+}
+
+inline Piece::Type MaeBoard::get_piece(BoardSquare square) const
+{
+    return this->board[square].piece;
+}
+
 } // namespace rules
 
 #endif // MAE_BOARD_H
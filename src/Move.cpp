@@ -68,6 +68,19 @@ bool Move::is_null() const
     return this->_type == NULL_MOVE;
 }
 
+/*=============================================================================
+  Return the coordinate notation of THIS move (e.g. e2e4), which is the inverse
+  of the notation accepted by the constructor
+  ============================================================================*/
+string Move::to_notation() const
+{
+    string initial, final;
+    translate_to_notation(this->start, initial);
+    translate_to_notation(this->end, final);
+
+    return initial + final;
+}
+
 /*=============================================================================
   Output information regarding MOVE to the stream OUT
   ============================================================================*/
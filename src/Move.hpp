@@ -43,6 +43,7 @@ class Move
     int score() const;
 
     bool is_null() const;
+    std::string to_notation() const;
 
     friend std::ostream &operator<<(std::ostream &out, const Move &move);
 
@@ -1,5 +1,7 @@
 #include "MoveGenerator.hpp"
 #include "IBoard.hpp"
+#include "Instrumentation.hpp"
+#include "MaeBoard.hpp"
 #include "Move.hpp"
 #include "PositionEvaluator.hpp"
 #include "bitboard.hpp"
@@ -24,8 +26,10 @@ using bits::msb_position;
   the list, sorted by the Most-Valuable-Victim Least-Valuable-Attacker
   ratio.
   ==========================================================================*/
-bool MoveGenerator::generate_moves(IBoard *board, vector<Move> &moves)
+template <class Board>
+bool MoveGenerator::generate_moves(Board *board, vector<Move> &moves)
 {
+    PAWN_TIME_SCOPE(MOVE_GENERATION);
     PositionEvaluator position_evaluator;
     vector<Move> captures;
     bitboard pieces;
@@ -57,7 +61,11 @@ bool MoveGenerator::generate_moves(IBoard *board, vector<Move> &moves)
                 if (move_type == Move::NORMAL_CAPTURE ||
                     move_type == Move::EN_PASSANT_CAPTURE)
                 {
-                    move.set_captured_piece(board->get_piece(current_move));
+                    // The pawn captured en passant is not on the target square
+                    move.set_captured_piece(
+                        move_type == Move::EN_PASSANT_CAPTURE
+                            ? Piece::PAWN
+                            : board->get_piece(current_move));
                     double score =
                         position_evaluator.get_piece_value(move.moving_piece());
                     score /= position_evaluator.get_piece_value(move.captured_piece());
@@ -84,9 +92,11 @@ bool MoveGenerator::generate_moves(IBoard *board, vector<Move> &moves)
   Generate pseudo legal moves of the kinds contained in FLAGS, as opposed
   to simply generating all moves.
   ==========================================================================*/
+template <class Board>
 bool MoveGenerator::generate_moves(
-    IBoard *board, vector<Move> &moves, ushort kind_of_moves)
+    Board *board, vector<Move> &moves, ushort kind_of_moves)
 {
+    PAWN_TIME_SCOPE(MOVE_GENERATION);
     PositionEvaluator evaluator;
 
     vector<Move> promotions;
@@ -123,7 +133,11 @@ bool MoveGenerator::generate_moves(
                 if (move_type == Move::NORMAL_CAPTURE ||
                     move_type == Move::EN_PASSANT_CAPTURE)
                 {
-                    move.set_captured_piece(board->get_piece(current_move));
+                    // The pawn captured en passant is not on the target square
+                    move.set_captured_piece(
+                        move_type == Move::EN_PASSANT_CAPTURE
+                            ? Piece::PAWN
+                            : board->get_piece(current_move));
 
                     if (kind_of_moves & MoveGenerator::CAPTURES)
                     {
@@ -194,8 +208,10 @@ bool MoveGenerator::generate_moves(
     return moves.size() != 0;
 }
 
-bool MoveGenerator::generate_en_prise_evations(IBoard *board, vector<Move> &moves)
+template <class Board>
+bool MoveGenerator::generate_en_prise_evations(Board *board, vector<Move> &moves)
 {
+    PAWN_TIME_SCOPE(MOVE_GENERATION);
     Piece::Player player = board->current_player();
 
     bitboard pieces = board->get_pieces(player);
@@ -236,4 +252,25 @@ bool MoveGenerator::generate_en_prise_evations(IBoard *board, vector<Move> &move
     return moves.size() != 0;
 }
 
+bool MoveGenerator::generate_moves(IBoard *board, vector<Move> &moves)
+{
+    return generate_moves<IBoard>(board, moves);
+}
+
+bool MoveGenerator::generate_moves(
+    IBoard *board, vector<Move> &moves, ushort kind_of_moves)
+{
+    return generate_moves<IBoard>(board, moves, kind_of_moves);
+}
+
+bool MoveGenerator::generate_en_prise_evations(IBoard *board, vector<Move> &moves)
+{
+    return generate_en_prise_evations<IBoard>(board, moves);
+}
+
+using rules::MaeBoard;
+template bool MoveGenerator::generate_moves(MaeBoard *, vector<Move> &);
+template bool MoveGenerator::generate_moves(MaeBoard *, vector<Move> &, ushort);
+template bool MoveGenerator::generate_en_prise_evations(MaeBoard *, vector<Move> &);
+
 } // namespace engine
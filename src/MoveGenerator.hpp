@@ -7,7 +7,12 @@ namespace engine
 {
 using std::vector;
 
-class MoveGenerator : public IMoveGenerator
+/*==============================================================================
+  The virtual functions work on any IBoard; the search calls the templates
+  instead, with the concrete board type, so that board accessors are inlined.
+  Both are instantiated for IBoard and MaeBoard in MoveGenerator.cpp.
+  ==============================================================================*/
+class MoveGenerator final : public IMoveGenerator
 {
   public:
     /*======================================================================
@@ -18,6 +23,13 @@ class MoveGenerator : public IMoveGenerator
     bool generate_moves(rules::IBoard *, vector<rules::Move> &moves);
     bool generate_en_prise_evations(rules::IBoard *, vector<rules::Move> &moves);
 
+    template <class Board>
+    bool generate_moves(Board *, vector<rules::Move> &moves, ushort kind_of_moves);
+    template <class Board>
+    bool generate_moves(Board *, vector<rules::Move> &moves);
+    template <class Board>
+    bool generate_en_prise_evations(Board *, vector<rules::Move> &moves);
+
     ~MoveGenerator()
     {
     }
@@ -0,0 +1,559 @@
+#include "OpeningBook.hpp"
+#include "IBoard.hpp"
+#include "Move.hpp"
+#include "bitboard.hpp"
+#include "util.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace engine
+{
+using bits::bitboard;
+using rules::BoardSquare;
+using rules::IBoard;
+using rules::Move;
+using rules::Piece;
+using std::vector;
+
+namespace
+{
+const uint CASTLE_KEYS_OFFSET = 768;
+const uint EN_PASSANT_KEYS_OFFSET = 772;
+const uint TURN_KEY_OFFSET = 780;
+const uint RANDOM_KEYS_COUNT = 781;
+const uint QUEEN_PROMOTION = 4;
+
+// Polyglot's Random64 table
+const ullong RANDOM_KEYS[RANDOM_KEYS_COUNT] = {
+    // Pieces, from the black pawn on a1 to the white king on h8
+    0x9D39247E33776D41uLL, 0x2AF7398005AAA5C7uLL, 0x44DB015024623547uLL,
+    0x9C15F73E62A76AE2uLL, 0x75834465489C0C89uLL, 0x3290AC3A203001BFuLL,
+    0x0FBBAD1F61042279uLL, 0xE83A908FF2FB60CAuLL, 0x0D7E765D58755C10uLL,
+    0x1A083822CEAFE02DuLL, 0x9605D5F0E25EC3B0uLL, 0xD021FF5CD13A2ED5uLL,
+    0x40BDF15D4A672E32uLL, 0x011355146FD56395uLL, 0x5DB4832046F3D9E5uLL,
+    0x239F8B2D7FF719CCuLL, 0x05D1A1AE85B49AA1uLL, 0x679F848F6E8FC971uLL,
+    0x7449BBFF801FED0BuLL, 0x7D11CDB1C3B7ADF0uLL, 0x82C7709E781EB7CCuLL,
+    0xF3218F1C9510786CuLL, 0x331478F3AF51BBE6uLL, 0x4BB38DE5E7219443uLL,
+    0xAA649C6EBCFD50FCuLL, 0x8DBD98A352AFD40BuLL, 0x87D2074B81D79217uLL,
+    0x19F3C751D3E92AE1uLL, 0xB4AB30F062B19ABFuLL, 0x7B0500AC42047AC4uLL,
+    0xC9452CA81A09D85DuLL, 0x24AA6C514DA27500uLL, 0x4C9F34427501B447uLL,
+    0x14A68FD73C910841uLL, 0xA71B9B83461CBD93uLL, 0x03488B95B0F1850FuLL,
+    0x637B2B34FF93C040uLL, 0x09D1BC9A3DD90A94uLL, 0x3575668334A1DD3BuLL,
+    0x735E2B97A4C45A23uLL, 0x18727070F1BD400BuLL, 0x1FCBACD259BF02E7uLL,
+    0xD310A7C2CE9B6555uLL, 0xBF983FE0FE5D8244uLL, 0x9F74D14F7454A824uLL,
+    0x51EBDC4AB9BA3035uLL, 0x5C82C505DB9AB0FAuLL, 0xFCF7FE8A3430B241uLL,
+    0x3253A729B9BA3DDEuLL, 0x8C74C368081B3075uLL, 0xB9BC6C87167C33E7uLL,
+    0x7EF48F2B83024E20uLL, 0x11D505D4C351BD7FuLL, 0x6568FCA92C76A243uLL,
+    0x4DE0B0F40F32A7B8uLL, 0x96D693460CC37E5DuLL, 0x42E240CB63689F2FuLL,
+    0x6D2BDCDAE2919661uLL, 0x42880B0236E4D951uLL, 0x5F0F4A5898171BB6uLL,
+    0x39F890F579F92F88uLL, 0x93C5B5F47356388BuLL, 0x63DC359D8D231B78uLL,
+    0xEC16CA8AEA98AD76uLL, 0x5355F900C2A82DC7uLL, 0x07FB9F855A997142uLL,
+    0x5093417AA8A7ED5EuLL, 0x7BCBC38DA25A7F3CuLL, 0x19FC8A768CF4B6D4uLL,
+    0x637A7780DECFC0D9uLL, 0x8249A47AEE0E41F7uLL, 0x79AD695501E7D1E8uLL,
+    0x14ACBAF4777D5776uLL, 0xF145B6BECCDEA195uLL, 0xDABF2AC8201752FCuLL,
+    0x24C3C94DF9C8D3F6uLL, 0xBB6E2924F03912EAuLL, 0x0CE26C0B95C980D9uLL,
+    0xA49CD132BFBF7CC4uLL, 0xE99D662AF4243939uLL, 0x27E6AD7891165C3FuLL,
+    0x8535F040B9744FF1uLL, 0x54B3F4FA5F40D873uLL, 0x72B12C32127FED2BuLL,
+    0xEE954D3C7B411F47uLL, 0x9A85AC909A24EAA1uLL, 0x70AC4CD9F04F21F5uLL,
+    0xF9B89D3E99A075C2uLL, 0x87B3E2B2B5C907B1uLL, 0xA366E5B8C54F48B8uLL,
+    0xAE4A9346CC3F7CF2uLL, 0x1920C04D47267BBDuLL, 0x87BF02C6B49E2AE9uLL,
+    0x092237AC237F3859uLL, 0xFF07F64EF8ED14D0uLL, 0x8DE8DCA9F03CC54EuLL,
+    0x9C1633264DB49C89uLL, 0xB3F22C3D0B0B38EDuLL, 0x390E5FB44D01144BuLL,
+    0x5BFEA5B4712768E9uLL, 0x1E1032911FA78984uLL, 0x9A74ACB964E78CB3uLL,
+    0x4F80F7A035DAFB04uLL, 0x6304D09A0B3738C4uLL, 0x2171E64683023A08uLL,
+    0x5B9B63EB9CEFF80CuLL, 0x506AACF489889342uLL, 0x1881AFC9A3A701D6uLL,
+    0x6503080440750644uLL, 0xDFD395339CDBF4A7uLL, 0xEF927DBCF00C20F2uLL,
+    0x7B32F7D1E03680ECuLL, 0xB9FD7620E7316243uLL, 0x05A7E8A57DB91B77uLL,
+    0xB5889C6E15630A75uLL, 0x4A750A09CE9573F7uLL, 0xCF464CEC899A2F8AuLL,
+    0xF538639CE705B824uLL, 0x3C79A0FF5580EF7FuLL, 0xEDE6C87F8477609DuLL,
+    0x799E81F05BC93F31uLL, 0x86536B8CF3428A8CuLL, 0x97D7374C60087B73uLL,
+    0xA246637CFF328532uLL, 0x043FCAE60CC0EBA0uLL, 0x920E449535DD359EuLL,
+    0x70EB093B15B290CCuLL, 0x73A1921916591CBDuLL, 0x56436C9FE1A1AA8DuLL,
+    0xEFAC4B70633B8F81uLL, 0xBB215798D45DF7AFuLL, 0x45F20042F24F1768uLL,
+    0x930F80F4E8EB7462uLL, 0xFF6712FFCFD75EA1uLL, 0xAE623FD67468AA70uLL,
+    0xDD2C5BC84BC8D8FCuLL, 0x7EED120D54CF2DD9uLL, 0x22FE545401165F1CuLL,
+    0xC91800E98FB99929uLL, 0x808BD68E6AC10365uLL, 0xDEC468145B7605F6uLL,
+    0x1BEDE3A3AEF53302uLL, 0x43539603D6C55602uLL, 0xAA969B5C691CCB7AuLL,
+    0xA87832D392EFEE56uLL, 0x65942C7B3C7E11AEuLL, 0xDED2D633CAD004F6uLL,
+    0x21F08570F420E565uLL, 0xB415938D7DA94E3CuLL, 0x91B859E59ECB6350uLL,
+    0x10CFF333E0ED804AuLL, 0x28AED140BE0BB7DDuLL, 0xC5CC1D89724FA456uLL,
+    0x5648F680F11A2741uLL, 0x2D255069F0B7DAB3uLL, 0x9BC5A38EF729ABD4uLL,
+    0xEF2F054308F6A2BCuLL, 0xAF2042F5CC5C2858uLL, 0x480412BAB7F5BE2AuLL,
+    0xAEF3AF4A563DFE43uLL, 0x19AFE59AE451497FuLL, 0x52593803DFF1E840uLL,
+    0xF4F076E65F2CE6F0uLL, 0x11379625747D5AF3uLL, 0xBCE5D2248682C115uLL,
+    0x9DA4243DE836994FuLL, 0x066F70B33FE09017uLL, 0x4DC4DE189B671A1CuLL,
+    0x51039AB7712457C3uLL, 0xC07A3F80C31FB4B4uLL, 0xB46EE9C5E64A6E7CuLL,
+    0xB3819A42ABE61C87uLL, 0x21A007933A522A20uLL, 0x2DF16F761598AA4FuLL,
+    0x763C4A1371B368FDuLL, 0xF793C46702E086A0uLL, 0xD7288E012AEB8D31uLL,
+    0xDE336A2A4BC1C44BuLL, 0x0BF692B38D079F23uLL, 0x2C604A7A177326B3uLL,
+    0x4850E73E03EB6064uLL, 0xCFC447F1E53C8E1BuLL, 0xB05CA3F564268D99uLL,
+    0x9AE182C8BC9474E8uLL, 0xA4FC4BD4FC5558CAuLL, 0xE755178D58FC4E76uLL,
+    0x69B97DB1A4C03DFEuLL, 0xF9B5B7C4ACC67C96uLL, 0xFC6A82D64B8655FBuLL,
+    0x9C684CB6C4D24417uLL, 0x8EC97D2917456ED0uLL, 0x6703DF9D2924E97EuLL,
+    0xC547F57E42A7444EuLL, 0x78E37644E7CAD29EuLL, 0xFE9A44E9362F05FAuLL,
+    0x08BD35CC38336615uLL, 0x9315E5EB3A129ACEuLL, 0x94061B871E04DF75uLL,
+    0xDF1D9F9D784BA010uLL, 0x3BBA57B68871B59DuLL, 0xD2B7ADEEDED1F73FuLL,
+    0xF7A255D83BC373F8uLL, 0xD7F4F2448C0CEB81uLL, 0xD95BE88CD210FFA7uLL,
+    0x336F52F8FF4728E7uLL, 0xA74049DAC312AC71uLL, 0xA2F61BB6E437FDB5uLL,
+    0x4F2A5CB07F6A35B3uLL, 0x87D380BDA5BF7859uLL, 0x16B9F7E06C453A21uLL,
+    0x7BA2484C8A0FD54EuLL, 0xF3A678CAD9A2E38CuLL, 0x39B0BF7DDE437BA2uLL,
+    0xFCAF55C1BF8A4424uLL, 0x18FCF680573FA594uLL, 0x4C0563B89F495AC3uLL,
+    0x40E087931A00930DuLL, 0x8CFFA9412EB642C1uLL, 0x68CA39053261169FuLL,
+    0x7A1EE967D27579E2uLL, 0x9D1D60E5076F5B6FuLL, 0x3810E399B6F65BA2uLL,
+    0x32095B6D4AB5F9B1uLL, 0x35CAB62109DD038AuLL, 0xA90B24499FCFAFB1uLL,
+    0x77A225A07CC2C6BDuLL, 0x513E5E634C70E331uLL, 0x4361C0CA3F692F12uLL,
+    0xD941ACA44B20A45BuLL, 0x528F7C8602C5807BuLL, 0x52AB92BEB9613989uLL,
+    0x9D1DFA2EFC557F73uLL, 0x722FF175F572C348uLL, 0x1D1260A51107FE97uLL,
+    0x7A249A57EC0C9BA2uLL, 0x04208FE9E8F7F2D6uLL, 0x5A110C6058B920A0uLL,
+    0x0CD9A497658A5698uLL, 0x56FD23C8F9715A4CuLL, 0x284C847B9D887AAEuLL,
+    0x04FEABFBBDB619CBuLL, 0x742E1E651C60BA83uLL, 0x9A9632E65904AD3CuLL,
+    0x881B82A13B51B9E2uLL, 0x506E6744CD974924uLL, 0xB0183DB56FFC6A79uLL,
+    0x0ED9B915C66ED37EuLL, 0x5E11E86D5873D484uLL, 0xF678647E3519AC6EuLL,
+    0x1B85D488D0F20CC5uLL, 0xDAB9FE6525D89021uLL, 0x0D151D86ADB73615uLL,
+    0xA865A54EDCC0F019uLL, 0x93C42566AEF98FFBuLL, 0x99E7AFEABE000731uLL,
+    0x48CBFF086DDF285AuLL, 0x7F9B6AF1EBF78BAFuLL, 0x58627E1A149BBA21uLL,
+    0x2CD16E2ABD791E33uLL, 0xD363EFF5F0977996uLL, 0x0CE2A38C344A6EEDuLL,
+    0x1A804AADB9CFA741uLL, 0x907F30421D78C5DEuLL, 0x501F65EDB3034D07uLL,
+    0x37624AE5A48FA6E9uLL, 0x957BAF61700CFF4EuLL, 0x3A6C27934E31188AuLL,
+    0xD49503536ABCA345uLL, 0x088E049589C432E0uLL, 0xF943AEE7FEBF21B8uLL,
+    0x6C3B8E3E336139D3uLL, 0x364F6FFA464EE52EuLL, 0xD60F6DCEDC314222uLL,
+    0x56963B0DCA418FC0uLL, 0x16F50EDF91E513AFuLL, 0xEF1955914B609F93uLL,
+    0x565601C0364E3228uLL, 0xECB53939887E8175uLL, 0xBAC7A9A18531294BuLL,
+    0xB344C470397BBA52uLL, 0x65D34954DAF3CEBDuLL, 0xB4B81B3FA97511E2uLL,
+    0xB422061193D6F6A7uLL, 0x071582401C38434DuLL, 0x7A13F18BBEDC4FF5uLL,
+    0xBC4097B116C524D2uLL, 0x59B97885E2F2EA28uLL, 0x99170A5DC3115544uLL,
+    0x6F423357E7C6A9F9uLL, 0x325928EE6E6F8794uLL, 0xD0E4366228B03343uLL,
+    0x565C31F7DE89EA27uLL, 0x30F5611484119414uLL, 0xD873DB391292ED4FuLL,
+    0x7BD94E1D8E17DEBCuLL, 0xC7D9F16864A76E94uLL, 0x947AE053EE56E63CuLL,
+    0xC8C93882F9475F5FuLL, 0x3A9BF55BA91F81CAuLL, 0xD9A11FBB3D9808E4uLL,
+    0x0FD22063EDC29FCAuLL, 0xB3F256D8ACA0B0B9uLL, 0xB03031A8B4516E84uLL,
+    0x35DD37D5871448AFuLL, 0xE9F6082B05542E4EuLL, 0xEBFAFA33D7254B59uLL,
+    0x9255ABB50D532280uLL, 0xB9AB4CE57F2D34F3uLL, 0x693501D628297551uLL,
+    0xC62C58F97DD949BFuLL, 0xCD454F8F19C5126AuLL, 0xBBE83F4ECC2BDECBuLL,
+    0xDC842B7E2819E230uLL, 0xBA89142E007503B8uLL, 0xA3BC941D0A5061CBuLL,
+    0xE9F6760E32CD8021uLL, 0x09C7E552BC76492FuLL, 0x852F54934DA55CC9uLL,
+    0x8107FCCF064FCF56uLL, 0x098954D51FFF6580uLL, 0x23B70EDB1955C4BFuLL,
+    0xC330DE426430F69DuLL, 0x4715ED43E8A45C0AuLL, 0xA8D7E4DAB780A08DuLL,
+    0x0572B974F03CE0BBuLL, 0xB57D2E985E1419C7uLL, 0xE8D9ECBE2CF3D73FuLL,
+    0x2FE4B17170E59750uLL, 0x11317BA87905E790uLL, 0x7FBF21EC8A1F45ECuLL,
+    0x1725CABFCB045B00uLL, 0x964E915CD5E2B207uLL, 0x3E2B8BCBF016D66DuLL,
+    0xBE7444E39328A0ACuLL, 0xF85B2B4FBCDE44B7uLL, 0x49353FEA39BA63B1uLL,
+    0x1DD01AAFCD53486AuLL, 0x1FCA8A92FD719F85uLL, 0xFC7C95D827357AFAuLL,
+    0x18A6A990C8B35EBDuLL, 0xCCCB7005C6B9C28DuLL, 0x3BDBB92C43B17F26uLL,
+    0xAA70B5B4F89695A2uLL, 0xE94C39A54A98307FuLL, 0xB7A0B174CFF6F36EuLL,
+    0xD4DBA84729AF48ADuLL, 0x2E18BC1AD9704A68uLL, 0x2DE0966DAF2F8B1CuLL,
+    0xB9C11D5B1E43A07EuLL, 0x64972D68DEE33360uLL, 0x94628D38D0C20584uLL,
+    0xDBC0D2B6AB90A559uLL, 0xD2733C4335C6A72FuLL, 0x7E75D99D94A70F4DuLL,
+    0x6CED1983376FA72BuLL, 0x97FCAACBF030BC24uLL, 0x7B77497B32503B12uLL,
+    0x8547EDDFB81CCB94uLL, 0x79999CDFF70902CBuLL, 0xCFFE1939438E9B24uLL,
+    0x829626E3892D95D7uLL, 0x92FAE24291F2B3F1uLL, 0x63E22C147B9C3403uLL,
+    0xC678B6D860284A1CuLL, 0x5873888850659AE7uLL, 0x0981DCD296A8736DuLL,
+    0x9F65789A6509A440uLL, 0x9FF38FED72E9052FuLL, 0xE479EE5B9930578CuLL,
+    0xE7F28ECD2D49EECDuLL, 0x56C074A581EA17FEuLL, 0x5544F7D774B14AEFuLL,
+    0x7B3F0195FC6F290FuLL, 0x12153635B2C0CF57uLL, 0x7F5126DBBA5E0CA7uLL,
+    0x7A76956C3EAFB413uLL, 0x3D5774A11D31AB39uLL, 0x8A1B083821F40CB4uLL,
+    0x7B4A38E32537DF62uLL, 0x950113646D1D6E03uLL, 0x4DA8979A0041E8A9uLL,
+    0x3BC36E078F7515D7uLL, 0x5D0A12F27AD310D1uLL, 0x7F9D1A2E1EBE1327uLL,
+    0xDA3A361B1C5157B1uLL, 0xDCDD7D20903D0C25uLL, 0x36833336D068F707uLL,
+    0xCE68341F79893389uLL, 0xAB9090168DD05F34uLL, 0x43954B3252DC25E5uLL,
+    0xB438C2B67F98E5E9uLL, 0x10DCD78E3851A492uLL, 0xDBC27AB5447822BFuLL,
+    0x9B3CDB65F82CA382uLL, 0xB67B7896167B4C84uLL, 0xBFCED1B0048EAC50uLL,
+    0xA9119B60369FFEBDuLL, 0x1FFF7AC80904BF45uLL, 0xAC12FB171817EEE7uLL,
+    0xAF08DA9177DDA93DuLL, 0x1B0CAB936E65C744uLL, 0xB559EB1D04E5E932uLL,
+    0xC37B45B3F8D6F2BAuLL, 0xC3A9DC228CAAC9E9uLL, 0xF3B8B6675A6507FFuLL,
+    0x9FC477DE4ED681DAuLL, 0x67378D8ECCEF96CBuLL, 0x6DD856D94D259236uLL,
+    0xA319CE15B0B4DB31uLL, 0x073973751F12DD5EuLL, 0x8A8E849EB32781A5uLL,
+    0xE1925C71285279F5uLL, 0x74C04BF1790C0EFEuLL, 0x4DDA48153C94938AuLL,
+    0x9D266D6A1CC0542CuLL, 0x7440FB816508C4FEuLL, 0x13328503DF48229FuLL,
+    0xD6BF7BAEE43CAC40uLL, 0x4838D65F6EF6748FuLL, 0x1E152328F3318DEAuLL,
+    0x8F8419A348F296BFuLL, 0x72C8834A5957B511uLL, 0xD7A023A73260B45CuLL,
+    0x94EBC8ABCFB56DAEuLL, 0x9FC10D0F989993E0uLL, 0xDE68A2355B93CAE6uLL,
+    0xA44CFE79AE538BBEuLL, 0x9D1D84FCCE371425uLL, 0x51D2B1AB2DDFB636uLL,
+    0x2FD7E4B9E72CD38CuLL, 0x65CA5B96B7552210uLL, 0xDD69A0D8AB3B546DuLL,
+    0x604D51B25FBF70E2uLL, 0x73AA8A564FB7AC9EuLL, 0x1A8C1E992B941148uLL,
+    0xAAC40A2703D9BEA0uLL, 0x764DBEAE7FA4F3A6uLL, 0x1E99B96E70A9BE8BuLL,
+    0x2C5E9DEB57EF4743uLL, 0x3A938FEE32D29981uLL, 0x26E6DB8FFDF5ADFEuLL,
+    0x469356C504EC9F9DuLL, 0xC8763C5B08D1908CuLL, 0x3F6C6AF859D80055uLL,
+    0x7F7CC39420A3A545uLL, 0x9BFB227EBDF4C5CEuLL, 0x89039D79D6FC5C5CuLL,
+    0x8FE88B57305E2AB6uLL, 0xA09E8C8C35AB96DEuLL, 0xFA7E393983325753uLL,
+    0xD6B6D0ECC617C699uLL, 0xDFEA21EA9E7557E3uLL, 0xB67C1FA481680AF8uLL,
+    0xCA1E3785A9E724E5uLL, 0x1CFC8BED0D681639uLL, 0xD18D8549D140CAEAuLL,
+    0x4ED0FE7E9DC91335uLL, 0xE4DBF0634473F5D2uLL, 0x1761F93A44D5AEFEuLL,
+    0x53898E4C3910DA55uLL, 0x734DE8181F6EC39AuLL, 0x2680B122BAA28D97uLL,
+    0x298AF231C85BAFABuLL, 0x7983EED3740847D5uLL, 0x66C1A2A1A60CD889uLL,
+    0x9E17E49642A3E4C1uLL, 0xEDB454E7BADC0805uLL, 0x50B704CAB602C329uLL,
+    0x4CC317FB9CDDD023uLL, 0x66B4835D9EAFEA22uLL, 0x219B97E26FFC81BDuLL,
+    0x261E4E4C0A333A9DuLL, 0x1FE2CCA76517DB90uLL, 0xD7504DFA8816EDBBuLL,
+    0xB9571FA04DC089C8uLL, 0x1DDC0325259B27DEuLL, 0xCF3F4688801EB9AAuLL,
+    0xF4F5D05C10CAB243uLL, 0x38B6525C21A42B0EuLL, 0x36F60E2BA4FA6800uLL,
+    0xEB3593803173E0CEuLL, 0x9C4CD6257C5A3603uLL, 0xAF0C317D32ADAA8AuLL,
+    0x258E5A80C7204C4BuLL, 0x8B889D624D44885DuLL, 0xF4D14597E660F855uLL,
+    0xD4347F66EC8941C3uLL, 0xE699ED85B0DFB40DuLL, 0x2472F6207C2D0484uLL,
+    0xC2A1E7B5B459AEB5uLL, 0xAB4F6451CC1D45ECuLL, 0x63767572AE3D6174uLL,
+    0xA59E0BD101731A28uLL, 0x116D0016CB948F09uLL, 0x2CF9C8CA052F6E9FuLL,
+    0x0B090A7560A968E3uLL, 0xABEEDDB2DDE06FF1uLL, 0x58EFC10B06A2068DuLL,
+    0xC6E57A78FBD986E0uLL, 0x2EAB8CA63CE802D7uLL, 0x14A195640116F336uLL,
+    0x7C0828DD624EC390uLL, 0xD74BBE77E6116AC7uLL, 0x804456AF10F5FB53uLL,
+    0xEBE9EA2ADF4321C7uLL, 0x03219A39EE587A30uLL, 0x49787FEF17AF9924uLL,
+    0xA1E9300CD8520548uLL, 0x5B45E522E4B1B4EFuLL, 0xB49C3B3995091A36uLL,
+    0xD4490AD526F14431uLL, 0x12A8F216AF9418C2uLL, 0x001F837CC7350524uLL,
+    0x1877B51E57A764D5uLL, 0xA2853B80F17F58EEuLL, 0x993E1DE72D36D310uLL,
+    0xB3598080CE64A656uLL, 0x252F59CF0D9F04BBuLL, 0xD23C8E176D113600uLL,
+    0x1BDA0492E7E4586EuLL, 0x21E0BD5026C619BFuLL, 0x3B097ADAF088F94EuLL,
+    0x8D14DEDB30BE846EuLL, 0xF95CFFA23AF5F6F4uLL, 0x3871700761B3F743uLL,
+    0xCA672B91E9E4FA16uLL, 0x64C8E531BFF53B55uLL, 0x241260ED4AD1E87DuLL,
+    0x106C09B972D2E822uLL, 0x7FBA195410E5CA30uLL, 0x7884D9BC6CB569D8uLL,
+    0x0647DFEDCD894A29uLL, 0x63573FF03E224774uLL, 0x4FC8E9560F91B123uLL,
+    0x1DB956E450275779uLL, 0xB8D91274B9E9D4FBuLL, 0xA2EBEE47E2FBFCE1uLL,
+    0xD9F1F30CCD97FB09uLL, 0xEFED53D75FD64E6BuLL, 0x2E6D02C36017F67FuLL,
+    0xA9AA4D20DB084E9BuLL, 0xB64BE8D8B25396C1uLL, 0x70CB6AF7C2D5BCF0uLL,
+    0x98F076A4F7A2322EuLL, 0xBF84470805E69B5FuLL, 0x94C3251F06F90CF3uLL,
+    0x3E003E616A6591E9uLL, 0xB925A6CD0421AFF3uLL, 0x61BDD1307C66E300uLL,
+    0xBF8D5108E27E0D48uLL, 0x240AB57A8B888B20uLL, 0xFC87614BAF287E07uLL,
+    0xEF02CDD06FFDB432uLL, 0xA1082C0466DF6C0AuLL, 0x8215E577001332C8uLL,
+    0xD39BB9C3A48DB6CFuLL, 0x2738259634305C14uLL, 0x61CF4F94C97DF93DuLL,
+    0x1B6BACA2AE4E125BuLL, 0x758F450C88572E0BuLL, 0x959F587D507A8359uLL,
+    0xB063E962E045F54DuLL, 0x60E8ED72C0DFF5D1uLL, 0x7B64978555326F9FuLL,
+    0xFD080D236DA814BAuLL, 0x8C90FD9B083F4558uLL, 0x106F72FE81E2C590uLL,
+    0x7976033A39F7D952uLL, 0xA4EC0132764CA04BuLL, 0x733EA705FAE4FA77uLL,
+    0xB4D8F77BC3E56167uLL, 0x9E21F4F903B33FD9uLL, 0x9D765E419FB69F6DuLL,
+    0xD30C088BA61EA5EFuLL, 0x5D94337FBFAF7F5BuLL, 0x1A4E4822EB4D7A59uLL,
+    0x6FFE73E81B637FB3uLL, 0xDDF957BC36D8B9CAuLL, 0x64D0E29EEA8838B3uLL,
+    0x08DD9BDFD96B9F63uLL, 0x087E79E5A57D1D13uLL, 0xE328E230E3E2B3FBuLL,
+    0x1C2559E30F0946BEuLL, 0x720BF5F26F4D2EAAuLL, 0xB0774D261CC609DBuLL,
+    0x443F64EC5A371195uLL, 0x4112CF68649A260EuLL, 0xD813F2FAB7F5C5CAuLL,
+    0x660D3257380841EEuLL, 0x59AC2C7873F910A3uLL, 0xE846963877671A17uLL,
+    0x93B633ABFA3469F8uLL, 0xC0C0F5A60EF4CDCFuLL, 0xCAF21ECD4377B28CuLL,
+    0x57277707199B8175uLL, 0x506C11B9D90E8B1DuLL, 0xD83CC2687A19255FuLL,
+    0x4A29C6465A314CD1uLL, 0xED2DF21216235097uLL, 0xB5635C95FF7296E2uLL,
+    0x22AF003AB672E811uLL, 0x52E762596BF68235uLL, 0x9AEBA33AC6ECC6B0uLL,
+    0x944F6DE09134DFB6uLL, 0x6C47BEC883A7DE39uLL, 0x6AD047C430A12104uLL,
+    0xA5B1CFDBA0AB4067uLL, 0x7C45D833AFF07862uLL, 0x5092EF950A16DA0BuLL,
+    0x9338E69C052B8E7BuLL, 0x455A4B4CFE30E3F5uLL, 0x6B02E63195AD0CF8uLL,
+    0x6B17B224BAD6BF27uLL, 0xD1E0CCD25BB9C169uLL, 0xDE0C89A556B9AE70uLL,
+    0x50065E535A213CF6uLL, 0x9C1169FA2777B874uLL, 0x78EDEFD694AF1EEDuLL,
+    0x6DC93D9526A50E68uLL, 0xEE97F453F06791EDuLL, 0x32AB0EDB696703D3uLL,
+    0x3A6853C7E70757A7uLL, 0x31865CED6120F37DuLL, 0x67FEF95D92607890uLL,
+    0x1F2B1D1F15F6DC9CuLL, 0xB69E38A8965C6B65uLL, 0xAA9119FF184CCCF4uLL,
+    0xF43C732873F24C13uLL, 0xFB4A3D794A9A80D2uLL, 0x3550C2321FD6109CuLL,
+    0x371F77E76BB8417EuLL, 0x6BFA9AAE5EC05779uLL, 0xCD04F3FF001A4778uLL,
+    0xE3273522064480CAuLL, 0x9F91508BFFCFC14AuLL, 0x049A7F41061A9E60uLL,
+    0xFCB6BE43A9F2FE9BuLL, 0x08DE8A1C7797DA9BuLL, 0x8F9887E6078735A1uLL,
+    0xB5B4071DBFC73A66uLL, 0x230E343DFBA08D33uLL, 0x43ED7F5A0FAE657DuLL,
+    0x3A88A0FBBCB05C63uLL, 0x21874B8B4D2DBC4FuLL, 0x1BDEA12E35F6A8C9uLL,
+    0x53C065C6C8E63528uLL, 0xE34A1D250E7A8D6BuLL, 0xD6B04D3B7651DD7EuLL,
+    0x5E90277E7CB39E2DuLL, 0x2C046F22062DC67DuLL, 0xB10BB459132D0A26uLL,
+    0x3FA9DDFB67E2F199uLL, 0x0E09B88E1914F7AFuLL, 0x10E8B35AF3EEAB37uLL,
+    0x9EEDECA8E272B933uLL, 0xD4C718BC4AE8AE5FuLL, 0x81536D601170FC20uLL,
+    0x91B534F885818A06uLL, 0xEC8177F83F900978uLL, 0x190E714FADA5156EuLL,
+    0xB592BF39B0364963uLL, 0x89C350C893AE7DC1uLL, 0xAC042E70F8B383F2uLL,
+    0xB49B52E587A1EE60uLL, 0xFB152FE3FF26DA89uLL, 0x3E666E6F69AE2C15uLL,
+    0x3B544EBE544C19F9uLL, 0xE805A1E290CF2456uLL, 0x24B33C9D7ED25117uLL,
+    0xE74733427B72F0C1uLL, 0x0A804D18B7097475uLL, 0x57E3306D881EDB4FuLL,
+    0x4AE7D6A36EB5DBCBuLL, 0x2D8D5432157064C8uLL, 0xD1E649DE1E7F268BuLL,
+    0x8A328A1CEDFE552CuLL, 0x07A3AEC79624C7DAuLL, 0x84547DDC3E203C94uLL,
+    0x990A98FD5071D263uLL, 0x1A4FF12616EEFC89uLL, 0xF6F7FD1431714200uLL,
+    0x30C05B1BA332F41CuLL, 0x8D2636B81555A786uLL, 0x46C9FEB55D120902uLL,
+    0xCCEC0A73B49C9921uLL, 0x4E9D2827355FC492uLL, 0x19EBB029435DCB0FuLL,
+    0x4659D2B743848A2CuLL, 0x963EF2C96B33BE31uLL, 0x74F85198B05A2E7DuLL,
+    0x5A0F544DD2B1FB18uLL, 0x03727073C2E134B1uLL, 0xC7F6AA2DE59AEA61uLL,
+    0x352787BAA0D7C22FuLL, 0x9853EAB63B5E0B35uLL, 0xABBDCDD7ED5C0860uLL,
+    0xCF05DAF5AC8D77B0uLL, 0x49CAD48CEBF4A71EuLL, 0x7A4C10EC2158C4A6uLL,
+    0xD9E92AA246BF719EuLL, 0x13AE978D09FE5557uLL, 0x730499AF921549FFuLL,
+    0x4E4B705B92903BA4uLL, 0xFF577222C14F0A3AuLL, 0x55B6344CF97AAFAEuLL,
+    0xB862225B055B6960uLL, 0xCAC09AFBDDD2CDB4uLL, 0xDAF8E9829FE96B5FuLL,
+    0xB5FDFC5D3132C498uLL, 0x310CB380DB6F7503uLL, 0xE87FBB46217A360EuLL,
+    0x2102AE466EBB1148uLL, 0xF8549E1A3AA5E00DuLL, 0x07A69AFDCC42261AuLL,
+    0xC4C118BFE78FEAAEuLL, 0xF9F4892ED96BD438uLL, 0x1AF3DBE25D8F45DAuLL,
+    0xF5B4B0B0D2DEEEB4uLL, 0x962ACEEFA82E1C84uLL, 0x046E3ECAAF453CE9uLL,
+    0xF05D129681949A4CuLL, 0x964781CE734B3C84uLL, 0x9C2ED44081CE5FBDuLL,
+    0x522E23F3925E319EuLL, 0x177E00F9FC32F791uLL, 0x2BC60A63A6F3B3F2uLL,
+    0x222BBFAE61725606uLL, 0x486289DDCC3D6780uLL, 0x7DC7785B8EFDFC80uLL,
+    0x8AF38731C02BA980uLL, 0x1FAB64EA29A2DDF7uLL, 0xE4D9429322CD065AuLL,
+    0x9DA058C67844F20CuLL, 0x24C0E332B70019B0uLL, 0x233003B5A6CFE6ADuLL,
+    0xD586BD01C5C217F6uLL, 0x5E5637885F29BC2BuLL, 0x7EBA726D8C94094BuLL,
+    0x0A56A5F0BFE39272uLL, 0xD79476A84EE20D06uLL, 0x9E4C1269BAA4BF37uLL,
+    0x17EFEE45B0DEE640uLL, 0x1D95B0A5FCF90BC6uLL, 0x93CBE0B699C2585DuLL,
+    0x65FA4F227A2B6D79uLL, 0xD5F9E858292504D5uLL, 0xC2B5A03F71471A6FuLL,
+    0x59300222B4561E00uLL, 0xCE2F8642CA0712DCuLL, 0x7CA9723FBB2E8988uLL,
+    0x2785338347F2BA08uLL, 0xC61BB3A141E50E8CuLL, 0x150F361DAB9DEC26uLL,
+    0x9F6A419D382595F4uLL, 0x64A53DC924FE7AC9uLL, 0x142DE49FFF7A7C3DuLL,
+    0x0C335248857FA9E7uLL, 0x0A9C32D5EAE45305uLL, 0xE6C42178C4BBB92EuLL,
+    0x71F1CE2490D20B07uLL, 0xF1BCC3D275AFE51AuLL, 0xE728E8C83C334074uLL,
+    0x96FBF83A12884624uLL, 0x81A1549FD6573DA5uLL, 0x5FA7867CAF35E149uLL,
+    0x56986E2EF3ED091BuLL, 0x917F1DD5F8886C61uLL, 0xD20D8C88C8FFE65FuLL,
+    // Castling rights: white short, white long, black short, black long
+    0x31D71DCE64B2C310uLL, 0xF165B587DF898190uLL, 0xA57E6339DD2CF3A0uLL,
+    0x1EF6E6DBB1961EC9uLL,
+    // Files of the en-passant square
+    0x70CC73D90BC26E24uLL, 0xE21A6B35DF0C3AD7uLL, 0x003A93D8B2806962uLL,
+    0x1C99DED33CB890A1uLL, 0xCF3145DE0ADD4289uLL, 0xD0E4427A5514FB72uLL,
+    0x77C621CC9FB3A483uLL, 0x67A34DAC4356550BuLL,
+    // White to move
+    0xF8D626AAAF278509uLL};
+
+} // anonymous namespace
+
+OpeningBook::OpeningBook()
+{
+    this->data = nullptr;
+    this->data_size = 0;
+}
+
+OpeningBook::~OpeningBook()
+{
+    close();
+}
+
+/*==============================================================================
+  Map the book in FILE to memory, replacing the one open (if any). Return false
+  if the file cannot be mapped or is not a sequence of whole entries.
+  ==============================================================================*/
+bool OpeningBook::open(const std::string &file)
+{
+    close();
+
+    int descriptor = ::open(file.c_str(), O_RDONLY);
+    if (descriptor < 0)
+        return false;
+
+    struct stat status;
+    if (fstat(descriptor, &status) != 0 || status.st_size == 0 ||
+        status.st_size % ENTRY_SIZE != 0)
+    {
+        ::close(descriptor);
+        return false;
+    }
+
+    void *address = mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED, descriptor, 0);
+    ::close(descriptor);
+    if (address == MAP_FAILED)
+        return false;
+
+    // Lookups jump around the file, so reading ahead would be wasted
+    madvise(address, status.st_size, MADV_RANDOM);
+
+    this->data = static_cast<const unsigned char *>(address);
+    this->data_size = status.st_size;
+    return true;
+}
+
+void OpeningBook::close()
+{
+    if (this->data)
+        munmap(const_cast<unsigned char *>(this->data), this->data_size);
+
+    this->data = nullptr;
+    this->data_size = 0;
+}
+
+bool OpeningBook::is_open() const
+{
+    return this->data != nullptr;
+}
+
+/*==============================================================================
+  Return the number of entries in the book
+  ==============================================================================*/
+size_t OpeningBook::size() const
+{
+    return this->data_size / ENTRY_SIZE;
+}
+
+/*==============================================================================
+  Add to MOVES the book moves for the position on BOARD, and their weights to
+  WEIGHTS. Moves this engine cannot play (underpromotions) are left out.
+  ==============================================================================*/
+void OpeningBook::get_moves(
+    const IBoard &board, vector<Move> &moves, vector<uint> &weights) const
+{
+    ullong key = compute_key(board);
+
+    // Find the first entry of the position; entries are sorted by key
+    size_t low = 0, high = size();
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        if (read_big_endian(this->data + middle * ENTRY_SIZE, 8) < key)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    for (size_t i = low; i < size(); ++i)
+    {
+        const unsigned char *entry = this->data + i * ENTRY_SIZE;
+        if (read_big_endian(entry, 8) != key)
+            break;
+
+        Move move;
+        ushort weight = (ushort)read_big_endian(entry + 10, 2);
+        if (weight > 0 && decode_move((ushort)read_big_endian(entry + 8, 2), board, move))
+        {
+            moves.push_back(move);
+            weights.push_back(weight);
+        }
+    }
+}
+
+/*==============================================================================
+  Pick one of the book moves for the position on BOARD at random, with odds
+  proportional to their weights. Return false if the position is not in the
+  book.
+  ==============================================================================*/
+bool OpeningBook::get_move(const IBoard &board, util::Random &random, Move &move) const
+{
+    vector<Move> moves;
+    vector<uint> weights;
+    get_moves(board, moves, weights);
+
+    ullong total_weight = 0;
+    for (uint weight : weights)
+        total_weight += weight;
+
+    if (total_weight == 0)
+        return false;
+
+    ullong choice = random.next_below(total_weight);
+    for (uint i = 0; i < moves.size(); ++i)
+    {
+        if (choice < weights[i])
+        {
+            move = moves[i];
+            return true;
+        }
+        choice -= weights[i];
+    }
+    return false;
+}
+
+/*==============================================================================
+  Return the Polyglot key of the position on BOARD. The en-passant square only
+  counts if a pawn of the side to move stands next to the pawn that can be
+  captured, which is not always the case in positions loaded from FEN.
+  ==============================================================================*/
+ullong OpeningBook::compute_key(const IBoard &board)
+{
+    ullong key = 0;
+
+    for (uint square = BoardSquare::a8; square <= BoardSquare::h1; ++square)
+    {
+        Piece::Type piece = board.get_piece(BoardSquare(square));
+        if (piece == Piece::NULL_PIECE)
+            continue;
+
+        // Black pieces come first: black pawn, white pawn, black knight...
+        bool is_white = board.get_piece_color(BoardSquare(square)) == Piece::WHITE;
+        uint kind = 2 * piece + is_white;
+        key ^= RANDOM_KEYS[64 * kind + to_book_square(BoardSquare(square))];
+    }
+
+    const Piece::Player castle_order[] = {Piece::WHITE, Piece::WHITE, Piece::BLACK,
+                                          Piece::BLACK};
+    const rules::CastleSide side_order[] = {rules::KING_SIDE, rules::QUEEN_SIDE,
+                                            rules::KING_SIDE, rules::QUEEN_SIDE};
+    for (uint i = 0; i < 4; ++i)
+        if (board.can_castle(castle_order[i], side_order[i]))
+            key ^= RANDOM_KEYS[CASTLE_KEYS_OFFSET + i];
+
+    Piece::Player player = board.current_player();
+    if (board.is_en_passant_on())
+    {
+        int target = bits::msb_position(board.get_en_passant_square());
+        int column = target % 8;
+
+        // The capturing pawns stand on the row behind the target square
+        int row = target / 8 + (player == Piece::WHITE ? 1 : -1);
+        bitboard neighbours = 0;
+        if (column > 0)
+            neighbours |= bits::to_bitboard[row * 8 + column - 1];
+        if (column < 7)
+            neighbours |= bits::to_bitboard[row * 8 + column + 1];
+
+        if (neighbours & board.get_pieces(player, Piece::PAWN))
+            key ^= RANDOM_KEYS[EN_PASSANT_KEYS_OFFSET + column];
+    }
+
+    if (player == Piece::WHITE)
+        key ^= RANDOM_KEYS[TURN_KEY_OFFSET];
+
+    return key;
+}
+
+/*==============================================================================
+  Return the Polyglot code of MOVE, to be played on BOARD: the destination, the
+  origin and the promotion piece, three bits for every row and column. Castling
+  moves are written as the king capturing its own rook.
+  ==============================================================================*/
+ushort OpeningBook::encode_move(const Move &move, const IBoard &board)
+{
+    uint from = to_book_square(move.from());
+    uint to = to_book_square(move.to());
+
+    if (board.get_piece(move.from()) == Piece::KING &&
+        move.from() == board.get_initial_king_square(board.current_player()))
+    {
+        if (move.to() == move.from() + 2)
+            to += 1;
+        else if (move.to() == move.from() - 2)
+            to -= 2;
+    }
+
+    // Only promotions to a queen are ever made
+    uint promotion = 0;
+    if (board.get_piece(move.from()) == Piece::PAWN && (to / 8 == 0 || to / 8 == 7))
+        promotion = QUEEN_PROMOTION;
+
+    return (ushort)(to | from << 6 | promotion << 12);
+}
+
+/*==============================================================================
+  Translate the Polyglot move CODE into MOVE for the position on BOARD. Return
+  false if it promotes to something other than a queen.
+  ==============================================================================*/
+bool OpeningBook::decode_move(ushort code, const IBoard &board, Move &move)
+{
+    uint promotion = (code >> 12) & 7;
+    if (promotion != 0 && promotion != QUEEN_PROMOTION)
+        return false;
+
+    BoardSquare from = to_board_square((code >> 6) & 63);
+    BoardSquare to = to_board_square(code & 63);
+
+    Piece::Player player = board.current_player();
+    if (board.get_piece(from) == Piece::KING && board.get_piece(to) == Piece::ROOK &&
+        board.get_piece_color(to) == player)
+    {
+        to = BoardSquare(to > from ? from + 2 : from - 2);
+    }
+
+    move = Move(from, to);
+    return true;
+}
+
+uint OpeningBook::to_book_square(BoardSquare square)
+{
+    return square ^ 56;
+}
+
+BoardSquare OpeningBook::to_board_square(uint square)
+{
+    return BoardSquare(square ^ 56);
+}
+
+/*==============================================================================
+  Return the SIZE-byte number stored at BYTES with its most significant byte
+  first, as all numbers in Polyglot books are
+  ==============================================================================*/
+ullong OpeningBook::read_big_endian(const unsigned char *bytes, uint size)
+{
+    ullong value = 0;
+    for (uint i = 0; i < size; ++i)
+        value = value << 8 | bytes[i];
+    return value;
+}
+
+} // namespace engine
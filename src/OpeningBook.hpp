@@ -0,0 +1,73 @@
+#ifndef OPENING_BOOK_H
+#define OPENING_BOOK_H
+
+/*==============================================================================
+  Reads opening books in the Polyglot format: a file of 16-byte big-endian
+  entries (position key, move, weight and a learning field nobody uses),
+  sorted by key. The file is memory-mapped rather than read, so opening a book
+  costs nothing however big it is, and a lookup is a binary search that only
+  touches the few pages it lands on.
+
+  Books are indexed by Polyglot's own Zobrist keys, not by the hash keys of
+  MaeBoard, so compute_key derives them from the board (only at the root, so
+  this is not worth maintaining incrementally). They are made of Polyglot's
+  table of 781 random numbers, so that books built by other programs match:
+  768 for the pieces, 4 for castling rights, 8 for the file of the en-passant
+  square and 1 for the turn.
+  ==============================================================================*/
+
+#include <string>
+#include <vector>
+
+#include "BoardTraits.hpp"
+#include "type_aliases.hpp"
+
+namespace rules
+{
+class IBoard;
+class Move;
+} // namespace rules
+
+namespace util
+{
+class Random;
+}
+
+namespace engine
+{
+class OpeningBook
+{
+  public:
+    OpeningBook();
+    ~OpeningBook();
+
+    bool open(const std::string &file);
+    void close();
+    bool is_open() const;
+    size_t size() const;
+
+    void get_moves(
+        const rules::IBoard &, std::vector<rules::Move> &moves,
+        std::vector<uint> &weights) const;
+    bool get_move(const rules::IBoard &, util::Random &, rules::Move &move) const;
+
+    static ullong compute_key(const rules::IBoard &);
+    static ushort encode_move(const rules::Move &, const rules::IBoard &);
+    static bool decode_move(ushort code, const rules::IBoard &, rules::Move &move);
+
+    static const uint ENTRY_SIZE = 16;
+
+  private:
+    // The board and books number squares from a8 and a1 respectively
+    static uint to_book_square(rules::BoardSquare);
+    static rules::BoardSquare to_board_square(uint);
+
+    static ullong read_big_endian(const unsigned char *bytes, uint size);
+
+    const unsigned char *data;
+    size_t data_size;
+};
+
+} // namespace engine
+
+#endif // OPENING_BOOK_H
@@ -4,15 +4,6 @@
 
 namespace rules
 {
-Pawn::Pawn()
-{
-    compute_moves();
-}
-
-Pawn::~Pawn()
-{
-}
-
 /*============================================================================
   Return all valid moves from SQUARE in the current BOARD, assuming it is
   PLAYER's turn to move (moves that leave the king in check are also included)
@@ -35,7 +26,7 @@ bitboard Pawn::get_moves(uint square, Player player, const IBoard *board) const
     bitboard west_capture = get_capture_move(square, player, Piece::WEST);
     bitboard captures = east_capture | west_capture;
 
-    bitboard simple_moves = simple_moves_from[square][player];
+    bitboard simple_moves = Pawn::move_table.simple_moves_from[square][player];
     bitboard moves = (captures & opponent_pieces) | (simple_moves & ~all_pieces);
     bitboard double_move = get_double_move(square, player);
 
@@ -70,7 +61,7 @@ bitboard Pawn::get_moves(uint square, Player player, const IBoard *board) const
 bitboard Pawn::get_potential_moves(uint square, Player player) const
 {
     if (IBoard::is_inside_board(square))
-        return this->moves_from[square][player];
+        return Pawn::move_table.moves_from[square][player];
 
     return 0;
 }
@@ -85,7 +76,7 @@ bitboard Pawn::get_capture_move(uint square, Player player, RowColumn direction)
         if (direction == EAST || direction == WEST)
         {
             uint side = (direction == EAST ? 0 : 1);
-            return this->capture_moves_from[square][player][side];
+            return Pawn::move_table.capture_moves_from[square][player][side];
         }
     return 0;
 }
@@ -97,7 +88,7 @@ bitboard Pawn::get_capture_move(uint square, Player player, RowColumn direction)
 bitboard Pawn::get_simple_moves(uint square, Player player) const
 {
     if (IBoard::is_inside_board(square))
-        return this->simple_moves_from[square][player];
+        return Pawn::move_table.simple_moves_from[square][player];
 
     return 0;
 }
@@ -133,7 +124,7 @@ bitboard Pawn::get_double_move(uint square, Player player) const
 bitboard Pawn::get_side_moves(uint square, Player player) const
 {
     if (IBoard::is_inside_board(square))
-        return this->side_moves_from[square][player];
+        return Pawn::move_table.side_moves_from[square][player];
 
     return 0;
 }
@@ -142,8 +133,9 @@ bitboard Pawn::get_side_moves(uint square, Player player) const
   Compute all moves a pawn can make from every square on the board assuming
   the board is empty. Moves are computed for both WHITE and BLACK pawns.
   =============================================================================*/
-void Pawn::compute_moves()
+constexpr Pawn::MoveTable Pawn::compute_moves()
 {
+    MoveTable table = {};
     const int LEFT = 0;
     const int RIGHT = 1;
 
@@ -154,40 +146,40 @@ void Pawn::compute_moves()
 
             for (Player player = WHITE; player <= BLACK; ++player)
             {
-                this->side_moves_from[square][player] =
+                table.side_moves_from[square][player] =
                     compute_side_moves(square, player);
-                this->moves_from[square][player] = 0;
 
-                this->simple_moves_from[square][player] =
+                table.simple_moves_from[square][player] =
                     compute_simple_moves(square, player);
 
-                this->capture_moves_from[square][player][LEFT] =
+                table.capture_moves_from[square][player][LEFT] =
                     compute_capture_move(square, player, EAST);
 
-                this->capture_moves_from[square][player][RIGHT] =
+                table.capture_moves_from[square][player][RIGHT] =
                     compute_capture_move(square, player, WEST);
 
                 // OR simple and capture moves into general moves
-                this->moves_from[square][player] |=
-                    this->simple_moves_from[square][player];
+                table.moves_from[square][player] |=
+                    table.simple_moves_from[square][player];
 
-                this->moves_from[square][player] |=
-                    this->capture_moves_from[square][player][LEFT];
+                table.moves_from[square][player] |=
+                    table.capture_moves_from[square][player][LEFT];
 
-                this->moves_from[square][player] |=
-                    this->capture_moves_from[square][player][RIGHT];
+                table.moves_from[square][player] |=
+                    table.capture_moves_from[square][player][RIGHT];
 
                 // If potential moves include side moves then:
                 // moves_from[square][player] |= side_moves_from[square];
             }
         }
+    return table;
 }
 
 /*=============================================================================
   Compute a single bitboard containing the horizontal adjacent squares to
   SQUARE
   =============================================================================*/
-bitboard Pawn::compute_side_moves(uint square, Player player) const
+constexpr bitboard Pawn::compute_side_moves(uint square, Player player)
 {
     bitboard side_moves = 0;
     int dx[PAWN_MOVES_COUNT - 1] = {-1, +1};
@@ -208,7 +200,8 @@ bitboard Pawn::compute_side_moves(uint square, Player player) const
   Compute a single bitboard containing the capture square in DIRECTION, of a
   pawn on SQUARE, assuming it is PLAYER'S turn to move.
   =============================================================================*/
-bitboard Pawn::compute_capture_move(uint square, Player player, RowColumn direction) const
+constexpr bitboard Pawn::compute_capture_move(
+    uint square, Player player, RowColumn direction)
 {
     if (direction != EAST && direction != WEST)
         return 0;
@@ -234,7 +227,7 @@ bitboard Pawn::compute_capture_move(uint square, Player player, RowColumn direct
   Compute a single bitboard containing non-capture moves for a pawn on SQUARE,
   assumming it is PLAYER's turn to move.
   =============================================================================*/
-bitboard Pawn::compute_simple_moves(uint square, Player player) const
+constexpr bitboard Pawn::compute_simple_moves(uint square, Player player)
 {
     bitboard simple_moves = 0;
     int dy[PAWN_MOVES_COUNT - 1] = {+1, +2};
@@ -259,7 +252,7 @@ bitboard Pawn::compute_simple_moves(uint square, Player player) const
   Return TRUE if ROW is the second row from PLAYER's perpective; return FALSE
   otherwise.
   =============================================================================*/
-bool Pawn::is_second_row(uint row, Player player) const
+constexpr bool Pawn::is_second_row(uint row, Player player)
 {
     if (player == WHITE)
         return row == BOARD_SIZE - 2;
@@ -271,7 +264,7 @@ bool Pawn::is_second_row(uint row, Player player) const
   Return the row corresponding to SQUARE on the chess board.
   Precondition: SQUARE is in [0, BOARD_SQUARES_COUNT)
   =============================================================================*/
-uint Pawn::get_row(uint square) const
+constexpr uint Pawn::get_row(uint square)
 {
     return (square / BOARD_SIZE);
 }
@@ -280,7 +273,7 @@ uint Pawn::get_row(uint square) const
   Return the column corresponding to SQUARE on the chess board.
   Precondition: SQUARE is in [0, BOARD_SQUARES_COUNT)
   =============================================================================*/
-uint Pawn::get_column(uint square) const
+constexpr uint Pawn::get_column(uint square)
 {
     return square % BOARD_SIZE;
 }
@@ -288,7 +281,7 @@ uint Pawn::get_column(uint square) const
 /*=============================================================================
   Return TRUE if a pawn of side COLOR can be on ROW; return FALSE otherwise.
   =============================================================================*/
-bool Pawn::is_valid_row(uint row, Player color) const
+constexpr bool Pawn::is_valid_row(uint row, Player color)
 {
     if (color == WHITE)
         return row != BOARD_SIZE - 1;
@@ -296,4 +289,6 @@ bool Pawn::is_valid_row(uint row, Player color) const
     return row != 0;
 }
 
+constexpr Pawn::MoveTable Pawn::move_table = Pawn::compute_moves();
+
 } // namespace rules
@@ -16,9 +16,6 @@ class IBoard;
 class Pawn : public Piece
 {
   public:
-    Pawn();
-    ~Pawn();
-
     bitboard get_moves(uint square, Player player, const IBoard *board) const;
 
     bitboard get_side_moves(uint square, Player player) const;
@@ -30,23 +27,30 @@ class Pawn : public Piece
   private:
     bitboard get_simple_moves(uint square, Player player) const;
 
-    void compute_moves();
-    bitboard compute_simple_moves(uint square, Player player) const;
-    bitboard compute_side_moves(uint square, Player player) const;
-    bitboard compute_capture_move(uint square, Player player, RowColumn direction) const;
-
-    bool is_second_row(uint row, Player player) const;
-    bool is_valid_row(uint row, Player player) const;
-    uint get_row(uint square) const;
-    uint get_column(uint square) const;
-
-    bitboard moves_from[BOARD_SQUARES_COUNT][PLAYERS_COUNT];
-    bitboard simple_moves_from[BOARD_SQUARES_COUNT][PLAYERS_COUNT];
-    bitboard capture_moves_from[BOARD_SQUARES_COUNT][PLAYERS_COUNT]
-                               [PAWN_CAPTURE_MOVES_COUNT];
-
-    // These are not real moves, but they are useful for en-passant handling
-    bitboard side_moves_from[BOARD_SQUARES_COUNT][PLAYERS_COUNT];
+    struct MoveTable
+    {
+        bitboard moves_from[BOARD_SQUARES_COUNT][PLAYERS_COUNT];
+        bitboard simple_moves_from[BOARD_SQUARES_COUNT][PLAYERS_COUNT];
+        bitboard capture_moves_from[BOARD_SQUARES_COUNT][PLAYERS_COUNT]
+                                   [PAWN_CAPTURE_MOVES_COUNT];
+
+        // These are not real moves, but they are useful for en-passant handling
+        bitboard side_moves_from[BOARD_SQUARES_COUNT][PLAYERS_COUNT];
+    };
+
+    // Computed at compile time and shared by all pawns
+    static constexpr MoveTable compute_moves();
+    static const MoveTable move_table;
+
+    static constexpr bitboard compute_simple_moves(uint square, Player player);
+    static constexpr bitboard compute_side_moves(uint square, Player player);
+    static constexpr bitboard compute_capture_move(
+        uint square, Player player, RowColumn direction);
+
+    static constexpr bool is_second_row(uint row, Player player);
+    static constexpr bool is_valid_row(uint row, Player player);
+    static constexpr uint get_row(uint square);
+    static constexpr uint get_column(uint square);
 };
 
 } // namespace rules
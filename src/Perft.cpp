@@ -0,0 +1,162 @@
+#include "Perft.hpp"
+#include "MaeBoard.hpp"
+#include "MoveGenerator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace engine
+{
+using rules::IBoard;
+using rules::MaeBoard;
+using rules::Move;
+using std::vector;
+
+namespace
+{
+// Spreads the entries of the same board at different depths over the table
+const ullong DEPTH_KEY = 0x9e3779b97f4a7c15ULL;
+
+// Counts of smaller subtrees are cheaper to find again than to look up
+const int MIN_HASHED_DEPTH = 2;
+
+const uint DEPTH_BITS = 8;
+
+} // anonymous namespace
+
+struct Perft::Worker
+{
+    MaeBoard board;
+    MoveGenerator generator;
+
+    // The moves of every ply, so that they are only ever allocated once
+    vector<vector<Move>> moves;
+};
+
+Perft::Perft(uint threads_count, uint hash_size_in_bits)
+{
+    this->threads_count = std::max(threads_count, 1u);
+    this->entries_mask = (1ULL << hash_size_in_bits) - 1;
+
+    // Value-initialized, i.e. empty: depth 0 is never looked up
+    this->entries.reset(new Entry[this->entries_mask + 1]());
+}
+
+Perft::~Perft()
+{
+}
+
+/*==============================================================================
+  Count the leaves DEPTH plies below BOARD, splitting the moves of the root
+  among the threads. The hash table is kept from one run to the next.
+  ==============================================================================*/
+PerftResult Perft::run(const MaeBoard &board, int depth)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    PerftResult result = {};
+    if (depth <= 0)
+    {
+        result.nodes = 1;
+        return result;
+    }
+
+    vector<std::unique_ptr<Worker>> workers;
+    for (uint i = 0; i < this->threads_count; ++i)
+    {
+        workers.emplace_back(new Worker());
+        workers.back()->board.copy_from(board);
+        workers.back()->moves.resize(depth);
+    }
+
+    // The legal moves of the root
+    Worker &first = *workers.front();
+    vector<Move> moves;
+    first.generator.generate_moves(&first.board, moves);
+    for (Move &move : moves)
+        if (first.board.make_move(move, true) != IBoard::KING_LEFT_IN_CHECK)
+        {
+            first.board.undo_move();
+            result.moves.emplace_back(move, 0);
+        }
+
+    std::atomic<size_t> next_move(0);
+    auto work = [&](Worker &worker) {
+        for (size_t i = next_move++; i < result.moves.size(); i = next_move++)
+        {
+            Move move = result.moves[i].first;
+            worker.board.make_move(move, true);
+            result.moves[i].second = count(worker, depth - 1);
+            worker.board.undo_move();
+        }
+    };
+
+    vector<std::thread> threads;
+    for (auto &worker : workers)
+        threads.emplace_back(work, std::ref(*worker));
+    for (auto &thread : threads)
+        thread.join();
+
+    for (auto &move : result.moves)
+        result.nodes += move.second;
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    result.seconds = elapsed.count();
+    return result;
+}
+
+ullong Perft::count(Worker &worker, int depth)
+{
+    if (depth == 0)
+        return 1;
+
+    MaeBoard &board = worker.board;
+    ullong nodes = 0;
+    if (depth >= MIN_HASHED_DEPTH && probe(board, depth, nodes))
+        return nodes;
+
+    vector<Move> &moves = worker.moves[depth - 1];
+    moves.clear();
+    worker.generator.generate_moves(&board, moves);
+
+    for (Move &move : moves)
+    {
+        if (board.make_move(move, true) == IBoard::KING_LEFT_IN_CHECK)
+            continue;
+
+        nodes += depth == 1 ? 1 : count(worker, depth - 1);
+        board.undo_move();
+    }
+
+    if (depth >= MIN_HASHED_DEPTH)
+        store(board, depth, nodes);
+    return nodes;
+}
+
+bool Perft::probe(const MaeBoard &board, int depth, ullong &nodes) const
+{
+    const Entry &entry =
+        this->entries[(board.get_hash_key() ^ depth * DEPTH_KEY) & this->entries_mask];
+    ullong data = entry.data.load(std::memory_order_relaxed);
+    ullong check = entry.check.load(std::memory_order_relaxed);
+
+    if ((check ^ data) != board.get_hash_lock() ||
+        (data & ((1ULL << DEPTH_BITS) - 1)) != (ullong)depth)
+        return false;
+
+    nodes = data >> DEPTH_BITS;
+    return true;
+}
+
+void Perft::store(const MaeBoard &board, int depth, ullong nodes)
+{
+    Entry &entry =
+        this->entries[(board.get_hash_key() ^ depth * DEPTH_KEY) & this->entries_mask];
+    ullong data = nodes << DEPTH_BITS | (ullong)depth;
+
+    entry.check.store(board.get_hash_lock() ^ data, std::memory_order_relaxed);
+    entry.data.store(data, std::memory_order_relaxed);
+}
+
+} // namespace engine
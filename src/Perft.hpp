@@ -0,0 +1,81 @@
+#ifndef PERFT_H
+#define PERFT_H
+
+/*==============================================================================
+  Counts the leaves of the tree of legal moves of a position down to a given
+  depth (perft), which, compared with the counts known for a few positions,
+  tells whether move generation and making and undoing moves are right.
+
+  The moves of the root are dealt to several threads, every thread owning a
+  copy of the board and a move generator; each thread takes the next root
+  move left once it is done with the previous one, so threads stay busy even
+  when subtrees differ much in size.
+
+  Counts of subtrees are kept in a hash table shared by all threads, keyed by
+  the hash key and lock of the board and the depth left, so transpositions are
+  only counted once. Entries are written without locks: every entry stores its
+  count next to the count XOR the hash lock, so an entry torn by two threads
+  writing it at once does not check out, and reads as a miss.
+  ==============================================================================*/
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Move.hpp"
+#include "type_aliases.hpp"
+
+namespace rules
+{
+class MaeBoard;
+}
+
+namespace engine
+{
+struct PerftResult
+{
+    ullong nodes;
+
+    // The leaves under every legal move of the root
+    std::vector<std::pair<rules::Move, ullong>> moves;
+    double seconds;
+};
+
+class Perft
+{
+  public:
+    Perft(uint threads_count, uint hash_size_in_bits);
+    ~Perft();
+
+    PerftResult run(const rules::MaeBoard &, int depth);
+
+    // 2^22 entries of 16 bytes, i.e. 64 MiB
+    static const uint DEFAULT_HASH_SIZE_IN_BITS = 22;
+    static const uint MAX_HASH_SIZE_IN_BITS = 30;
+
+  private:
+    Perft(const Perft &) = delete;
+    Perft &operator=(const Perft &) = delete;
+
+    struct Entry
+    {
+        std::atomic<ullong> check;
+        std::atomic<ullong> data;
+    };
+
+    struct Worker;
+
+    ullong count(Worker &, int depth);
+
+    bool probe(const rules::MaeBoard &, int depth, ullong &nodes) const;
+    void store(const rules::MaeBoard &, int depth, ullong nodes);
+
+    uint threads_count;
+    std::unique_ptr<Entry[]> entries;
+    ullong entries_mask;
+};
+
+} // namespace engine
+
+#endif // PERFT_H
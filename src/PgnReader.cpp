@@ -0,0 +1,246 @@
+#include "PgnReader.hpp"
+#include "FenReader.hpp"
+#include "IBoard.hpp"
+#include "Move.hpp"
+#include "SanNotation.hpp"
+
+#include <cctype>
+#include <cstring>
+
+namespace serialization
+{
+using rules::IBoard;
+using rules::Move;
+using std::string;
+
+static const char *const RESULTS[] = {"1-0", "0-1", "1/2-1/2", "*"};
+
+static bool is_result(const string &token)
+{
+    for (const char *result : RESULTS)
+        if (token == result)
+            return true;
+    return false;
+}
+
+void PgnGame::clear()
+{
+    this->tags.clear();
+    this->moves.clear();
+    this->result.clear();
+}
+
+bool PgnGame::has_tag(const string &name) const
+{
+    for (const auto &tag : this->tags)
+        if (tag.first == name)
+            return true;
+    return false;
+}
+
+string PgnGame::get_tag(const string &name) const
+{
+    for (const auto &tag : this->tags)
+        if (tag.first == name)
+            return tag.second;
+    return "";
+}
+
+void PgnGame::set_tag(const string &name, const string &value)
+{
+    for (auto &tag : this->tags)
+        if (tag.first == name)
+        {
+            tag.second = value;
+            return;
+        }
+    this->tags.emplace_back(name, value);
+}
+
+/*=============================================================================
+  Set BOARD to the start position of THIS game (the one in its FEN tag, or
+  the standard one) and play its moves on it, which are returned in MOVES.
+  Return FALSE if the FEN tag or a move is not valid; BOARD is then left in
+  the position where the game went wrong.
+  =============================================================================*/
+bool PgnGame::play(IBoard *board, std::vector<Move> &moves) const
+{
+    moves.clear();
+
+    string fen = (has_tag("FEN") ? get_tag("FEN") : FenReader::START_POSITION);
+    if (!FenReader(fen, board).load_position())
+        return false;
+
+    for (const string &san : this->moves)
+    {
+        Move move;
+        if (!SanNotation::parse(san, board, move))
+            return false;
+
+        IBoard::Error error = board->make_move(move, /* is_computer_move: */ true);
+        if (error != IBoard::NO_ERROR && error != IBoard::DRAW_BY_REPETITION)
+            return false;
+        moves.push_back(move);
+    }
+    return true;
+}
+
+PgnReader::PgnReader(std::istream &input) : input(input)
+{
+    this->is_in_comment = false;
+    this->variation_depth = 0;
+}
+
+/*=============================================================================
+  Return TRUE if another game could be read into GAME; return FALSE when the
+  input has been exhausted. A game ends with its result or, if that is
+  missing, where the tags of the next game start.
+  =============================================================================*/
+bool PgnReader::next(PgnGame &game)
+{
+    game.clear();
+    this->is_in_comment = false;
+    this->variation_depth = 0;
+
+    bool has_movetext = false;
+    string line;
+
+    while (true)
+    {
+        if (!this->pending_line.empty())
+        {
+            line = this->pending_line;
+            this->pending_line.clear();
+        }
+        else if (!std::getline(this->input, line))
+            break;
+
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+
+        // Lines starting with % are escaped from PGN processing
+        if (line.empty() || line[0] == '%')
+            continue;
+
+        bool is_tag =
+            !this->is_in_comment && this->variation_depth == 0 && line[0] == '[';
+        if (is_tag && has_movetext)
+        {
+            this->pending_line = line;
+            return true;
+        }
+
+        if (is_tag)
+        {
+            read_tag(line, game);
+            continue;
+        }
+
+        has_movetext = true;
+        if (read_movetext(line, game))
+            return true;
+    }
+
+    return !game.tags.empty() || has_movetext;
+}
+
+/*=============================================================================
+  Read a tag pair of the form [Name "Value"] from LINE into GAME. Return FALSE
+  if LINE is not a valid tag pair.
+  =============================================================================*/
+bool PgnReader::read_tag(const string &line, PgnGame &game) const
+{
+    string::size_type name_end = line.find_first_of(" \t\"", 1);
+    string::size_type quote = line.find('"');
+    if (name_end == string::npos || quote == string::npos)
+        return false;
+
+    string name = line.substr(1, name_end - 1);
+    string value;
+    string::size_type i = quote + 1;
+    for (; i < line.size() && line[i] != '"'; ++i)
+    {
+        if (line[i] == '\\' && i + 1 < line.size())
+            ++i;
+        value += line[i];
+    }
+
+    if (name.empty() || i == line.size())
+        return false;
+
+    game.set_tag(name, value);
+    return true;
+}
+
+/*=============================================================================
+  Read the moves in LINE, part of the movetext of a game, into GAME. Return
+  TRUE if the game ended in LINE, with its result.
+  =============================================================================*/
+bool PgnReader::read_movetext(const string &line, PgnGame &game)
+{
+    static const char *const DELIMITERS = " \t{}();";
+
+    for (string::size_type i = 0; i < line.size();)
+    {
+        char c = line[i];
+        if (this->is_in_comment)
+        {
+            this->is_in_comment = (c != '}');
+            ++i;
+        }
+        else if (c == '{')
+        {
+            this->is_in_comment = true;
+            ++i;
+        }
+        else if (c == ';')
+        {
+            // A comment up to the end of the line
+            break;
+        }
+        else if (c == '(' || c == ')')
+        {
+            if (c == '(')
+                this->variation_depth++;
+            else if (this->variation_depth > 0)
+                this->variation_depth--;
+            ++i;
+        }
+        else if (isspace(c))
+        {
+            ++i;
+        }
+        else
+        {
+            string::size_type end = line.find_first_of(DELIMITERS, i);
+            if (end == string::npos)
+                end = line.size();
+            string token = line.substr(i, end - i);
+            i = end;
+
+            if (this->variation_depth > 0 || token[0] == '$')
+                continue;
+
+            if (is_result(token))
+            {
+                game.result = token;
+                return true;
+            }
+
+            // Move numbers (12. or 12...) may be glued to the move that follows
+            string::size_type digits_end = token.find_first_not_of("0123456789");
+            if (digits_end == string::npos)
+                continue;
+
+            string::size_type move_start = 0;
+            if (token[digits_end] == '.')
+                move_start = token.find_first_not_of('.', digits_end);
+
+            if (move_start != string::npos)
+                game.moves.push_back(token.substr(move_start));
+        }
+    }
+    return false;
+}
+
+} // namespace serialization
@@ -0,0 +1,73 @@
+#ifndef PGN_READER_H
+#define PGN_READER_H
+
+/*==============================================================================
+  Reads games in Portable Game Notation (PGN), e.g.
+
+  [Event "Casual game"]
+  [White "Morphy"]
+  [Black "Duke of Brunswick"]
+  [Result "1-0"]
+
+  1. e4 e5 2. Nf3 d6 3. d4 Bg4 {This is a weak move} 4. dxe5 Bxf3 ... 1-0
+
+  Games are read one at a time, so databases of any size can be read with the
+  memory of a single game. Comments, variations, numeric annotation glyphs and
+  move numbers are skipped; moves are kept in SAN, as written, and only
+  checked when the game is played on a board.
+  ==============================================================================*/
+
+#include <istream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace rules
+{
+class IBoard;
+class Move;
+} // namespace rules
+
+namespace serialization
+{
+using std::string;
+
+struct PgnGame
+{
+    // Tags in the order they were read or set
+    std::vector<std::pair<string, string>> tags;
+    std::vector<string> moves;
+    string result;
+
+    void clear();
+    bool has_tag(const string &name) const;
+    string get_tag(const string &name) const;
+    void set_tag(const string &name, const string &value);
+
+    bool play(rules::IBoard *board, std::vector<rules::Move> &moves) const;
+};
+
+class PgnReader
+{
+  public:
+    PgnReader(std::istream &input);
+
+    bool next(PgnGame &game);
+
+  private:
+    bool read_tag(const string &line, PgnGame &game) const;
+    bool read_movetext(const string &line, PgnGame &game);
+
+    std::istream &input;
+
+    // A tag line read past the end of a game without a result
+    string pending_line;
+
+    // Comments in braces and variations may span several lines
+    bool is_in_comment;
+    uint variation_depth;
+};
+
+} // namespace serialization
+
+#endif // PGN_READER_H
@@ -0,0 +1,93 @@
+#include "PgnWriter.hpp"
+
+#include <sstream>
+
+namespace serialization
+{
+using std::string;
+
+static const char *const SEVEN_TAG_ROSTER[] = {"Event", "Site",  "Date",  "Round",
+                                               "White", "Black", "Result"};
+
+PgnWriter::PgnWriter(std::ostream &output) : output(output)
+{
+}
+
+void PgnWriter::write(const PgnGame &game)
+{
+    string result = (game.result.empty() ? "*" : game.result);
+
+    for (const char *name : SEVEN_TAG_ROSTER)
+    {
+        string value = game.get_tag(name);
+        if (string(name) == "Result")
+            value = result;
+        else if (value.empty())
+            value = (string(name) == "Date" ? "????.??.??" : "?");
+        write_tag(name, value);
+    }
+
+    for (const auto &tag : game.tags)
+    {
+        bool is_in_roster = false;
+        for (const char *name : SEVEN_TAG_ROSTER)
+            is_in_roster = is_in_roster || tag.first == name;
+        if (!is_in_roster)
+            write_tag(tag.first, tag.second);
+    }
+    this->output << '\n';
+
+    // The move number and side to move of the first move come from the FEN
+    uint move_number = 1;
+    bool is_whites_turn = true;
+    if (game.has_tag("FEN"))
+    {
+        std::istringstream fen(game.get_tag("FEN"));
+        string placement, turn, castling, en_passant;
+        uint halfmove_clock;
+        fen >> placement >> turn >> castling >> en_passant;
+        is_whites_turn = (turn != "b");
+        if (!(fen >> halfmove_clock >> move_number) || move_number == 0)
+            move_number = 1;
+    }
+
+    string line;
+    auto add_token = [&](const string &token) {
+        if (!line.empty() && line.size() + 1 + token.size() > MAX_LINE_LENGTH)
+        {
+            this->output << line << '\n';
+            line.clear();
+        }
+        line += (line.empty() ? "" : " ") + token;
+    };
+
+    for (uint i = 0; i < game.moves.size(); ++i)
+    {
+        if (is_whites_turn)
+            add_token(std::to_string(move_number) + ". " + game.moves[i]);
+        else if (i == 0)
+            add_token(std::to_string(move_number) + "... " + game.moves[i]);
+        else
+            add_token(game.moves[i]);
+
+        if (!is_whites_turn)
+            move_number++;
+        is_whites_turn = !is_whites_turn;
+    }
+    add_token(result);
+    this->output << line << "\n\n";
+}
+
+void PgnWriter::write_tag(const string &name, const string &value)
+{
+    string escaped;
+    for (char c : value)
+    {
+        if (c == '"' || c == '\\')
+            escaped += '\\';
+        escaped += c;
+    }
+    this->output << '[' << name << " \"" << escaped << "\"]\n";
+}
+
+} // namespace serialization
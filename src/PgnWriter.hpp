@@ -0,0 +1,35 @@
+#ifndef PGN_WRITER_H
+#define PGN_WRITER_H
+
+/*==============================================================================
+  Writes games in Portable Game Notation (PGN), in the export format: the
+  seven tag roster first (with "?" for the tags a game lacks), then the rest
+  of its tags, then its moves numbered and wrapped under 80 columns. Games are
+  written as soon as they are given, so any number of them can be written.
+  ==============================================================================*/
+
+#include <ostream>
+#include <string>
+
+#include "PgnReader.hpp"
+
+namespace serialization
+{
+class PgnWriter
+{
+  public:
+    PgnWriter(std::ostream &output);
+
+    void write(const PgnGame &game);
+
+    static const uint MAX_LINE_LENGTH = 79;
+
+  private:
+    void write_tag(const std::string &name, const std::string &value);
+
+    std::ostream &output;
+};
+
+} // namespace serialization
+
+#endif // PGN_WRITER_H
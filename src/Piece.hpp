@@ -85,7 +85,7 @@ class Piece
     virtual bitboard get_potential_moves(uint square, Player player) const = 0;
 };
 
-inline Piece::Diagonal &operator++(Piece::Diagonal &direction)
+constexpr Piece::Diagonal &operator++(Piece::Diagonal &direction)
 {
     if (direction == Piece::NULL_DIAGONAL)
         return (direction = Piece::NULL_DIAGONAL);
@@ -93,7 +93,7 @@ inline Piece::Diagonal &operator++(Piece::Diagonal &direction)
     return (direction = Piece::Diagonal(direction + 1));
 }
 
-inline Piece::RowColumn &operator++(Piece::RowColumn &direction)
+constexpr Piece::RowColumn &operator++(Piece::RowColumn &direction)
 {
     if (direction == Piece::NULL_LINE)
         return (direction = Piece::NULL_LINE);
@@ -101,7 +101,7 @@ inline Piece::RowColumn &operator++(Piece::RowColumn &direction)
     return (direction = Piece::RowColumn(direction + 1));
 }
 
-inline Piece::Type &operator++(Piece::Type &piece_type)
+constexpr Piece::Type &operator++(Piece::Type &piece_type)
 {
     if (piece_type == Piece::NULL_PIECE)
         return (piece_type = Piece::NULL_PIECE);
@@ -109,7 +109,7 @@ inline Piece::Type &operator++(Piece::Type &piece_type)
     return (piece_type = Piece::Type(piece_type + 1));
 }
 
-inline Piece::Type &operator--(Piece::Type &piece_type)
+constexpr Piece::Type &operator--(Piece::Type &piece_type)
 {
     if (piece_type == Piece::PAWN)
         return (piece_type = Piece::NULL_PIECE);
@@ -117,7 +117,7 @@ inline Piece::Type &operator--(Piece::Type &piece_type)
     return (piece_type = Piece::Type(piece_type - 1));
 }
 
-inline Piece::Player &operator++(Piece::Player &player)
+constexpr Piece::Player &operator++(Piece::Player &player)
 {
     if (player == Piece::NULL_PLAYER)
         return (player = Piece::NULL_PLAYER);
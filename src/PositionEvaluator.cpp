@@ -2,7 +2,9 @@
 #include "BoardTraits.hpp"
 #include "GameTraits.hpp"
 #include "IBoard.hpp"
+#include "Instrumentation.hpp"
 #include "King.hpp"
+#include "MaeBoard.hpp"
 #include "bitboard.hpp"
 #include "util.hpp"
 #include <iostream>
@@ -32,28 +34,71 @@ PositionEvaluator::PositionEvaluator()
     this->factor_weight.push_back(780); // MOBILITY
     this->factor_weight.push_back(916); // CENTER_CONTROL
     this->factor_weight.push_back(22);  // KING_SAFETY
+
+    update_feature_weights();
 }
 
-int PositionEvaluator::static_evaluation(const IBoard *board) const
+template <class Board>
+int PositionEvaluator::static_evaluation(const Board *board) const
 {
-    int material;
-    int mobility;
-    int king_safety = 0;
-    int center_control;
+    PAWN_TIME_SCOPE(EVALUATION);
     int sign = (board->current_player() == Piece::WHITE ? 1 : -1);
+    FeatureVector features;
+
+    extract_features<Board>(board, features);
+    return sign * evaluate_features(features);
+}
+
+template <class Board>
+void PositionEvaluator::extract_features(
+    const Board *board, FeatureVector &features) const
+{
+    bitboard player_piece;
+    bitboard opponent_piece;
 
-    material = evaluate_material(board);
-    mobility = evaluate_mobility(board);
-    center_control = evaluate_center_control(board);
-    king_safety = evaluate_king_safety(board);
+    for (Piece::Type piece = Piece::PAWN; piece <= Piece::QUEEN; ++piece)
+    {
+        player_piece = board->get_pieces(Piece::WHITE, piece);
+        opponent_piece = board->get_pieces(Piece::BLACK, piece);
 
-    return sign *
-           (factor_weight[MATERIAL] * material + factor_weight[MOBILITY] * mobility +
-            factor_weight[CENTER_CONTROL] * center_control +
-            factor_weight[KING_SAFETY] * king_safety);
+        features[PAWN_COUNT + piece] =
+            bits::count_ones(player_piece) - bits::count_ones(opponent_piece);
+        features[PAWN_MOBILITY + piece] =
+            mobility_value(board, player_piece, piece) -
+            mobility_value(board, opponent_piece, piece);
+        features[PAWN_CENTER_CONTROL + piece] =
+            center_control_value(board, player_piece, piece) -
+            center_control_value(board, opponent_piece, piece);
+    }
+    features[KING_SAFETY_VALUE] =
+        king_safety_value(board, Piece::WHITE) - king_safety_value(board, Piece::BLACK);
 }
 
-int PositionEvaluator::evaluate_material(const IBoard *board) const
+/*==============================================================================
+  Extract the features of COUNT BOARDS into FEATURES, e.g. those of a batch of
+  positions to tune the weights on
+  ==============================================================================*/
+template <class Board>
+void PositionEvaluator::extract_features(
+    const Board *const *boards, std::size_t count, FeatureVector *features) const
+{
+    for (std::size_t i = 0; i < count; ++i)
+        extract_features<Board>(boards[i], features[i]);
+}
+
+/*==============================================================================
+  Write to EVALUATIONS the evaluation, from white's point of view, of each one
+  of the COUNT feature vectors in FEATURES
+  ==============================================================================*/
+void PositionEvaluator::evaluate_features(
+    const FeatureVector *features, std::size_t count, int *evaluations) const
+{
+    for (std::size_t i = 0; i < count; ++i)
+        evaluations[i] = evaluate_features(features[i]);
+}
+
+template <class Board>
+int PositionEvaluator::evaluate_material(const Board *board) const
 {
     bitboard player_piece;
     bitboard opponent_piece;
@@ -70,7 +115,8 @@ int PositionEvaluator::evaluate_material(const IBoard *board) const
     return material;
 }
 
-int PositionEvaluator::evaluate_mobility(const IBoard *board) const
+template <class Board>
+int PositionEvaluator::evaluate_mobility(const Board *board) const
 {
     bitboard player_piece;
     bitboard opponent_piece;
@@ -88,7 +134,8 @@ int PositionEvaluator::evaluate_mobility(const IBoard *board) const
     return mobility;
 }
 
-int PositionEvaluator::evaluate_center_control(const IBoard *board) const
+template <class Board>
+int PositionEvaluator::evaluate_center_control(const Board *board) const
 {
     bitboard player_piece;
     bitboard opponent_piece;
@@ -106,7 +153,8 @@ int PositionEvaluator::evaluate_center_control(const IBoard *board) const
     return center_control;
 }
 
-int PositionEvaluator::evaluate_king_safety(const IBoard *board) const
+template <class Board>
+int PositionEvaluator::evaluate_king_safety(const Board *board) const
 {
     return (
         king_safety_value(board, Piece::WHITE) - king_safety_value(board, Piece::BLACK));
@@ -117,8 +165,9 @@ int PositionEvaluator::material_value(bitboard piece, Piece::Type piece_type) co
     return bits::count_ones(piece) * piece_value[piece_type];
 }
 
+template <class Board>
 int PositionEvaluator::mobility_value(
-    const IBoard *board, bitboard piece, Piece::Type piece_type) const
+    const Board *board, bitboard piece, Piece::Type piece_type) const
 {
     bitboard moves = 0;
     uint n_moves = 0;
@@ -138,8 +187,9 @@ int PositionEvaluator::mobility_value(
     return n_moves;
 }
 
+template <class Board>
 int PositionEvaluator::center_control_value(
-    const IBoard *board, bitboard piece, Piece::Type piece_type) const
+    const Board *board, bitboard piece, Piece::Type piece_type) const
 {
     bitboard center = to_bitboard[SQ::d4] | to_bitboard[SQ::e4] | to_bitboard[SQ::e5] |
                       to_bitboard[SQ::d5];
@@ -160,7 +210,8 @@ int PositionEvaluator::center_control_value(
     return squares_controled;
 }
 
-int PositionEvaluator::king_safety_value(const IBoard *board, Piece::Player player) const
+template <class Board>
+int PositionEvaluator::king_safety_value(const Board *board, Piece::Player player) const
 {
     static bitboard pawns[rules::PLAYERS_COUNT][rules::PLAYERS_COUNT] = {
         {to_bitboard[SQ::f2] | to_bitboard[SQ::g2] | to_bitboard[SQ::h2],
@@ -216,11 +267,6 @@ int PositionEvaluator::king_safety_value(const IBoard *board, Piece::Player play
     return safety_value;
 }
 
-int PositionEvaluator::get_piece_value(Piece::Type piece_type) const
-{
-    return this->piece_value[piece_type];
-}
-
 void PositionEvaluator::load_factor_weights(std::vector<int> &weights)
 {
     for (uint i = 0; i < weights.size(); ++i)
@@ -230,6 +276,88 @@ void PositionEvaluator::load_factor_weights(std::vector<int> &weights)
 
         this->factor_weight[i] = weights[i];
     }
+    update_feature_weights();
+}
+
+void PositionEvaluator::load_piece_values(const std::vector<int> &values)
+{
+    for (uint i = 0; i < values.size() && i < Piece::KING; ++i)
+        this->piece_value[i] = values[i];
+    update_feature_weights();
 }
 
+/*==============================================================================
+  Convert EVALUATION to hundredths of the weight of a pawn. Weights that give
+  a pawn no value (e.g. a material weight of 0 out of a genetic algorithm)
+  leave nothing to measure by, so then EVALUATION is returned as it is.
+  ==============================================================================*/
+int PositionEvaluator::to_centipawns(int evaluation) const
+{
+    long long pawn =
+        (long long)this->factor_weight[MATERIAL] * this->piece_value[Piece::PAWN];
+    if (pawn <= 0)
+        return evaluation;
+
+    return (long long)evaluation * 100 / pawn;
+}
+
+// The weight of every feature is that of the factor it contributes to, times
+// the value of the piece for material
+void PositionEvaluator::update_feature_weights()
+{
+    for (Piece::Type piece = Piece::PAWN; piece <= Piece::QUEEN; ++piece)
+    {
+        this->feature_weight[PAWN_COUNT + piece] =
+            this->factor_weight[MATERIAL] * this->piece_value[piece];
+        this->feature_weight[PAWN_MOBILITY + piece] = this->factor_weight[MOBILITY];
+        this->feature_weight[PAWN_CENTER_CONTROL + piece] =
+            this->factor_weight[CENTER_CONTROL];
+    }
+    this->feature_weight[KING_SAFETY_VALUE] = this->factor_weight[KING_SAFETY];
+}
+
+int PositionEvaluator::static_evaluation(const IBoard *board) const
+{
+    return static_evaluation<IBoard>(board);
+}
+
+int PositionEvaluator::evaluate_material(const IBoard *board) const
+{
+    return evaluate_material<IBoard>(board);
+}
+
+int PositionEvaluator::evaluate_mobility(const IBoard *board) const
+{
+    return evaluate_mobility<IBoard>(board);
+}
+
+int PositionEvaluator::evaluate_center_control(const IBoard *board) const
+{
+    return evaluate_center_control<IBoard>(board);
+}
+
+int PositionEvaluator::evaluate_king_safety(const IBoard *board) const
+{
+    return evaluate_king_safety<IBoard>(board);
+}
+
+void PositionEvaluator::extract_features(
+    const IBoard *board, FeatureVector &features) const
+{
+    extract_features<IBoard>(board, features);
+}
+
+using rules::MaeBoard;
+template int PositionEvaluator::static_evaluation(const MaeBoard *) const;
+template int PositionEvaluator::evaluate_material(const MaeBoard *) const;
+template int PositionEvaluator::evaluate_mobility(const MaeBoard *) const;
+template int PositionEvaluator::evaluate_center_control(const MaeBoard *) const;
+template int PositionEvaluator::evaluate_king_safety(const MaeBoard *) const;
+template void PositionEvaluator::extract_features(
+    const MaeBoard *, FeatureVector &features) const;
+template void PositionEvaluator::extract_features(
+    const IBoard *const *, std::size_t, FeatureVector *) const;
+template void PositionEvaluator::extract_features(
+    const MaeBoard *const *, std::size_t, FeatureVector *) const;
+
 } // namespace engine
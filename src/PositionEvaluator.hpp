@@ -3,6 +3,8 @@
 
 #include "IPositionEvaluator.hpp"
 
+#include <array>
+#include <cstddef>
 #include <vector>
 
 namespace rules
@@ -12,9 +14,55 @@ class Piece;
 
 namespace engine
 {
-class PositionEvaluator : public IPositionEvaluator
+/*==============================================================================
+  The virtual functions evaluate any IBoard; the search calls the templates
+  instead, with the concrete board type, so that board accessors are inlined.
+  Both are instantiated for IBoard and MaeBoard in PositionEvaluator.cpp.
+
+  The evaluation is linear in a handful of features of the position (the
+  difference between white's and black's piece counts, mobility and center
+  control for every piece type, and king safety), so a position is evaluated
+  by extracting its features and taking their dot product with one weight per
+  feature, derived from the piece values and factor weights. Features can also
+  be extracted once and evaluated in bulk, e.g. when tuning the weights.
+  ==============================================================================*/
+class PositionEvaluator final : public IPositionEvaluator
 {
   public:
+    enum Factors
+    {
+        MATERIAL,
+        MOBILITY,
+        CENTER_CONTROL,
+        KING_SAFETY,
+        FACTORS_COUNT
+    };
+
+    enum Feature
+    {
+        PAWN_COUNT,
+        KNIGHT_COUNT,
+        BISHOP_COUNT,
+        ROOK_COUNT,
+        QUEEN_COUNT,
+        PAWN_MOBILITY,
+        KNIGHT_MOBILITY,
+        BISHOP_MOBILITY,
+        ROOK_MOBILITY,
+        QUEEN_MOBILITY,
+        PAWN_CENTER_CONTROL,
+        KNIGHT_CENTER_CONTROL,
+        BISHOP_CENTER_CONTROL,
+        ROOK_CENTER_CONTROL,
+        QUEEN_CENTER_CONTROL,
+        KING_SAFETY_VALUE,
+        FEATURES_COUNT
+    };
+
+    // Every feature is white's value minus black's value
+    using FeatureVector = std::array<short, FEATURES_COUNT>;
+    using FeatureWeights = std::array<int, FEATURES_COUNT>;
+
     PositionEvaluator();
     int static_evaluation(const rules::IBoard *) const;
     int evaluate_material(const rules::IBoard *) const;
@@ -22,31 +70,67 @@ class PositionEvaluator : public IPositionEvaluator
     int evaluate_center_control(const rules::IBoard *) const;
     int evaluate_king_safety(const rules::IBoard *) const;
 
-    int get_piece_value(rules::Piece::Type) const;
+    template <class Board> int static_evaluation(const Board *) const;
+    template <class Board> int evaluate_material(const Board *) const;
+    template <class Board> int evaluate_mobility(const Board *) const;
+    template <class Board> int evaluate_center_control(const Board *) const;
+    template <class Board> int evaluate_king_safety(const Board *) const;
+
+    void extract_features(const rules::IBoard *, FeatureVector &features) const;
+    template <class Board>
+    void extract_features(const Board *, FeatureVector &features) const;
+    template <class Board>
+    void extract_features(
+        const Board *const *boards, std::size_t count, FeatureVector *features) const;
+
+    int evaluate_features(const FeatureVector &features) const
+    {
+        int evaluation = 0;
+        for (uint i = 0; i < FEATURES_COUNT; ++i)
+            evaluation += this->feature_weight[i] * features[i];
+        return evaluation;
+    }
+    void evaluate_features(
+        const FeatureVector *features, std::size_t count, int *evaluations) const;
+    const FeatureWeights &get_feature_weights() const
+    {
+        return this->feature_weight;
+    }
+
+    int get_piece_value(rules::Piece::Type piece_type) const
+    {
+        return this->piece_value[piece_type];
+    }
+    int get_factor_weight(Factors factor) const
+    {
+        return this->factor_weight[factor];
+    }
     void load_factor_weights(std::vector<int> &weights);
+    // From pawn to queen, as TexelTuner tunes them
+    void load_piece_values(const std::vector<int> &values);
+
+    // Evaluations are in pawn values times the material weight
+    int to_centipawns(int evaluation) const;
 
   private:
     int material_value(bits::bitboard piece, rules::Piece::Type) const;
-    int mobility_value(
-        const rules::IBoard *, bits::bitboard piece, rules::Piece::Type) const;
 
+    template <class Board>
+    int mobility_value(const Board *, bits::bitboard piece, rules::Piece::Type) const;
+
+    template <class Board>
     int center_control_value(
-        const rules::IBoard *, bits::bitboard piece, rules::Piece::Type) const;
+        const Board *, bits::bitboard piece, rules::Piece::Type) const;
 
-    int king_safety_value(const rules::IBoard *, rules::Piece::Player) const;
-    int development_value(const rules::IBoard *, rules::Piece::Player) const;
+    template <class Board>
+    int king_safety_value(const Board *, rules::Piece::Player) const;
 
-    enum Factors
-    {
-        MATERIAL,
-        MOBILITY,
-        CENTER_CONTROL,
-        KING_SAFETY
-    };
+    void update_feature_weights();
 
-    // Piece values are well-known, so we make them static here.
+    // Piece values are well-known, so these are only the defaults.
     std::vector<int> piece_value;
     std::vector<int> factor_weight;
+    FeatureWeights feature_weight;
 };
 
 } // namespace engine
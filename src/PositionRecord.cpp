@@ -0,0 +1,346 @@
+#include "PositionRecord.hpp"
+#include "IBoard.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace serialization
+{
+using bits::bitboard;
+using rules::BoardSquare;
+using rules::CastleSide;
+using rules::IBoard;
+using rules::Piece;
+
+namespace
+{
+const char FILE_MAGIC[] = "PAWNPR01";
+const uint FILE_VERSION = 1;
+
+struct FileHeader
+{
+    char magic[8];
+    uint version;
+    uint record_size;
+    char reserved[16];
+};
+
+const uint MAX_PIECES = 32;
+const uint PIECE_CODES_COUNT = rules::PLAYERS_COUNT * Piece::PIECES_COUNT;
+
+const CastleSide CASTLE_SIDES[] = {CastleSide::KING_SIDE, CastleSide::QUEEN_SIDE};
+
+// The castling flag of PLAYER on SIDE
+unsigned char castling_flag(Piece::Player player, CastleSide side)
+{
+    uint shift = 2 * player + (side == CastleSide::QUEEN_SIDE ? 1 : 0);
+    return PositionRecord::WHITE_KING_SIDE << shift;
+}
+} // anonymous namespace
+
+/*==============================================================================
+  Pack the position on BOARD, labeled with RESULT and SCORE (if any, from
+  white's point of view), into RECORD. Return FALSE if the board has more
+  pieces than a record can hold.
+  ==============================================================================*/
+bool PositionRecord::pack(
+    const IBoard &board, Result result, PositionRecord &record, const short *score)
+{
+    static_assert(sizeof(PositionRecord) == 32, "Records should be 32 bytes long");
+
+    memset(&record, 0, sizeof(record));
+    record.occupancy = board.get_all_pieces();
+    if (bits::count_ones(record.occupancy) > MAX_PIECES)
+        return false;
+
+    uint index = 0;
+    for (bitboard pieces = record.occupancy; pieces; pieces &= pieces - 1, ++index)
+    {
+        BoardSquare square = BoardSquare(bits::lsb_position(pieces));
+        uint code = board.get_piece_color(square) * Piece::PIECES_COUNT +
+                    board.get_piece(square);
+        record.pieces[index / 2] |= code << (4 * (index % 2));
+    }
+
+    bool is_whites_turn = board.current_player() == Piece::WHITE;
+    record.flags = (is_whites_turn ? 0 : BLACK_TO_MOVE);
+    for (Piece::Player player = Piece::WHITE; player <= Piece::BLACK; ++player)
+        for (CastleSide side : CASTLE_SIDES)
+            if (board.can_castle(player, side))
+                record.flags |= castling_flag(player, side);
+
+    if (score != nullptr)
+    {
+        record.flags |= HAS_SCORE;
+        record.score = *score;
+    }
+
+    record.en_passant = NO_EN_PASSANT;
+    if (board.get_en_passant_square())
+        record.en_passant = bits::msb_position(board.get_en_passant_square());
+
+    record.result = result;
+    record.move_number = std::max(board.get_move_number() + (is_whites_turn ? 1 : 0), 1u);
+    return true;
+}
+
+/*==============================================================================
+  Set BOARD to the position in THIS record. Return FALSE (and leave the board
+  empty) if the record does not hold a valid position.
+  ==============================================================================*/
+bool PositionRecord::unpack(IBoard *board) const
+{
+    board->clear();
+
+    // Only MAX_PIECES pieces have a code, so a corrupt record could have more
+    if (bits::count_ones(this->occupancy) > MAX_PIECES)
+        return false;
+
+    uint index = 0;
+    for (bitboard pieces = this->occupancy; pieces; pieces &= pieces - 1, ++index)
+    {
+        uint code = (this->pieces[index / 2] >> (4 * (index % 2))) & 0xF;
+        if (code >= PIECE_CODES_COUNT)
+        {
+            board->clear();
+            return false;
+        }
+
+        board->add_piece(
+            BoardSquare(bits::lsb_position(pieces)),
+            Piece::Type(code % Piece::PIECES_COUNT),
+            Piece::Player(code / Piece::PIECES_COUNT));
+    }
+
+    board->set_player_in_turn(this->flags & BLACK_TO_MOVE ? Piece::BLACK : Piece::WHITE);
+    for (Piece::Player player = Piece::WHITE; player <= Piece::BLACK; ++player)
+        for (CastleSide side : CASTLE_SIDES)
+            if (!(this->flags & castling_flag(player, side)))
+                board->set_castling_privilege(player, side, false);
+
+    if (this->en_passant < NO_EN_PASSANT)
+        board->set_en_passant_capture_square(BoardSquare(this->en_passant));
+
+    return true;
+}
+
+float PositionRecord::get_white_score() const
+{
+    return this->result / 2.0f;
+}
+
+/*==============================================================================
+  Return the result written as LABEL in PGN (1-0, 0-1 or 1/2-1/2), or
+  UNKNOWN_RESULT for anything else
+  ==============================================================================*/
+PositionRecord::Result PositionRecord::parse_result(const std::string &label)
+{
+    if (label == "1-0")
+        return WHITE_WINS;
+    if (label == "0-1")
+        return BLACK_WINS;
+    if (label == "1/2-1/2")
+        return DRAW;
+    return UNKNOWN_RESULT;
+}
+
+PositionRecordWriter::PositionRecordWriter()
+{
+    this->descriptor = -1;
+}
+
+PositionRecordWriter::~PositionRecordWriter()
+{
+    close();
+}
+
+/*==============================================================================
+  Open FILE to append records to it, creating it if needed. Return FALSE if it
+  cannot be written, or if it is not empty and not a dataset of records.
+  ==============================================================================*/
+bool PositionRecordWriter::open(const std::string &file)
+{
+    close();
+
+    int descriptor = ::open(file.c_str(), O_RDWR | O_CREAT, 0644);
+    if (descriptor < 0)
+        return false;
+
+    FileHeader header = {};
+    const ssize_t HEADER_SIZE = sizeof(header);
+    struct stat status;
+    bool is_valid = fstat(descriptor, &status) == 0;
+
+    if (is_valid && status.st_size == 0)
+    {
+        memcpy(header.magic, FILE_MAGIC, sizeof(header.magic));
+        header.version = FILE_VERSION;
+        header.record_size = sizeof(PositionRecord);
+        is_valid = ::write(descriptor, &header, HEADER_SIZE) == HEADER_SIZE;
+    }
+    else if (is_valid)
+    {
+        is_valid = pread(descriptor, &header, HEADER_SIZE, 0) == HEADER_SIZE &&
+                   memcmp(header.magic, FILE_MAGIC, sizeof(header.magic)) == 0 &&
+                   header.version == FILE_VERSION &&
+                   header.record_size == sizeof(PositionRecord);
+    }
+
+    if (!is_valid)
+    {
+        ::close(descriptor);
+        return false;
+    }
+
+    // A partial record left at the end of the file is cut off, so that the
+    // records appended after it are not read out of step
+    ullong records_count = 0;
+    if (status.st_size > HEADER_SIZE)
+        records_count = (status.st_size - HEADER_SIZE) / sizeof(PositionRecord);
+    off_t end_offset = HEADER_SIZE + records_count * sizeof(PositionRecord);
+    if (status.st_size > end_offset && ftruncate(descriptor, end_offset) != 0)
+    {
+        ::close(descriptor);
+        return false;
+    }
+
+    this->descriptor = descriptor;
+    this->end_offset = end_offset;
+    this->buffer.reserve(BUFFER_RECORDS);
+    return true;
+}
+
+/*==============================================================================
+  Write the records still buffered and close the file. Return FALSE if they
+  could not be written.
+  ==============================================================================*/
+bool PositionRecordWriter::close()
+{
+    if (this->descriptor < 0)
+        return true;
+
+    bool is_flushed = flush();
+    ::close(this->descriptor);
+    this->descriptor = -1;
+    return is_flushed;
+}
+
+bool PositionRecordWriter::write(const PositionRecord &record)
+{
+    this->buffer.push_back(record);
+    return this->buffer.size() < BUFFER_RECORDS || flush();
+}
+
+/*==============================================================================
+  Write the COUNT records in RECORDS at the end of the file, as one block that
+  the blocks written by other threads at the same time cannot interleave with.
+  Return FALSE if they could not be written.
+  ==============================================================================*/
+bool PositionRecordWriter::write(const PositionRecord *records, size_t count)
+{
+    size_t size = count * sizeof(PositionRecord);
+    ullong offset = this->end_offset.fetch_add(size);
+
+    const char *bytes = reinterpret_cast<const char *>(records);
+    while (size > 0)
+    {
+        ssize_t written = pwrite(this->descriptor, bytes, size, offset);
+        if (written <= 0)
+            return false;
+
+        bytes += written;
+        offset += written;
+        size -= written;
+    }
+    return true;
+}
+
+bool PositionRecordWriter::flush()
+{
+    bool is_written = write(this->buffer.data(), this->buffer.size());
+    this->buffer.clear();
+    return is_written;
+}
+
+PositionRecordReader::PositionRecordReader()
+{
+    this->mapping = nullptr;
+    this->mapping_size = 0;
+    this->records = nullptr;
+    this->records_count = 0;
+}
+
+PositionRecordReader::~PositionRecordReader()
+{
+    close();
+}
+
+/*==============================================================================
+  Map the dataset in FILE to memory, replacing the one open (if any). Return
+  FALSE if FILE is not a dataset of records.
+  ==============================================================================*/
+bool PositionRecordReader::open(const std::string &file)
+{
+    static_assert(sizeof(FileHeader) == sizeof(PositionRecord), "Misaligned records");
+
+    close();
+
+    int descriptor = ::open(file.c_str(), O_RDONLY);
+    if (descriptor < 0)
+        return false;
+
+    FileHeader header;
+    struct stat status;
+    bool is_valid =
+        fstat(descriptor, &status) == 0 &&
+        pread(descriptor, &header, sizeof(header), 0) == (ssize_t)sizeof(header) &&
+        memcmp(header.magic, FILE_MAGIC, sizeof(header.magic)) == 0 &&
+        header.version == FILE_VERSION && header.record_size == sizeof(PositionRecord);
+
+    void *mapping = MAP_FAILED;
+    if (is_valid)
+        mapping = mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED, descriptor, 0);
+    ::close(descriptor);
+
+    if (mapping == MAP_FAILED)
+        return false;
+
+    this->mapping = mapping;
+    this->mapping_size = status.st_size;
+    this->records = reinterpret_cast<const PositionRecord *>(
+        static_cast<const char *>(mapping) + sizeof(FileHeader));
+    this->records_count = (status.st_size - sizeof(FileHeader)) / sizeof(PositionRecord);
+    return true;
+}
+
+void PositionRecordReader::close()
+{
+    if (this->mapping != nullptr)
+        munmap(this->mapping, this->mapping_size);
+
+    this->mapping = nullptr;
+    this->mapping_size = 0;
+    this->records = nullptr;
+    this->records_count = 0;
+}
+
+bool PositionRecordReader::is_open() const
+{
+    return this->mapping != nullptr;
+}
+
+size_t PositionRecordReader::size() const
+{
+    return this->records_count;
+}
+
+const PositionRecord &PositionRecordReader::operator[](size_t index) const
+{
+    return this->records[index];
+}
+
+} // namespace serialization
@@ -0,0 +1,142 @@
+#ifndef POSITION_RECORD_H
+#define POSITION_RECORD_H
+
+/*==============================================================================
+  Stores labeled positions (for training and tuning) in fixed-size 32-byte
+  records, about half the size of the same position in FEN, and ready to use
+  without parsing:
+
+  - the occupied squares, as a bitboard (8 bytes);
+  - a 4-bit code (color and piece type) per occupied square, in square order,
+    two per byte (16 bytes, enough for the 32 pieces of a chess game);
+  - the search score (in centipawns) and the game result, both from white's
+    point of view;
+  - the turn, castling rights, en-passant square and move number.
+
+  Dataset files hold a 32-byte header followed by the records. Readers map the
+  file to memory, so a record anywhere in the file can be reached at once, and
+  the whole file can be streamed as fast as memory allows. A file cut short
+  (e.g. by a writer that was killed) just loses its last, partial record,
+  which writers cut off before appending to the file.
+
+  Any number of threads can write blocks of records to the same writer at
+  once, without locks: each block claims its place at the end of the file by
+  moving an atomic offset forward, and is then written there with pwrite.
+  Threads buffer their records and write them a block at a time, so they
+  seldom touch the shared offset.
+  ==============================================================================*/
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "bitboard.hpp"
+#include "type_aliases.hpp"
+
+namespace rules
+{
+class IBoard;
+}
+
+namespace serialization
+{
+struct PositionRecord
+{
+    enum Result
+    {
+        BLACK_WINS,
+        DRAW,
+        WHITE_WINS,
+        UNKNOWN_RESULT
+    };
+
+    enum Flags
+    {
+        BLACK_TO_MOVE = 1 << 0,
+        WHITE_KING_SIDE = 1 << 1,
+        WHITE_QUEEN_SIDE = 1 << 2,
+        BLACK_KING_SIDE = 1 << 3,
+        BLACK_QUEEN_SIDE = 1 << 4,
+        HAS_SCORE = 1 << 5
+    };
+
+    bits::bitboard occupancy;
+    unsigned char pieces[16];
+    short score;
+    ushort move_number;
+    unsigned char flags;
+    unsigned char en_passant; // A square, or NO_EN_PASSANT
+    unsigned char result;
+    unsigned char reserved;
+
+    static const unsigned char NO_EN_PASSANT = 64;
+
+    // Scores are in centipawns, within MAX_SCORE. Forced mates are recorded
+    // as MATE_SCORE for white and -MATE_SCORE for black, however far.
+    static const short MAX_SCORE = 30000;
+    static const short MATE_SCORE = 32767;
+
+    static bool pack(
+        const rules::IBoard &, Result result, PositionRecord &record,
+        const short *score = nullptr);
+    bool unpack(rules::IBoard *board) const;
+
+    // The score of the game for white: 1, 1/2 or 0
+    float get_white_score() const;
+
+    static Result parse_result(const std::string &label);
+};
+
+class PositionRecordWriter
+{
+  public:
+    PositionRecordWriter();
+    ~PositionRecordWriter();
+
+    bool open(const std::string &file);
+    bool close();
+
+    bool write(const PositionRecord &);
+    bool write(const PositionRecord *records, size_t count);
+
+  private:
+    PositionRecordWriter(const PositionRecordWriter &) = delete;
+    PositionRecordWriter &operator=(const PositionRecordWriter &) = delete;
+
+    static const uint BUFFER_RECORDS = 4096;
+
+    bool flush();
+
+    int descriptor;
+    std::atomic<ullong> end_offset;
+
+    // Records given one at a time, which only one thread may do
+    std::vector<PositionRecord> buffer;
+};
+
+class PositionRecordReader
+{
+  public:
+    PositionRecordReader();
+    ~PositionRecordReader();
+
+    bool open(const std::string &file);
+    void close();
+    bool is_open() const;
+
+    size_t size() const;
+    const PositionRecord &operator[](size_t index) const;
+
+  private:
+    PositionRecordReader(const PositionRecordReader &) = delete;
+    PositionRecordReader &operator=(const PositionRecordReader &) = delete;
+
+    void *mapping;
+    size_t mapping_size;
+    const PositionRecord *records;
+    size_t records_count;
+};
+
+} // namespace serialization
+
+#endif // POSITION_RECORD_H
@@ -4,14 +4,6 @@
 
 namespace rules
 {
-Rook::Rook()
-{
-    compute_moves();
-}
-
-Rook::~Rook()
-{
-}
 /*=============================================================================
   Get all moves from SQUARE in the current BOARD assumming it is PLAYER'S turn
   to move (moves that may leave the king in check are also included)
@@ -52,7 +44,7 @@ bitboard
 Rook::get_potential_moves(uint square, Player /* player */) const
 {
     if (IBoard::is_inside_board(square))
-        return this->all_moves_from[square];
+        return Rook::move_table.all_moves_from[square];
 
     return 0;
 }
@@ -61,24 +53,16 @@ Rook::get_potential_moves(uint square, Player /* player */) const
   Compute all moves a bishop can make from every square on the board assuming
   the board is empty.
   ============================================================================*/
-void Rook::compute_moves()
+constexpr Rook::MoveTable Rook::compute_moves()
 {
+    MoveTable table = {};
     int dx[Piece::RAY_DIRECTIONS_COUNT] = {0, +1, 0, -1};
     int dy[Piece::RAY_DIRECTIONS_COUNT] = {-1, 0, +1, 0};
 
-    for (BoardSquare square = BoardSquare::a8; square <= BoardSquare::h1; ++square)
-    {
-        for (uint ray = 0; ray < Piece::RAY_DIRECTIONS_COUNT; ++ray)
-            this->moves_from[square][ray] = 0;
-
-        this->all_moves_from[square] = 0;
-    }
-
     for (uint row = 0; row < BOARD_SIZE; ++row)
         for (uint col = 0; col < BOARD_SIZE; ++col)
         {
             auto square = BoardSquare(row * BOARD_SIZE + col);
-            RowColumn ray;
 
             /*--------------------------------------------------------------------
               Traverse all four directions a rook can move to
@@ -90,7 +74,7 @@ void Rook::compute_moves()
                     |           W : West
                     S
               -------------------------------------------------------------------*/
-            for (ray = Piece::NORTH; ray <= Piece::WEST; ++ray)
+            for (RowColumn ray = Piece::NORTH; ray <= Piece::WEST; ++ray)
             {
                 int y = row;
                 int x = col;
@@ -98,14 +82,17 @@ void Rook::compute_moves()
                 {
                     y += dy[ray];
                     x += dx[ray];
-                    this->moves_from[square][ray] |=
+                    table.moves_from[square][ray] |=
                         bits::to_bitboard[y * BOARD_SIZE + x];
                 }
-                this->all_moves_from[square] |= this->moves_from[square][ray];
+                table.all_moves_from[square] |= table.moves_from[square][ray];
             }
         }
+    return table;
 }
 
+constexpr Rook::MoveTable Rook::move_table = Rook::compute_moves();
+
 /*=============================================================================
   Return all possible moves from SQUARE following DIRECTION, assuming the
   board is empty.
@@ -113,7 +100,7 @@ void Rook::compute_moves()
 bitboard Rook::get_ray_from(BoardSquare square, RowColumn direction) const
 {
     if (IBoard::is_inside_board(square))
-        return this->moves_from[square][direction];
+        return Rook::move_table.moves_from[square][direction];
 
     return 0;
 }
@@ -17,18 +17,21 @@ class IBoard;
 class Rook : public Piece
 {
   public:
-    Rook();
-    ~Rook();
-
     bitboard get_moves(uint square, Player player, const IBoard *board) const;
     bitboard get_potential_moves(uint square, Player player) const;
 
   private:
     bitboard get_ray_from(BoardSquare square, RowColumn direction) const;
-    void compute_moves();
 
-    bitboard moves_from[BOARD_SQUARES_COUNT][Piece::RAY_DIRECTIONS_COUNT];
-    bitboard all_moves_from[BOARD_SQUARES_COUNT];
+    struct MoveTable
+    {
+        bitboard moves_from[BOARD_SQUARES_COUNT][Piece::RAY_DIRECTIONS_COUNT];
+        bitboard all_moves_from[BOARD_SQUARES_COUNT];
+    };
+
+    // Computed at compile time and shared by all rooks
+    static constexpr MoveTable compute_moves();
+    static const MoveTable move_table;
 };
 
 } // namespace rules
@@ -0,0 +1,185 @@
+#include "SanNotation.hpp"
+#include "BoardTraits.hpp"
+#include "IBoard.hpp"
+#include "Move.hpp"
+#include "MoveGenerator.hpp"
+
+#include <cassert>
+#include <cstdlib>
+
+namespace serialization
+{
+using rules::BoardSquare;
+using rules::IBoard;
+using rules::Move;
+using rules::Piece;
+using std::string;
+using std::vector;
+
+static const char PIECE_LETTERS[] = "PNBRQK";
+
+static uint file_of(BoardSquare square)
+{
+    return square % 8;
+}
+
+static uint rank_of(BoardSquare square)
+{
+    return square / 8;
+}
+
+/*=============================================================================
+  Return in MOVES all the moves that can legally be made in BOARD. Moves that
+  would draw by repetition are legal, even though the search treats them
+  specially.
+  =============================================================================*/
+void SanNotation::get_legal_moves(IBoard *board, vector<Move> &moves)
+{
+    engine::MoveGenerator move_generator;
+    vector<Move> candidates;
+
+    moves.clear();
+    move_generator.generate_moves(board, candidates);
+    for (Move candidate : candidates)
+    {
+        Move move = candidate;
+        if (board->make_move(move, /* is_computer_move: */ true) == IBoard::KING_LEFT_IN_CHECK)
+            continue;
+
+        assert(board->undo_move());
+        moves.push_back(candidate);
+    }
+}
+
+/*=============================================================================
+  Return the SAN of MOVE (e.g. Nbd2, exd6, O-O, e8=Q#), which must be a legal
+  move in BOARD; return an empty string otherwise.
+  =============================================================================*/
+string SanNotation::to_san(IBoard *board, const Move &move)
+{
+    vector<Move> legal_moves;
+    get_legal_moves(board, legal_moves);
+
+    BoardSquare from = move.from(), to = move.to();
+    Piece::Type piece = board->get_piece(from);
+    bool is_legal = false;
+    for (const Move &legal_move : legal_moves)
+        is_legal = is_legal || legal_move == move;
+
+    if (!is_legal || piece == Piece::NULL_PIECE)
+        return "";
+
+    string san, square;
+    if (piece == Piece::KING && abs(int(to) - int(from)) == 2)
+    {
+        san = (to > from ? "O-O" : "O-O-O");
+    }
+    else
+    {
+        bool is_capture = board->get_piece(to) != Piece::NULL_PIECE ||
+                          (piece == Piece::PAWN && file_of(from) != file_of(to));
+
+        if (piece != Piece::PAWN)
+        {
+            san += PIECE_LETTERS[piece];
+
+            // Disambiguate from other pieces of the same kind that can also
+            // move to the same square, by file if possible and then by rank
+            bool is_ambiguous = false, same_file = false, same_rank = false;
+            for (const Move &other : legal_moves)
+            {
+                if (other.to() != to || other.from() == from ||
+                    board->get_piece(other.from()) != piece)
+                    continue;
+
+                is_ambiguous = true;
+                same_file = same_file || file_of(other.from()) == file_of(from);
+                same_rank = same_rank || rank_of(other.from()) == rank_of(from);
+            }
+
+            if (is_ambiguous && (!same_file || same_rank))
+                san += char('a' + file_of(from));
+            if (is_ambiguous && same_file)
+                san += char('8' - rank_of(from));
+        }
+        else if (is_capture)
+        {
+            san += char('a' + file_of(from));
+        }
+
+        if (is_capture)
+            san += 'x';
+
+        Move::translate_to_notation(to, square);
+        san += square;
+
+        // Pawns are always promoted to queens
+        if (piece == Piece::PAWN && (rank_of(to) == 0 || rank_of(to) == 7))
+            san += "=Q";
+    }
+
+    Move made_move = move;
+    IBoard::Error error = board->make_move(made_move, /* is_computer_move: */ true);
+    assert(error != IBoard::KING_LEFT_IN_CHECK);
+    if (board->is_king_in_check())
+    {
+        vector<Move> replies;
+        get_legal_moves(board, replies);
+        san += (replies.empty() ? "#" : "+");
+    }
+    assert(board->undo_move());
+
+    return san;
+}
+
+/*=============================================================================
+  Return TRUE if SAN denotes a legal move in BOARD, which is returned in MOVE.
+  Check and annotation marks (+, #, !, ?) are ignored, and coordinate notation
+  (e.g. e2e4) is accepted too.
+  =============================================================================*/
+bool SanNotation::parse(const string &san, IBoard *board, Move &move)
+{
+    string wanted = strip_annotations(san);
+    if (wanted.empty())
+        return false;
+
+    // Castling is sometimes written with zeros
+    for (char &c : wanted)
+        if (c == '0')
+            c = 'O';
+
+    // Every SAN but castling ends with the destination square (before any
+    // promotion), so only the moves to that square need to be written out
+    BoardSquare destination;
+    string::size_type rank = wanted.find_last_of("12345678");
+    bool has_destination =
+        rank != string::npos && rank > 0 &&
+        Move::translate_to_square(wanted.substr(rank - 1, 2), destination);
+
+    vector<Move> legal_moves;
+    get_legal_moves(board, legal_moves);
+    for (const Move &legal_move : legal_moves)
+    {
+        if (has_destination && legal_move.to() != destination)
+            continue;
+
+        if (strip_annotations(to_san(board, legal_move)) == wanted ||
+            legal_move.to_notation() == wanted)
+        {
+            move = legal_move;
+            return true;
+        }
+    }
+    return false;
+}
+
+string SanNotation::strip_annotations(const string &san)
+{
+    string stripped;
+    for (char c : san)
+        if (c != '+' && c != '#' && c != '!' && c != '?')
+            stripped += c;
+    return stripped;
+}
+
+} // namespace serialization
@@ -0,0 +1,40 @@
+#ifndef SAN_NOTATION_H
+#define SAN_NOTATION_H
+
+/*==============================================================================
+  Translates moves to and from Standard Algebraic Notation (e.g. Nbd2, exd6,
+  O-O-O, e8=Q+), the notation used by PGN and by the bm/am opcodes of EPD.
+
+  SAN only makes sense relative to a position, so every translation needs the
+  board on which the move is about to be made. The board is modified while
+  translating (to check legality and checks), but always left as it was.
+  ==============================================================================*/
+
+#include <string>
+#include <vector>
+
+namespace rules
+{
+class IBoard;
+class Move;
+} // namespace rules
+
+namespace serialization
+{
+using std::string;
+
+class SanNotation
+{
+  public:
+    static string to_san(rules::IBoard *board, const rules::Move &move);
+    static bool parse(const string &san, rules::IBoard *board, rules::Move &move);
+
+    static void get_legal_moves(rules::IBoard *board, std::vector<rules::Move> &moves);
+
+  private:
+    static string strip_annotations(const string &san);
+};
+
+} // namespace serialization
+
+#endif // SAN_NOTATION_H
@@ -3,49 +3,58 @@
 
 #include <cmath>
 #include <iostream>
-#include <locale>
-#include <memory>
+#include <string>
+
+#include "type_aliases.hpp"
 
 namespace engine
 {
 using std::cerr;
 using std::endl;
 
-struct separate_thousands : std::numpunct<char>
-{
-    char_type do_thousands_sep() const override
-    {
-        return ',';
-    } // separate with commas
-    string_type do_grouping() const override
-    {
-        return "\3";
-    } // groups of 3 digit
-};
-
 class SearchStats
 {
   public:
-    SearchStats()
-    {
-        // add thousands separators to numbers to make them easier to read
-        auto thousands = std::make_unique<separate_thousands>();
-        std::cerr.imbue(std::locale(std::cerr.getloc(), thousands.release()));
-    }
-
     void print() const
     {
         cerr << "-------------------------------------------------------" << endl;
-        cerr << "Nodes evaluated: " << this->nodes_evaluated << endl;
-        cerr << "   Leaf nodes: " << this->leaf_nodes << endl;
-        cerr << "   Internal nodes: " << this->internal_nodes << endl;
+        cerr << "Nodes evaluated: " << separate_thousands(this->nodes_evaluated) << endl;
+        cerr << "   Leaf nodes: " << separate_thousands(this->leaf_nodes) << endl;
+        cerr << "   Internal nodes: " << separate_thousands(this->internal_nodes) << endl;
+        cerr << "   Quiescence nodes: " << separate_thousands(this->quiescence_nodes)
+             << endl;
         cerr << "Average branching factor: " << int(round(this->average_branching_factor))
              << endl;
-        cerr << "Transposition table hits: " << this->cache_hits << endl;
-        cerr << "AlphaBeta cutoffs: " << this->alpha_beta_cutoffs << endl;
+        cerr << "Transposition table probes: " << separate_thousands(this->cache_probes)
+             << endl;
+        cerr << "   Hits: " << separate_thousands(this->cache_hits) << endl;
+        cerr << "   Cutoffs: " << separate_thousands(this->cache_cutoffs) << endl;
+        cerr << "AlphaBeta cutoffs: " << separate_thousands(this->alpha_beta_cutoffs)
+             << endl;
+        cerr << "   On the first move: " << int(round(100 * first_move_cutoff_rate()))
+             << "%" << endl;
         cerr << "-------------------------------------------------------" << endl;
     }
 
+    /*--------------------------------------------------------------------------
+      Write the counters to OUT as the members of a JSON object (without the
+      surrounding braces), so that they can be combined with other members
+      --------------------------------------------------------------------------*/
+    void print_json_members(std::ostream &out) const
+    {
+        out << "\"nodes_evaluated\":" << this->nodes_evaluated
+            << ",\"leaf_nodes\":" << this->leaf_nodes
+            << ",\"internal_nodes\":" << this->internal_nodes
+            << ",\"quiescence_nodes\":" << this->quiescence_nodes
+            << ",\"branching_factor\":" << this->average_branching_factor
+            << ",\"tt_probes\":" << this->cache_probes
+            << ",\"tt_hits\":" << this->cache_hits
+            << ",\"tt_cutoffs\":" << this->cache_cutoffs
+            << ",\"cutoffs\":" << this->alpha_beta_cutoffs
+            << ",\"first_move_cutoffs\":" << this->first_move_cutoffs
+            << ",\"first_move_cutoff_rate\":" << first_move_cutoff_rate();
+    }
+
     void add_branching_factor(uint factor)
     {
         // https://math.stackexchange.com/questions/106700/incremental-averaging
@@ -54,22 +63,46 @@ class SearchStats
         this->average_branching_factor = mean;
     }
 
+    double first_move_cutoff_rate() const
+    {
+        if (this->alpha_beta_cutoffs == 0)
+            return 0.0;
+        return double(this->first_move_cutoffs) / this->alpha_beta_cutoffs;
+    }
+
     void reset()
     {
+        this->cache_probes = 0;
         this->cache_hits = 0;
+        this->cache_cutoffs = 0;
         this->leaf_nodes = 0;
         this->internal_nodes = 0;
+        this->quiescence_nodes = 0;
         this->nodes_evaluated = 0;
         this->average_branching_factor = 0.0;
         this->alpha_beta_cutoffs = 0;
+        this->first_move_cutoffs = 0;
+    }
+
+    // add thousands separators to numbers to make them easier to read
+    static std::string separate_thousands(ullong number)
+    {
+        std::string digits = std::to_string(number);
+        for (int i = int(digits.size()) - 3; i > 0; i -= 3)
+            digits.insert(i, ",");
+        return digits;
     }
 
-    uint cache_hits = 0;
-    uint leaf_nodes = 0;
-    uint internal_nodes = 0;
-    uint nodes_evaluated = 0;
+    ullong cache_probes = 0;
+    ullong cache_hits = 0;
+    ullong cache_cutoffs = 0;
+    ullong leaf_nodes = 0;
+    ullong internal_nodes = 0;
+    ullong quiescence_nodes = 0;
+    ullong nodes_evaluated = 0;
     double average_branching_factor = 0.0;
-    uint alpha_beta_cutoffs = 0;
+    ullong alpha_beta_cutoffs = 0;
+    ullong first_move_cutoffs = 0;
 };
 } // namespace engine
 
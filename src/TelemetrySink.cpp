@@ -0,0 +1,16 @@
+#include "TelemetrySink.hpp"
+
+namespace diagnostics
+{
+TelemetrySink::TelemetrySink(std::ostream &output) : output(output)
+{
+}
+
+void TelemetrySink::emit(const std::string &json_object)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->output << json_object << '\n';
+    this->output.flush();
+}
+
+} // namespace diagnostics
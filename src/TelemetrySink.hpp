@@ -0,0 +1,31 @@
+#ifndef TELEMETRY_SINK_H
+#define TELEMETRY_SINK_H
+
+/*==============================================================================
+  Destination of machine-readable search telemetry, written as JSON lines
+  (one JSON object per line). A sink may be shared by several searches running
+  in different threads: every line is written at once, never interleaved with
+  the lines of other threads.
+  ==============================================================================*/
+
+#include <mutex>
+#include <ostream>
+#include <string>
+
+namespace diagnostics
+{
+class TelemetrySink
+{
+  public:
+    TelemetrySink(std::ostream &output);
+
+    void emit(const std::string &json_object);
+
+  private:
+    std::ostream &output;
+    std::mutex mutex;
+};
+
+} // namespace diagnostics
+
+#endif // TELEMETRY_SINK_H
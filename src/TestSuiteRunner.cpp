@@ -0,0 +1,153 @@
+#include "TestSuiteRunner.hpp"
+#include "EpdReader.hpp"
+#include "FenReader.hpp"
+#include "SanNotation.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace engine
+{
+using rules::Move;
+using serialization::EpdReader;
+using serialization::EpdRecord;
+using serialization::FenReader;
+using serialization::SanNotation;
+using std::endl;
+using std::setw;
+using std::string;
+using std::vector;
+
+TestSuiteRunner::TestSuiteRunner(int max_depth, double time_limit, ullong node_limit)
+    : search(&evaluator, &generator)
+{
+    this->max_depth = max_depth;
+    this->search.set_verbose(false);
+    this->search.set_time_limit(time_limit);
+    this->search.set_node_limit(node_limit);
+}
+
+void TestSuiteRunner::set_telemetry_sink(diagnostics::TelemetrySink *sink)
+{
+    this->search.set_telemetry_sink(sink);
+}
+
+/*==============================================================================
+  Search every position of SUITE and write one line per position to REPORT.
+  Positions without bm or am opcodes, or whose moves cannot be understood, are
+  skipped.
+  ==============================================================================*/
+SuiteResult TestSuiteRunner::run(std::istream &suite, std::ostream &report)
+{
+    SuiteResult result = {};
+    EpdReader reader(suite);
+    EpdRecord record;
+
+    report << std::left << setw(16) << "id" << setw(8) << "result" << setw(10) << "move"
+           << setw(20) << "expected" << std::right << setw(10) << "seconds" << setw(12)
+           << "nodes" << setw(6) << "depth" << endl;
+
+    while (reader.next(record))
+    {
+        result.positions++;
+        if (!run_position(record, report, result))
+        {
+            result.skipped++;
+            report << std::left << setw(16) << record.get_operation("id") << "skipped"
+                   << endl;
+        }
+    }
+    return result;
+}
+
+/*==============================================================================
+  Search the position in RECORD and add its outcome to RESULT. Return FALSE if
+  the record cannot be used as a test.
+  ==============================================================================*/
+bool TestSuiteRunner::run_position(
+    const EpdRecord &record, std::ostream &report, SuiteResult &result)
+{
+    vector<Move> best_moves, avoid_moves;
+
+    if (!FenReader(record.position, &this->board).load_position())
+        return false;
+    if (!record.has_operation("bm") && !record.has_operation("am"))
+        return false;
+    if (!read_moves(record.get_operation("bm"), best_moves) ||
+        !read_moves(record.get_operation("am"), avoid_moves))
+        return false;
+
+    // Every position is searched from scratch, as in a real game
+    this->search.clear_transposition_table();
+
+    // The search leaves the board as it was, so the answer can be translated
+    Move best_move;
+    this->search.get_best_move(this->max_depth, &this->board, best_move);
+    string found = SanNotation::to_san(&this->board, best_move);
+
+    // Find the iteration since which the engine has chosen solutions only
+    const vector<SearchIteration> &iterations = this->search.get_iterations();
+    int settled = iterations.size();
+    while (settled > 0 &&
+           is_solution(iterations[settled - 1].best_move, best_moves, avoid_moves))
+        settled--;
+
+    bool is_solved = (settled < (int)iterations.size());
+    double seconds = this->search.get_elapsed_seconds();
+
+    result.nodes += this->search.get_nodes_searched();
+    result.seconds += seconds;
+    if (is_solved)
+    {
+        result.solved++;
+        result.solution_seconds += iterations[settled].seconds;
+    }
+
+    string expected = record.has_operation("bm") ? "bm " + record.get_operation("bm")
+                                                 : "am " + record.get_operation("am");
+
+    report << std::left << setw(16) << record.get_operation("id") << setw(8)
+           << (is_solved ? "ok" : "FAIL") << setw(10) << (found.empty() ? "-" : found)
+           << setw(20) << expected << std::right << std::fixed << std::setprecision(3)
+           << setw(10) << (is_solved ? iterations[settled].seconds : seconds) << setw(12)
+           << this->search.get_nodes_searched() << setw(6)
+           << this->search.get_completed_depth() << endl;
+
+    return true;
+}
+
+/*==============================================================================
+  Parse the space-separated SAN moves in MOVES, which must all be legal in
+  THIS->BOARD
+  ==============================================================================*/
+bool TestSuiteRunner::read_moves(const string &moves, vector<Move> &parsed)
+{
+    std::istringstream tokens(moves);
+    string token;
+
+    while (tokens >> token)
+    {
+        Move move;
+        if (!SanNotation::parse(token, &this->board, move))
+            return false;
+        parsed.push_back(move);
+    }
+    return true;
+}
+
+bool TestSuiteRunner::is_solution(
+    const Move &move, const vector<Move> &best_moves, const vector<Move> &avoid_moves) const
+{
+    if (move.is_null())
+        return false;
+
+    bool is_best = best_moves.empty() ||
+                   std::find(best_moves.begin(), best_moves.end(), move) != best_moves.end();
+    bool is_avoided =
+        std::find(avoid_moves.begin(), avoid_moves.end(), move) != avoid_moves.end();
+
+    return is_best && !is_avoided;
+}
+
+} // namespace engine
@@ -0,0 +1,74 @@
+#ifndef TEST_SUITE_RUNNER_H
+#define TEST_SUITE_RUNNER_H
+
+/*==============================================================================
+  Measures the tactical strength of the engine by searching the positions of
+  an EPD test suite, each one under the same time or node budget, and checking
+  the move found against the bm (best move) and am (avoid move) opcodes.
+
+  A position is solved if the move chosen by the last completed iteration is
+  a solution. Its time to solution is the time at which the engine settled on
+  a solution for good, i.e. when the first iteration of the final run of
+  iterations that all chose a solution was completed.
+  ==============================================================================*/
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "AlphaBetaSearch.hpp"
+#include "MaeBoard.hpp"
+#include "MoveGenerator.hpp"
+#include "PositionEvaluator.hpp"
+#include "type_aliases.hpp"
+
+namespace serialization
+{
+struct EpdRecord;
+}
+
+namespace diagnostics
+{
+class TelemetrySink;
+}
+
+namespace engine
+{
+struct SuiteResult
+{
+    ullong positions;
+    ullong solved;
+    ullong skipped;
+    double solution_seconds; // Added over all the positions solved
+    ullong nodes;
+    double seconds;
+};
+
+class TestSuiteRunner
+{
+  public:
+    TestSuiteRunner(int max_depth, double time_limit, ullong node_limit);
+
+    SuiteResult run(std::istream &suite, std::ostream &report);
+    void set_telemetry_sink(diagnostics::TelemetrySink *sink);
+
+  private:
+    bool run_position(
+        const serialization::EpdRecord &, std::ostream &report, SuiteResult &result);
+    bool read_moves(const std::string &moves, std::vector<rules::Move> &parsed);
+    bool is_solution(
+        const rules::Move &move, const std::vector<rules::Move> &best_moves,
+        const std::vector<rules::Move> &avoid_moves) const;
+
+    int max_depth;
+
+    rules::MaeBoard board;
+    PositionEvaluator evaluator;
+    MoveGenerator generator;
+    AlphaBetaSearch search;
+};
+
+} // namespace engine
+
+#endif // TEST_SUITE_RUNNER_H
@@ -0,0 +1,354 @@
+#include "TexelTuner.hpp"
+#include "EpdReader.hpp"
+#include "FenReader.hpp"
+#include "MaeBoard.hpp"
+#include "PositionEvaluator.hpp"
+#include "PositionRecord.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <thread>
+
+namespace learning
+{
+using engine::PositionEvaluator;
+using rules::MaeBoard;
+using rules::Piece;
+using serialization::EpdReader;
+using serialization::EpdRecord;
+using serialization::FenReader;
+using serialization::PositionRecord;
+using serialization::PositionRecordReader;
+using std::vector;
+
+TexelTuner::TexelTuner(uint threads_count)
+{
+    this->threads_count = std::max(threads_count, 1u);
+    this->scaling_constant = 0.0;
+
+    PositionEvaluator evaluator;
+    for (uint i = 0; i < PositionEvaluator::FACTORS_COUNT; ++i)
+        this->parameters[i] = evaluator.get_factor_weight(PositionEvaluator::Factors(i));
+    for (Piece::Type piece = Piece::PAWN; piece <= Piece::QUEEN; ++piece)
+        this->parameters[FIRST_PIECE_VALUE + piece] = evaluator.get_piece_value(piece);
+}
+
+/*==============================================================================
+  Read the labeled positions in DATASET, EPD records whose c9 opcode holds the
+  result of the game (1-0, 0-1 or 1/2-1/2), and add their evaluation terms to
+  the ones already loaded. Records without a position or a result are skipped.
+  Return the number of positions added.
+  ==============================================================================*/
+ullong TexelTuner::load(std::istream &dataset)
+{
+    EpdReader reader(dataset);
+    EpdRecord record;
+    PositionEvaluator evaluator;
+    vector<MaeBoard> boards(LOAD_BATCH_SIZE);
+    vector<const MaeBoard *> batch;
+    vector<float> batch_results;
+    ullong positions = 0;
+
+    while (reader.next(record))
+    {
+        MaeBoard &board = boards[batch.size()];
+        float result;
+        if (!read_result(record, result) ||
+            !FenReader(record.position, &board).load_position())
+            continue;
+
+        batch.push_back(&board);
+        batch_results.push_back(result);
+        if (batch.size() == LOAD_BATCH_SIZE)
+        {
+            add_positions(evaluator, batch.data(), batch_results.data(), batch.size());
+            batch.clear();
+            batch_results.clear();
+        }
+        positions++;
+    }
+    add_positions(evaluator, batch.data(), batch_results.data(), batch.size());
+    return positions;
+}
+
+/*==============================================================================
+  Add the evaluation terms of the labeled positions in DATASET, a file of
+  packed position records, to the ones already loaded. Records without a
+  result are skipped. Return the number of positions added.
+  ==============================================================================*/
+ullong TexelTuner::load(const PositionRecordReader &dataset)
+{
+    PositionEvaluator evaluator;
+    vector<MaeBoard> boards(LOAD_BATCH_SIZE);
+    vector<const MaeBoard *> batch;
+    vector<float> batch_results;
+    ullong positions = 0;
+
+    for (size_t i = 0; i < dataset.size(); ++i)
+    {
+        const PositionRecord &record = dataset[i];
+        MaeBoard &board = boards[batch.size()];
+        if (record.result == PositionRecord::UNKNOWN_RESULT || !record.unpack(&board))
+            continue;
+
+        batch.push_back(&board);
+        batch_results.push_back(record.get_white_score());
+        if (batch.size() == LOAD_BATCH_SIZE)
+        {
+            add_positions(evaluator, batch.data(), batch_results.data(), batch.size());
+            batch.clear();
+            batch_results.clear();
+        }
+        positions++;
+    }
+    add_positions(evaluator, batch.data(), batch_results.data(), batch.size());
+    return positions;
+}
+
+/*==============================================================================
+  Add the evaluation terms of COUNT BOARDS, labeled with RESULTS. Their
+  features are extracted all at once.
+  ==============================================================================*/
+void TexelTuner::add_positions(
+    const PositionEvaluator &evaluator, const MaeBoard *const *boards,
+    const float *results, size_t count)
+{
+    vector<PositionEvaluator::FeatureVector> features(count);
+    evaluator.extract_features(boards, count, features.data());
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        short mobility = 0, center_control = 0;
+        for (Piece::Type piece = Piece::PAWN; piece <= Piece::QUEEN; ++piece)
+        {
+            this->terms[PAWNS + piece].push_back(
+                features[i][PositionEvaluator::PAWN_COUNT + piece]);
+            mobility += features[i][PositionEvaluator::PAWN_MOBILITY + piece];
+            center_control += features[i][PositionEvaluator::PAWN_CENTER_CONTROL + piece];
+        }
+        this->terms[MOBILITY].push_back(mobility);
+        this->terms[CENTER_CONTROL].push_back(center_control);
+        this->terms[KING_SAFETY].push_back(
+            features[i][PositionEvaluator::KING_SAFETY_VALUE]);
+        this->results.push_back(results[i]);
+    }
+}
+
+bool TexelTuner::read_result(const EpdRecord &record, float &result)
+{
+    std::string label = record.get_operation("c9");
+
+    if (label == "1-0")
+        result = 1.0;
+    else if (label == "0-1")
+        result = 0.0;
+    else if (label == "1/2-1/2")
+        result = 0.5;
+    else
+        return false;
+
+    return true;
+}
+
+/*==============================================================================
+  Fit the scaling constant of the logistic curve to the current weights, then
+  take ITERATIONS gradient steps of LEARNING_RATE (in units of the weights),
+  writing the prediction error to REPORT every now and then
+  ==============================================================================*/
+void TexelTuner::tune(uint iterations, double learning_rate, std::ostream &report)
+{
+    const double BETA1 = 0.9, BETA2 = 0.999;
+    const uint ITERATIONS_BETWEEN_REPORTS = 10;
+
+    if (this->results.empty())
+        return;
+
+    fit_scaling_constant();
+    report << "Scaling constant: " << std::scientific << std::setprecision(4)
+           << this->scaling_constant << std::endl;
+
+    double moment[PARAMETERS_COUNT] = {}, second_moment[PARAMETERS_COUNT] = {};
+    for (uint iteration = 1; iteration <= iterations; ++iteration)
+    {
+        PassResult pass = compute_pass(this->scaling_constant, true);
+
+        for (uint i = 0; i < PARAMETERS_COUNT; ++i)
+        {
+            if (i == FIRST_PIECE_VALUE + Piece::PAWN)
+                continue;
+
+            double gradient = pass.gradient[i];
+            moment[i] = BETA1 * moment[i] + (1 - BETA1) * gradient;
+            second_moment[i] =
+                BETA2 * second_moment[i] + (1 - BETA2) * gradient * gradient;
+
+            double corrected_moment = moment[i] / (1 - std::pow(BETA1, iteration));
+            double corrected_second_moment =
+                second_moment[i] / (1 - std::pow(BETA2, iteration));
+
+            this->parameters[i] -= learning_rate * corrected_moment /
+                                   (std::sqrt(corrected_second_moment) + 1e-12);
+        }
+
+        if (iteration % ITERATIONS_BETWEEN_REPORTS == 0 || iteration == iterations)
+            report << "Iteration " << std::setw(5) << iteration << ": error "
+                   << std::fixed << std::setprecision(6) << pass.error << std::endl;
+    }
+}
+
+double TexelTuner::get_error() const
+{
+    return compute_pass(this->scaling_constant, false).error;
+}
+
+double TexelTuner::get_scaling_constant() const
+{
+    return this->scaling_constant;
+}
+
+vector<int> TexelTuner::get_factor_weights() const
+{
+    vector<int> weights;
+    for (uint i = 0; i < FIRST_PIECE_VALUE; ++i)
+        weights.push_back((int)std::lround(this->parameters[i]));
+    return weights;
+}
+
+vector<int> TexelTuner::get_piece_values() const
+{
+    vector<int> values;
+    for (uint i = FIRST_PIECE_VALUE; i < PARAMETERS_COUNT; ++i)
+        values.push_back((int)std::lround(this->parameters[i]));
+    return values;
+}
+
+/*==============================================================================
+  Find the scaling constant that minimizes the error of the current weights by
+  golden-section search on its logarithm, since it may be of any magnitude
+  ==============================================================================*/
+void TexelTuner::fit_scaling_constant()
+{
+    const double GOLDEN_RATIO = (std::sqrt(5.0) - 1) / 2;
+    const uint STEPS = 60;
+
+    double low = std::log(1e-10), high = std::log(1e-1);
+    double a = high - GOLDEN_RATIO * (high - low);
+    double b = low + GOLDEN_RATIO * (high - low);
+    double error_a = compute_pass(std::exp(a), false).error;
+    double error_b = compute_pass(std::exp(b), false).error;
+
+    for (uint step = 0; step < STEPS; ++step)
+    {
+        if (error_a < error_b)
+        {
+            high = b;
+            b = a;
+            error_b = error_a;
+            a = high - GOLDEN_RATIO * (high - low);
+            error_a = compute_pass(std::exp(a), false).error;
+        }
+        else
+        {
+            low = a;
+            a = b;
+            error_a = error_b;
+            b = low + GOLDEN_RATIO * (high - low);
+            error_b = compute_pass(std::exp(b), false).error;
+        }
+    }
+    this->scaling_constant = std::exp((low + high) / 2);
+}
+
+/*==============================================================================
+  Return the mean squared error of the predicted results for SCALING_CONSTANT
+  and, if WITH_GRADIENT, its gradient with respect to every parameter. Every
+  thread adds up a contiguous range of positions.
+  ==============================================================================*/
+TexelTuner::PassResult TexelTuner::compute_pass(
+    double scaling_constant, bool with_gradient) const
+{
+    size_t positions = this->results.size();
+    vector<PassResult> partial_results(this->threads_count, PassResult{});
+    vector<std::thread> threads;
+
+    size_t chunk_size = (positions + this->threads_count - 1) / this->threads_count;
+    for (uint i = 0; i < this->threads_count; ++i)
+    {
+        size_t begin = std::min(positions, i * chunk_size);
+        size_t end = std::min(positions, begin + chunk_size);
+        threads.emplace_back(
+            &TexelTuner::compute_chunk, this, scaling_constant, with_gradient, begin, end,
+            std::ref(partial_results[i]));
+    }
+
+    PassResult result = {};
+    for (uint i = 0; i < this->threads_count; ++i)
+    {
+        threads[i].join();
+        result.error += partial_results[i].error;
+        for (uint j = 0; j < PARAMETERS_COUNT; ++j)
+            result.gradient[j] += partial_results[i].gradient[j];
+    }
+
+    result.error /= std::max<size_t>(positions, 1);
+    for (uint j = 0; j < PARAMETERS_COUNT; ++j)
+        result.gradient[j] /= std::max<size_t>(positions, 1);
+
+    return result;
+}
+
+/*==============================================================================
+  Add to RESULT the squared errors (and their gradient) of positions BEGIN to
+  END. The terms are stored by column, so every position is a short sequence
+  of multiply-adds over contiguous arrays.
+  ==============================================================================*/
+void TexelTuner::compute_chunk(
+    double scaling_constant, bool with_gradient, size_t begin, size_t end,
+    PassResult &result) const
+{
+    const double *weight = this->parameters;
+    const double *piece_value = this->parameters + FIRST_PIECE_VALUE;
+
+    double error = 0.0;
+    double gradient[PARAMETERS_COUNT] = {};
+
+    for (size_t i = begin; i < end; ++i)
+    {
+        double material = 0.0;
+        for (uint piece = PAWNS; piece <= QUEENS; ++piece)
+            material += piece_value[piece] * this->terms[piece][i];
+
+        double evaluation =
+            weight[PositionEvaluator::MATERIAL] * material +
+            weight[PositionEvaluator::MOBILITY] * this->terms[MOBILITY][i] +
+            weight[PositionEvaluator::CENTER_CONTROL] * this->terms[CENTER_CONTROL][i] +
+            weight[PositionEvaluator::KING_SAFETY] * this->terms[KING_SAFETY][i];
+
+        double prediction = 1.0 / (1.0 + std::exp(-scaling_constant * evaluation));
+        double difference = prediction - this->results[i];
+        error += difference * difference;
+
+        if (!with_gradient)
+            continue;
+
+        // Derivative of the squared error with respect to the evaluation
+        double slope = 2 * difference * prediction * (1 - prediction) * scaling_constant;
+
+        gradient[PositionEvaluator::MATERIAL] += slope * material;
+        gradient[PositionEvaluator::MOBILITY] += slope * this->terms[MOBILITY][i];
+        gradient[PositionEvaluator::CENTER_CONTROL] +=
+            slope * this->terms[CENTER_CONTROL][i];
+        gradient[PositionEvaluator::KING_SAFETY] += slope * this->terms[KING_SAFETY][i];
+
+        for (uint piece = PAWNS; piece <= QUEENS; ++piece)
+            gradient[FIRST_PIECE_VALUE + piece] +=
+                slope * weight[PositionEvaluator::MATERIAL] * this->terms[piece][i];
+    }
+
+    result.error = error;
+    for (uint j = 0; j < PARAMETERS_COUNT; ++j)
+        result.gradient[j] = gradient[j];
+}
+
+} // namespace learning
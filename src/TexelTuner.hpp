@@ -0,0 +1,112 @@
+#ifndef TEXEL_TUNER_H
+#define TEXEL_TUNER_H
+
+/*==============================================================================
+  Tunes the factor weights and piece values of the evaluation function from a
+  set of positions labeled with the result of the game they were taken from
+  (Texel's tuning method), which is far cheaper than playing games to measure
+  fitness as GeneticAlgorithm does.
+
+  The evaluation is linear in the evaluation terms of a position (the material
+  difference per piece type, mobility, center control and king safety), so
+  these terms are computed once for every position while the dataset is read,
+  and kept in a compact matrix of 16-bit integers, one column per term. Every
+  step of the tuning then only needs that matrix: it predicts the result of
+  every position from its evaluation with a logistic curve, and moves the
+  weights along the gradient of the mean squared prediction error (using the
+  Adam update rule, which copes with weights of very different magnitudes).
+  Gradient passes split the positions among several threads.
+
+  The value of a pawn is never tuned, since scaling all piece values and the
+  material weight in opposite directions would not change the evaluation.
+  ==============================================================================*/
+
+#include <istream>
+#include <ostream>
+#include <vector>
+
+#include "type_aliases.hpp"
+
+namespace rules
+{
+class MaeBoard;
+}
+
+namespace engine
+{
+class PositionEvaluator;
+}
+
+namespace serialization
+{
+struct EpdRecord;
+class PositionRecordReader;
+} // namespace serialization
+
+namespace learning
+{
+class TexelTuner
+{
+  public:
+    enum Term
+    {
+        PAWNS,
+        KNIGHTS,
+        BISHOPS,
+        ROOKS,
+        QUEENS,
+        MOBILITY,
+        CENTER_CONTROL,
+        KING_SAFETY,
+        TERMS_COUNT
+    };
+
+    TexelTuner(uint threads_count);
+
+    ullong load(std::istream &dataset);
+    ullong load(const serialization::PositionRecordReader &dataset);
+    void tune(uint iterations, double learning_rate, std::ostream &report);
+
+    double get_error() const;
+    double get_scaling_constant() const;
+    std::vector<int> get_factor_weights() const;
+    std::vector<int> get_piece_values() const;
+
+    static bool read_result(const serialization::EpdRecord &, float &result);
+
+  private:
+    // Factor weights (in PositionEvaluator::Factors order), then piece values
+    // from pawn to queen
+    static const uint PARAMETERS_COUNT = 9;
+    static const uint FIRST_PIECE_VALUE = 4;
+
+    struct PassResult
+    {
+        double error;
+        double gradient[PARAMETERS_COUNT];
+    };
+
+    // Positions are read in batches, whose features are extracted at once
+    static const uint LOAD_BATCH_SIZE = 256;
+
+    void add_positions(
+        const engine::PositionEvaluator &, const rules::MaeBoard *const *boards,
+        const float *results, size_t count);
+
+    PassResult compute_pass(double scaling_constant, bool with_gradient) const;
+    void compute_chunk(
+        double scaling_constant, bool with_gradient, size_t begin, size_t end,
+        PassResult &result) const;
+    void fit_scaling_constant();
+
+    uint threads_count;
+    double scaling_constant;
+    double parameters[PARAMETERS_COUNT];
+
+    std::vector<short> terms[TERMS_COUNT];
+    std::vector<float> results;
+};
+
+} // namespace learning
+
+#endif // TEXEL_TUNER_H
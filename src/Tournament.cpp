@@ -0,0 +1,352 @@
+#include "Tournament.hpp"
+#include "AlphaBetaSearch.hpp"
+#include "FenReader.hpp"
+#include "MaeBoard.hpp"
+#include "MoveGenerator.hpp"
+#include "PgnWriter.hpp"
+#include "PositionEvaluator.hpp"
+#include "SanNotation.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace engine
+{
+using rules::IBoard;
+using rules::MaeBoard;
+using rules::Move;
+using rules::Piece;
+using serialization::FenReader;
+using serialization::PgnGame;
+using serialization::PgnWriter;
+using serialization::SanNotation;
+using std::endl;
+using std::setw;
+using std::string;
+using std::vector;
+
+namespace
+{
+const uint CANDIDATE = 0;
+const uint BASELINE = 1;
+
+// Expected score of a player that is ELO points stronger than its opponent
+double expected_score(double elo)
+{
+    return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+}
+} // anonymous namespace
+
+constexpr double TournamentResult::PAIR_SCORE_PRIOR;
+
+double SprtSettings::get_lower_bound() const
+{
+    return std::log(this->beta / (1.0 - this->alpha));
+}
+
+double SprtSettings::get_upper_bound() const
+{
+    return std::log((1.0 - this->beta) / this->alpha);
+}
+
+double TournamentResult::get_score() const
+{
+    ullong games = this->wins + this->losses + this->draws;
+    return games > 0 ? (this->wins + this->draws / 2.0) / games : 0.5;
+}
+
+double TournamentResult::get_elo() const
+{
+    double score = get_score();
+    if (score <= 0.0 || score >= 1.0)
+        return score <= 0.0 ? -std::numeric_limits<double>::infinity()
+                            : std::numeric_limits<double>::infinity();
+
+    return -400.0 * std::log10(1.0 / score - 1.0);
+}
+
+/*==============================================================================
+  Return the log-likelihood ratio of H1 against H0 given the pairs played so
+  far, approximating the distribution of pair scores by a normal distribution
+  with the observed variance.
+
+  Every pair score is counted PAIR_SCORE_PRIOR times more than it was seen.
+  Otherwise a match where every pair ends the same (e.g. 2-0, or 1-1 between
+  equal engines) has no variance, and never reaches a decision.
+  ==============================================================================*/
+double TournamentResult::get_log_likelihood_ratio(const SprtSettings &sprt) const
+{
+    if (this->pairs == 0)
+        return 0.0;
+
+    double pairs = this->pairs + 5 * PAIR_SCORE_PRIOR;
+
+    // The score of a pair, from 0 to 1
+    double mean = 0.0;
+    for (uint i = 0; i < 5; ++i)
+        mean += (this->pair_scores[i] + PAIR_SCORE_PRIOR) * (i / 4.0);
+    mean /= pairs;
+
+    double variance = 0.0;
+    for (uint i = 0; i < 5; ++i)
+        variance += (this->pair_scores[i] + PAIR_SCORE_PRIOR) * (i / 4.0 - mean) *
+                    (i / 4.0 - mean);
+    variance /= pairs;
+
+    double score0 = expected_score(sprt.elo0);
+    double score1 = expected_score(sprt.elo1);
+
+    return pairs * (score1 - score0) * (2 * mean - score0 - score1) / (2 * variance);
+}
+
+struct Tournament::Worker
+{
+    Worker()
+        : searches{
+              {&evaluators[CANDIDATE], &generator}, {&evaluators[BASELINE], &generator}}
+    {
+        searches[CANDIDATE].set_verbose(false);
+        searches[BASELINE].set_verbose(false);
+    }
+
+    MaeBoard board;
+    MoveGenerator generator;
+    PositionEvaluator referee;
+    PositionEvaluator evaluators[2];
+    AlphaBetaSearch searches[2];
+};
+
+Tournament::Tournament(uint threads_count, int max_depth, ullong node_limit)
+{
+    this->max_depth = max_depth;
+    this->sprt = SprtSettings{0.0, 10.0, 0.05, 0.05};
+    this->pgn_output = nullptr;
+
+    for (uint i = 0; i < std::max(threads_count, 1u); ++i)
+    {
+        this->workers.emplace_back(new Worker());
+        for (AlphaBetaSearch &search : this->workers.back()->searches)
+            search.set_node_limit(node_limit);
+    }
+}
+
+Tournament::~Tournament()
+{
+}
+
+void Tournament::set_players(const vector<int> &candidate, const vector<int> &baseline)
+{
+    for (auto &worker : this->workers)
+    {
+        vector<int> weights[2] = {candidate, baseline};
+        for (uint player : {CANDIDATE, BASELINE})
+        {
+            // Factor weights, optionally followed by piece values
+            vector<int> &factor_weights = weights[player];
+            vector<int> piece_values;
+            if (factor_weights.size() > PositionEvaluator::FACTORS_COUNT)
+            {
+                auto first_value =
+                    factor_weights.begin() + PositionEvaluator::FACTORS_COUNT;
+                piece_values.assign(first_value, factor_weights.end());
+                factor_weights.erase(first_value, factor_weights.end());
+            }
+            worker->evaluators[player].load_factor_weights(factor_weights);
+            worker->evaluators[player].load_piece_values(piece_values);
+        }
+    }
+}
+
+void Tournament::set_sprt(const SprtSettings &sprt)
+{
+    this->sprt = sprt;
+}
+
+/*==============================================================================
+  Write every game played from now on to OUTPUT, in PGN; no games are written
+  if OUTPUT is null
+  ==============================================================================*/
+void Tournament::set_pgn_output(std::ostream *output)
+{
+    this->pgn_output = output;
+}
+
+/*==============================================================================
+  Play pairs of games from OPENINGS (taken in turn, and which must all be valid
+  FEN positions) until the SPRT accepts a hypothesis or MAX_PAIRS have been
+  played. Write one line per pair to REPORT.
+  ==============================================================================*/
+TournamentResult Tournament::run(
+    const vector<string> &openings, ullong max_pairs, std::ostream &report)
+{
+    TournamentResult result = {};
+    assert(!openings.empty());
+
+    std::atomic<ullong> next_pair(0);
+    std::atomic<bool> is_decided(false);
+    uint running_workers = this->workers.size();
+
+    // The candidate's score in both games of the pairs finished ahead of turn
+    std::map<ullong, std::pair<double, double>> finished;
+    std::mutex mutex;
+    std::condition_variable result_ready;
+
+    auto work = [&](Worker &worker) {
+        for (ullong pair = next_pair++; pair < max_pairs && !is_decided;
+             pair = next_pair++)
+        {
+            const string &opening = openings[pair % openings.size()];
+            PgnGame games[2];
+            double first = play_game(worker, opening, Piece::WHITE, games[0]);
+            double second = play_game(worker, opening, Piece::BLACK, games[1]);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                finished[pair] = {first, second};
+
+                for (uint i = 0; i < 2 && this->pgn_output != nullptr; ++i)
+                {
+                    games[i].set_tag("Round", std::to_string(pair + 1) + "." +
+                                                  std::to_string(i + 1));
+                    PgnWriter(*this->pgn_output).write(games[i]);
+                }
+            }
+            result_ready.notify_one();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        running_workers--;
+        result_ready.notify_one();
+    };
+
+    std::vector<std::thread> threads;
+    for (auto &worker : this->workers)
+        threads.emplace_back(work, std::ref(*worker));
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!is_decided && (running_workers > 0 || !finished.empty()))
+        {
+            result_ready.wait(lock, [&] {
+                return running_workers == 0 || finished.count(result.pairs) > 0;
+            });
+
+            for (auto iter = finished.find(result.pairs);
+                 iter != finished.end() && !is_decided;
+                 iter = finished.find(result.pairs))
+            {
+                double first = iter->second.first, second = iter->second.second;
+                finished.erase(iter);
+
+                for (double score : {first, second})
+                {
+                    if (score == 1.0)
+                        result.wins++;
+                    else if (score == 0.0)
+                        result.losses++;
+                    else
+                        result.draws++;
+                }
+                result.pair_scores[(int)(2 * (first + second))]++;
+                result.pairs++;
+
+                result.log_likelihood_ratio = result.get_log_likelihood_ratio(this->sprt);
+                if (result.log_likelihood_ratio >= this->sprt.get_upper_bound())
+                    result.decision = TournamentResult::H1_ACCEPTED;
+                else if (result.log_likelihood_ratio <= this->sprt.get_lower_bound())
+                    result.decision = TournamentResult::H0_ACCEPTED;
+                is_decided = (result.decision != TournamentResult::UNDECIDED);
+
+                report << "Pair " << setw(5) << result.pairs << ": " << std::fixed
+                       << std::setprecision(1) << first << " " << second << "  +"
+                       << result.wins << " -" << result.losses << " =" << result.draws
+                       << "  LLR " << std::setprecision(2) << result.log_likelihood_ratio
+                       << endl;
+            }
+        }
+    }
+
+    for (auto &thread : threads)
+        thread.join();
+
+    return result;
+}
+
+/*==============================================================================
+  Play a game from OPENING with the candidate playing CANDIDATE_PLAYER, and
+  return the candidate's score: 1 for a win, 1/2 for a draw and 0 for a loss.
+  The game is recorded in GAME.
+  ==============================================================================*/
+double Tournament::play_game(
+    Worker &worker, const string &opening, uint candidate_player, PgnGame &game)
+{
+    IBoard *board = &worker.board;
+    if (!FenReader(opening, board).load_position())
+        abort();
+
+    game.clear();
+    game.set_tag("Event", "Tournament");
+    game.set_tag("White", candidate_player == Piece::WHITE ? "candidate" : "baseline");
+    game.set_tag("Black", candidate_player == Piece::WHITE ? "baseline" : "candidate");
+    game.set_tag("SetUp", "1");
+    game.set_tag("FEN", opening);
+
+    // The candidate's score, recorded as the result of the game
+    auto finish = [&](double score) {
+        double white_score = (candidate_player == Piece::WHITE ? score : 1.0 - score);
+        game.result =
+            (white_score == 1.0 ? "1-0" : white_score == 0.0 ? "0-1" : "1/2-1/2");
+        return score;
+    };
+
+    // Both engines start from scratch, so games do not depend on each other
+    for (AlphaBetaSearch &search : worker.searches)
+        search.clear_transposition_table();
+
+    while (true)
+    {
+        vector<Move> moves;
+        SanNotation::get_legal_moves(board, moves);
+        if (moves.empty())
+        {
+            if (!board->is_king_in_check())
+                return finish(0.5);
+            return finish(board->current_player() == candidate_player ? 0.0 : 1.0);
+        }
+
+        if (board->get_move_number() >= MAX_GAME_MOVES)
+        {
+            // Material is counted from white's point of view
+            int material = worker.referee.evaluate_material(board);
+            if (std::abs(material) < ADJUDICATION_MARGIN)
+                return finish(0.5);
+            bool is_candidate_ahead = (material > 0) == (candidate_player == Piece::WHITE);
+            return finish(is_candidate_ahead ? 1.0 : 0.0);
+        }
+
+        uint player =
+            (board->current_player() == candidate_player ? CANDIDATE : BASELINE);
+        Move move;
+        worker.searches[player].get_best_move(this->max_depth, board, move);
+        if (move.is_null())
+            move = moves.front();
+
+        if (this->pgn_output != nullptr)
+            game.moves.push_back(SanNotation::to_san(board, move));
+        IBoard::Error error = board->make_move(move, true);
+        if (error == IBoard::DRAW_BY_REPETITION)
+            return finish(0.5);
+        if (error != IBoard::NO_ERROR)
+            abort();
+    }
+}
+
+} // namespace engine
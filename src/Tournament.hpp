@@ -0,0 +1,115 @@
+#ifndef TOURNAMENT_H
+#define TOURNAMENT_H
+
+/*==============================================================================
+  Plays a match between two sets of evaluation weights, the candidate and the
+  baseline, to tell whether the candidate is stronger.
+
+  Games are played in pairs: both players get the same opening position once
+  with each color, which cancels most of the advantage a given opening gives
+  to one side. Pairs are played on several threads at once, every thread owning
+  a board and one complete engine per player.
+
+  After every pair a Sequential Probability Ratio Test (SPRT) weighs the
+  hypothesis H0 "the candidate is ELO0 stronger" against H1 "it is ELO1
+  stronger", and the match stops as soon as either one is accepted with the
+  requested error rates, so that clear results do not cost a fixed number of
+  games. The test uses the log-likelihood ratio of the generalized SPRT on the
+  five possible scores of a pair (0, 1/2, 1, 3/2 and 2 points), which accounts
+  for the correlation between the two games of a pair.
+
+  Pairs are added to the test in the order they were started, whichever thread
+  finishes first, so the decision and the number of games played are always
+  the same for the same settings. Games can be written in PGN as they finish,
+  in whatever order that is; their Round tag tells which pair they belong to.
+  ==============================================================================*/
+
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "type_aliases.hpp"
+
+namespace serialization
+{
+struct PgnGame;
+}
+
+namespace engine
+{
+struct SprtSettings
+{
+    double elo0;
+    double elo1;
+    double alpha; // Probability of accepting H1 when H0 is true
+    double beta;  // Probability of accepting H0 when H1 is true
+
+    double get_lower_bound() const;
+    double get_upper_bound() const;
+};
+
+struct TournamentResult
+{
+    enum Decision
+    {
+        UNDECIDED,
+        H0_ACCEPTED,
+        H1_ACCEPTED
+    };
+
+    // Games won, lost and drawn by the candidate
+    ullong wins;
+    ullong losses;
+    ullong draws;
+
+    // Number of pairs in which the candidate scored 0, 1/2, 1, 3/2 and 2 points
+    ullong pair_scores[5];
+    ullong pairs;
+
+    double log_likelihood_ratio;
+    Decision decision;
+
+    double get_score() const;
+    double get_elo() const;
+    double get_log_likelihood_ratio(const SprtSettings &) const;
+
+    // Pseudo-count added to every pair score by the SPRT
+    static constexpr double PAIR_SCORE_PRIOR = 0.25;
+};
+
+class Tournament
+{
+  public:
+    Tournament(uint threads_count, int max_depth, ullong node_limit);
+    ~Tournament();
+
+    void set_players(const std::vector<int> &candidate, const std::vector<int> &baseline);
+    void set_sprt(const SprtSettings &);
+    void set_pgn_output(std::ostream *output);
+
+    TournamentResult run(
+        const std::vector<std::string> &openings, ullong max_pairs,
+        std::ostream &report);
+
+    // Games still running then are adjudicated on material
+    static const uint MAX_GAME_MOVES = 150;
+    static const int ADJUDICATION_MARGIN = 300;
+
+  private:
+    struct Worker;
+
+    // CANDIDATE_PLAYER is a rules::Piece::Player
+    double play_game(
+        Worker &, const std::string &opening, uint candidate_player,
+        serialization::PgnGame &game);
+
+    int max_depth;
+    SprtSettings sprt;
+    std::ostream *pgn_output;
+    std::vector<std::unique_ptr<Worker>> workers;
+};
+
+} // namespace engine
+
+#endif // TOURNAMENT_H
@@ -1,15 +1,40 @@
 #include "TranspositionTable.hpp"
+#include "Instrumentation.hpp"
 #include "MaeBoard.hpp"
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
 #include <iostream>
+#include <linux/mempolicy.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
 
 namespace engine
 {
+using rules::BoardSquare;
+using rules::MaeBoard;
 using rules::Move;
-using std::unordered_map;
 
 using TT = TranspositionTable;
 
+namespace
+{
+const char IMAGE_MAGIC[] = "PAWNTT01";
+
+// Generations wrap around after this one, the largest a slot can record
+const uint LAST_GENERATION = 255;
+const int MAX_SLOT_DEPTH = 127;
+
+} // anonymous namespace
+
 std::map<uint, size_t> TranspositionTable::bits_to_table_size = {
     {16, 1'085'137},
     {32, 2'159'363},
@@ -24,60 +49,254 @@ size_t TranspositionTable::compute_table_size(uint size_in_bits)
     return TT::bits_to_table_size[size_in_bits];
 }
 
-BoardMap TranspositionTable::create_entries_table(uint size_in_bits)
+TranspositionTable::TranspositionTable(uint size_in_bits)
 {
-    size_t table_size = TranspositionTable::compute_table_size(size_in_bits);
-    return BoardMap(table_size, BoardHasher(table_size));
+    this->mapping = nullptr;
+    allocate(TT::compute_table_size(size_in_bits));
+
+    std::cerr << "transposition table size: " << this->slots_count
+              << (this->is_using_huge_pages ? " (huge pages)" : "") << std::endl;
 }
 
-TranspositionTable::TranspositionTable(uint size_in_bits)
-    : entries{TT::create_entries_table(size_in_bits)}
+TranspositionTable::~TranspositionTable()
 {
-    std::cerr << "transposition table size: " << this->entries.bucket_count()
-              << std::endl;
+    release();
 }
 
-bool TranspositionTable::add(const BoardKey &key, BoardEntry entry)
+/*==============================================================================
+  Get SLOTS_COUNT empty slots straight from the operating system, which hands
+  out zeroed pages (slots of generation 0) only as they are first written.
+  Reserved huge pages are tried first; few systems have them, so failing to
+  get them is normal, and then the kernel is asked to back the table with
+  transparent huge pages where it can.
+  ==============================================================================*/
+void TranspositionTable::allocate(size_t slots_count)
 {
-    auto iter = this->entries.find(key);
-    if (iter != this->entries.end())
+    const int PROTECTION = PROT_READ | PROT_WRITE;
+    const int FLAGS = MAP_PRIVATE | MAP_ANONYMOUS;
+
+    // Huge pages only come whole
+    size_t size = slots_count * sizeof(Slot);
+    this->mapping_size = (size + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+
+    this->mapping =
+        mmap(nullptr, this->mapping_size, PROTECTION, FLAGS | MAP_HUGETLB, -1, 0);
+    this->is_using_huge_pages = this->mapping != MAP_FAILED;
+
+    if (!this->is_using_huge_pages)
     {
-        // Presumably, the deeper we searched, the more reliable is the information.
-        if (entry.depth >= (*iter).second.depth)
-        {
-            (*iter).second = entry;
-            return true;
-        }
-        return false;
+        this->mapping = mmap(nullptr, this->mapping_size, PROTECTION, FLAGS, -1, 0);
+        if (this->mapping == MAP_FAILED)
+            throw std::bad_alloc();
+        madvise(this->mapping, this->mapping_size, MADV_HUGEPAGE);
     }
-    this->entries.insert(std::pair<BoardKey, BoardEntry>(key, entry));
+
+    this->slots = static_cast<Slot *>(this->mapping);
+    this->slots_count = slots_count;
+    this->generation = 1;
+}
+
+void TranspositionTable::release()
+{
+    if (this->mapping != nullptr)
+        munmap(this->mapping, this->mapping_size);
+    this->mapping = nullptr;
+}
+
+bool TranspositionTable::add(const BoardKey &key, BoardEntry entry)
+{
+    PAWN_TIME_SCOPE(TRANSPOSITION_TABLE);
+    Slot &slot = this->slots[key.hash_key % this->slots_count];
+
+    // Presumably, the deeper we searched, the more reliable is the information.
+    if (slot.generation == this->generation && slot.hash_lock == key.hash_lock &&
+        entry.depth < (int)slot.depth)
+        return false;
+
+    slot.hash_lock = key.hash_lock;
+    slot.score = entry.score;
+    slot.depth = std::min(entry.depth, MAX_SLOT_DEPTH);
+    slot.accuracy = entry.accuracy;
+    slot.generation = this->generation;
+    slot.move_from = entry.best_move.from();
+    slot.move_to = entry.best_move.to();
+    slot.move_type = entry.best_move.type();
     return true;
 }
 
 bool TranspositionTable::get(const BoardKey &key, BoardEntry &entry) const
 {
-    auto iter = this->entries.find(key);
-    if (iter != this->entries.end())
-    {
-        entry = (*iter).second;
-        return true;
-    }
-    return false;
+    PAWN_TIME_SCOPE(TRANSPOSITION_TABLE);
+    const Slot &slot = this->slots[key.hash_key % this->slots_count];
+    if (slot.generation != this->generation || slot.hash_lock != key.hash_lock)
+        return false;
+
+    entry.score = slot.score;
+    entry.depth = slot.depth;
+    entry.accuracy = Accuracy(slot.accuracy);
+    entry.best_move = Move(BoardSquare(slot.move_from), BoardSquare(slot.move_to));
+    entry.best_move.set_type(Move::Type(slot.move_type));
+    return true;
 }
 
+/*==============================================================================
+  Return the number of boards stored. This scans the whole table.
+  ==============================================================================*/
 uint TranspositionTable::size() const
 {
-    return this->entries.size();
+    uint boards = 0;
+    for (size_t i = 0; i < this->slots_count; ++i)
+        boards += this->slots[i].generation == this->generation;
+    return boards;
 }
 
 uint TranspositionTable::capacity() const
 {
-    return this->entries.bucket_count();
+    return this->slots_count;
 }
 
 void TranspositionTable::clear()
 {
-    this->entries.clear();
+    if (this->generation < LAST_GENERATION)
+    {
+        this->generation++;
+        return;
+    }
+
+    memset(this->slots, 0, this->slots_count * sizeof(Slot));
+    this->generation = 1;
+}
+
+/*==============================================================================
+  Write the table to FILE as a binary image that LOAD can map back. The image
+  is written to a temporary file first, so that FILE is never left half
+  written. Return FALSE on failure.
+  ==============================================================================*/
+bool TranspositionTable::save(const std::string &file) const
+{
+    char header_bytes[IMAGE_HEADER_SIZE] = {};
+    ImageHeader header = {};
+    memcpy(header.magic, IMAGE_MAGIC, sizeof(header.magic));
+    header.version = IMAGE_VERSION;
+    header.slot_size = sizeof(Slot);
+    header.zobrist_seed = MaeBoard::ZOBRIST_SEED;
+    header.slots_count = this->slots_count;
+    header.generation = this->generation;
+    memcpy(header_bytes, &header, sizeof(header));
+
+    std::string temporary_file = file + ".tmp";
+    {
+        std::ofstream out(temporary_file, std::ios::binary);
+        out.write(header_bytes, IMAGE_HEADER_SIZE);
+        out.write(
+            reinterpret_cast<const char *>(this->slots),
+            this->slots_count * sizeof(Slot));
+        if (!out.good())
+            return false;
+    }
+    return std::rename(temporary_file.c_str(), file.c_str()) == 0;
+}
+
+/*==============================================================================
+  Replace the table with the image in FILE, written by SAVE. The file is
+  mapped copy-on-write, so only the pages the search touches are read, and
+  the search may change them without changing the file. Return FALSE (and
+  keep the current table) if FILE is not an image made by this version of the
+  program.
+  ==============================================================================*/
+bool TranspositionTable::load(const std::string &file)
+{
+    static_assert(sizeof(ImageHeader) <= IMAGE_HEADER_SIZE, "Image header too large");
+    static_assert(sizeof(Slot) == 16, "Slots should fill cache lines evenly");
+
+    int descriptor = open(file.c_str(), O_RDONLY);
+    if (descriptor < 0)
+        return false;
+
+    ImageHeader header;
+    struct stat status;
+    bool is_valid =
+        fstat(descriptor, &status) == 0 &&
+        pread(descriptor, &header, sizeof(header), 0) == (ssize_t)sizeof(header) &&
+        memcmp(header.magic, IMAGE_MAGIC, sizeof(header.magic)) == 0 &&
+        header.version == IMAGE_VERSION && header.slot_size == sizeof(Slot) &&
+        header.zobrist_seed == MaeBoard::ZOBRIST_SEED && header.slots_count > 0 &&
+        header.generation >= 1 && header.generation <= LAST_GENERATION &&
+        (size_t)status.st_size == IMAGE_HEADER_SIZE + header.slots_count * sizeof(Slot);
+
+    void *mapping = MAP_FAILED;
+    if (is_valid)
+        mapping = mmap(
+            nullptr, status.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+
+    if (mapping == MAP_FAILED)
+        return false;
+
+    release();
+    this->mapping = mapping;
+    this->mapping_size = status.st_size;
+    this->is_using_huge_pages = false;
+    this->slots =
+        reinterpret_cast<Slot *>(static_cast<char *>(mapping) + IMAGE_HEADER_SIZE);
+    this->slots_count = header.slots_count;
+    this->generation = header.generation;
+    return true;
+}
+
+/*==============================================================================
+  Have THREADS_COUNT threads touch every page of the table, so that no search
+  pays for page faults. Under the default NUMA policy, a page lives on the
+  node of the thread that touches it first, so the table ends up spread over
+  the nodes the threads run on; if IS_INTERLEAVED, pages are dealt to all the
+  nodes in turn instead.
+  ==============================================================================*/
+void TranspositionTable::prefault(uint threads_count, bool is_interleaved)
+{
+    const size_t PAGE_SIZE = sysconf(_SC_PAGESIZE);
+
+    if (is_interleaved)
+        interleave_pages();
+
+    // Pages are written with what they hold, which keeps the slots of a loaded
+    // image and makes copies of its pages, as the first write would
+    volatile char *bytes = static_cast<char *>(this->mapping);
+    size_t pages_count = this->mapping_size / PAGE_SIZE;
+    threads_count = std::max(threads_count, 1u);
+
+    auto touch = [&](size_t first_page, size_t last_page) {
+        for (size_t page = first_page; page < last_page; ++page)
+            bytes[page * PAGE_SIZE] = bytes[page * PAGE_SIZE];
+    };
+
+    std::vector<std::thread> threads;
+    for (uint i = 0; i < threads_count; ++i)
+        threads.emplace_back(
+            touch, pages_count * i / threads_count,
+            pages_count * (i + 1) / threads_count);
+    for (auto &thread : threads)
+        thread.join();
+}
+
+/*==============================================================================
+  Ask the kernel to deal the pages of the table to all the NUMA nodes this
+  process may use, in turn. Return FALSE if it cannot, e.g. because the
+  kernel has no NUMA support; the pages then stay wherever they are put.
+  ==============================================================================*/
+bool TranspositionTable::interleave_pages()
+{
+    const ulong MAX_NODES = 1024;
+    const ulong BITS_PER_MASK_WORD = 8 * sizeof(ulong);
+
+    ulong nodes[MAX_NODES / BITS_PER_MASK_WORD] = {};
+    long error = syscall(
+        SYS_get_mempolicy, nullptr, nodes, MAX_NODES, nullptr, MPOL_F_MEMS_ALLOWED);
+    if (error != 0)
+        return false;
+
+    return syscall(
+               SYS_mbind, this->mapping, this->mapping_size, MPOL_INTERLEAVE, nodes,
+               MAX_NODES, 0) == 0;
 }
 
 } // namespace engine
@@ -3,11 +3,29 @@
 
 /*==============================================================================
   Implements a transposition table, used to improve performance of search
-  algorithms such as iterative deepening search
+  algorithms such as iterative deepening search.
+
+  The table is a flat array of 16-byte slots, one per bucket, indexed by the
+  hash key of a board and checked against its hash lock. A slot holds the
+  deepest search of the last board stored in it. Clearing the table only
+  starts a new generation: slots of older generations count as empty.
+
+  Being flat, the table can be saved as a binary image and mapped back into
+  memory by a later process, which then resumes with the analysis of the
+  previous one at no cost. The image starts with a header recording the
+  format version and Zobrist seed it was made with, since the keys in it mean
+  nothing to a program that hashes boards differently.
+
+  Probes land anywhere in the table, so with 4 KiB pages most of them miss
+  the TLB. The table is therefore allocated in 2 MiB huge pages: reserved
+  ones (MAP_HUGETLB) if the system has any to spare, transparent ones
+  otherwise, or plain pages if the kernel refuses both. On machines with
+  several NUMA nodes, PREFAULT places the pages before searching, spread over
+  the nodes by first touch from several threads or by interleaving.
   ==============================================================================*/
 
 #include <map>
-#include <unordered_map>
+#include <string>
 
 #include "BoardKey.hpp"
 #include "Move.hpp"
@@ -32,39 +50,11 @@ struct BoardEntry
     rules::Move best_move;
 };
 
-// This maps boards to a bucket in the hash table
-class BoardHasher
-{
-  public:
-    BoardHasher(size_t size_in_bits) : size_in_bits{size_in_bits}
-    {
-    }
-
-    size_t operator()(const BoardKey &key) const
-    {
-        return (size_t)(key.hash_key % size_in_bits);
-    }
-
-  private:
-    size_t size_in_bits;
-};
-
-// This helps differentiate between Boards that mapped to the same bucket
-class BoardHashComparer
-{
-  public:
-    bool operator()(const BoardKey &key, const BoardKey &other_key) const
-    {
-        return key.hash_lock == other_key.hash_lock;
-    }
-};
-
-using BoardMap = std::unordered_map<BoardKey, BoardEntry, BoardHasher, BoardHashComparer>;
-
 class TranspositionTable
 {
   public:
     TranspositionTable(uint size_in_bits);
+    ~TranspositionTable();
 
     bool add(const BoardKey &, BoardEntry);
     void clear();
@@ -73,16 +63,63 @@ class TranspositionTable
     uint size() const;
     uint capacity() const;
 
+    bool save(const std::string &file) const;
+    bool load(const std::string &file);
+
+    void prefault(uint threads_count, bool is_interleaved);
+
     static const uint DEFAULT_SIZE_IN_BITS = 64;
     static std::map<uint, size_t> bits_to_table_size;
 
     static size_t compute_table_size(uint size_in_bits);
-    static BoardMap create_entries_table(uint size_in_bits);
 
   private:
-    BoardMap entries;
+    TranspositionTable(const TranspositionTable &) = delete;
+    TranspositionTable &operator=(const TranspositionTable &) = delete;
+
+    struct Slot
+    {
+        ullong hash_lock;
+        int score;
+        uint depth : 7;
+        uint accuracy : 2;
+        uint generation : 8;
+        uint move_from : 6;
+        uint move_to : 6;
+        uint move_type : 3;
+    };
+
+    struct ImageHeader
+    {
+        char magic[8];
+        uint version;
+        uint slot_size;
+        ullong zobrist_seed;
+        ullong slots_count;
+        uint generation;
+    };
+
+    // Images are written with the header padded to this size, so that the
+    // slots that follow stay aligned when the file is mapped
+    static const size_t IMAGE_HEADER_SIZE = 64;
+    static const uint IMAGE_VERSION = 1;
+
+    static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    void allocate(size_t slots_count);
+    void release();
+    bool interleave_pages();
+
+    Slot *slots;
+    size_t slots_count;
+    uint generation;
+
+    // The memory mapping holding the slots, which may start with an image header
+    void *mapping;
+    size_t mapping_size;
+    bool is_using_huge_pages;
 };
 
 } // namespace engine
 
-#endif // HASH_TRANSPOSITION_TABLE_H
+#endif // TRANSPOSITION_TABLE_H
@@ -30,6 +30,22 @@ UserCommand::UserCommand(string &notation)
     if (UserCommand::notation_to_key.find(notation) != UserCommand::notation_to_key.end())
         this->key = UserCommand::notation_to_key[notation];
 
+    else if (notation.compare(0, 6, "train ") == 0)
+    {
+        this->key = TRAIN;
+    }
+    else if (notation.compare(0, 5, "book ") == 0)
+    {
+        this->key = BOOK;
+    }
+    else if (notation.compare(0, 11, "save-table ") == 0)
+    {
+        this->key = SAVE_TABLE;
+    }
+    else if (notation.compare(0, 11, "load-table ") == 0)
+    {
+        this->key = LOAD_TABLE;
+    }
     else if (
         notation.find("usermove") != string::npos &&
         notation.find("accepted") == string::npos)
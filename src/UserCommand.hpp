@@ -30,6 +30,9 @@ class UserCommand
         REMOVE,
         MOVE,
         TRAIN,
+        BOOK,
+        SAVE_TABLE,
+        LOAD_TABLE,
         COMPUTER_PLAY,
         UNKNOWN
     };
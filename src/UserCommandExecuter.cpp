@@ -1,16 +1,22 @@
 #include "UserCommandExecuter.hpp"
+#include "Chromosome.hpp"
 #include "FitnessEvaluator.hpp"
 #include "GeneticAlgorithm.hpp"
 #include "IBoard.hpp"
 #include "IEngine.hpp"
 #include "Move.hpp"
 #include "MoveGenerator.hpp"
+#include "OpeningBook.hpp"
 #include "Timer.hpp"
 #include "UserCommand.hpp"
+#include "util.hpp"
 
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 #include <memory>
+#include <sstream>
+#include <thread>
 #include <vector>
 
 namespace game_ui
@@ -29,6 +35,8 @@ using learning::Chromosome;
 using learning::FitnessEvaluator;
 using learning::GeneticAlgorithm;
 
+const char *const UserCommandExecuter::DEFAULT_BOOK_FILE = "book.bin";
+
 UserCommandExecuter::UserCommandExecuter(
     IBoard *board, IEngine *engine, diagnostics::Timer *timer)
 {
@@ -36,6 +44,18 @@ UserCommandExecuter::UserCommandExecuter(
     this->board = board;
     this->engine = engine;
     this->move_generator = new engine::MoveGenerator();
+
+    // The book is optional: without one, every move is searched
+    this->book = new engine::OpeningBook();
+    this->book->open(DEFAULT_BOOK_FILE);
+    this->random = new util::Random(util::random_ullong());
+}
+
+UserCommandExecuter::~UserCommandExecuter()
+{
+    delete this->move_generator;
+    delete this->book;
+    delete this->random;
 }
 
 bool UserCommandExecuter::execute(const UserCommand &command)
@@ -78,11 +98,50 @@ bool UserCommandExecuter::execute(const UserCommand &command)
         break;
 
     case UserCommand::TRAIN:
+    {
+        // train [--resume <checkpoint-file>]
+        std::istringstream arguments(command.get_notation());
+        string word, resume_file;
+        while (arguments >> word)
+            if (word == "--resume")
+                arguments >> resume_file;
+
+        // Mutation flips about one gene of every feature
         train_by_genetic_algorithm(
             /* population_size: */ 6,
             /* generations_count: */ 15,
-            /* mutation_probability: */ 0.004);
+            /* mutation_probability: */ 1.0 / Chromosome::BITS_PER_FEATURE, resume_file);
+        break;
+    }
+
+    case UserCommand::BOOK:
+    {
+        // book <polyglot-file>
+        string file = command.get_notation().substr(5);
+        if (this->book->open(file))
+            cerr << "Opening book with " << this->book->size() << " entries" << std::endl;
+        else
+            cerr << "Cannot open book " << file << std::endl;
         break;
+    }
+
+    case UserCommand::SAVE_TABLE:
+    {
+        // save-table <file>
+        string file = command.get_notation().substr(11);
+        if (!this->engine->save_transposition_table(file))
+            cerr << "Cannot write to " << file << std::endl;
+        break;
+    }
+
+    case UserCommand::LOAD_TABLE:
+    {
+        // load-table <file>
+        string file = command.get_notation().substr(11);
+        if (!this->engine->load_transposition_table(file))
+            cerr << "Cannot load a transposition table from " << file << std::endl;
+        break;
+    }
 
     default:
         break;
@@ -153,6 +212,25 @@ void UserCommandExecuter::make_user_move(const string &command)
     }
 }
 
+/*==============================================================================
+    Play a move from the opening book, if the position is in it, and
+    communicate it to the GUI. Return false if a search is needed instead.
+  ==============================================================================*/
+bool UserCommandExecuter::play_book_move()
+{
+    Move book_move;
+
+    if (!this->book->is_open() || !this->book->get_move(*board, *random, book_move))
+        return false;
+
+    // Keys may collide, so check the move like one made by the user
+    if (this->board->make_move(book_move, false) != IBoard::NO_ERROR)
+        return false;
+
+    cout << "move " << book_move.to_notation() << std::endl;
+    return true;
+}
+
 /*==============================================================================
     Query the engine for the most promising move and communicate the response
     to the GUI. It also communicates check mates and draws.
@@ -162,6 +240,9 @@ void UserCommandExecuter::think()
     Move best_move;
     uint depth = 5;
 
+    if (play_book_move())
+        return;
+
     IEngine::GameResult result = this->engine->get_best_move(depth, board, best_move);
 
     if (result == IEngine::NORMAL_EVALUATION || result == IEngine::BLACK_MATES ||
@@ -226,11 +307,17 @@ void UserCommandExecuter::think()
     }
 }
 
+/*==============================================================================
+  Run the genetic algorithm from scratch or, if RESUME_FILE is given, from the
+  checkpoint saved there by an earlier run. The run is checkpointed after
+  every generation, to RESUME_FILE or to the default checkpoint file.
+  ==============================================================================*/
 void UserCommandExecuter::train_by_genetic_algorithm(
-    uint population_size, uint n_generations, double mutation_probability)
+    uint population_size, uint n_generations, double mutation_probability,
+    const string &resume_file)
 {
     std::unique_ptr<FitnessEvaluator> fitness_evaluator(
-        new FitnessEvaluator(this->engine));
+        new FitnessEvaluator(std::max(std::thread::hardware_concurrency(), 1u)));
 
     std::unique_ptr<GeneticAlgorithm> algorithm(new GeneticAlgorithm(
         population_size, n_generations, mutation_probability, fitness_evaluator.get()));
@@ -243,6 +330,14 @@ void UserCommandExecuter::train_by_genetic_algorithm(
     Chromosome seed(features_a);
 
     algorithm->set_seed(seed);
+
+    if (!resume_file.empty() && !algorithm->load_checkpoint(resume_file))
+    {
+        cerr << "Cannot resume training from " << resume_file << std::endl;
+        return;
+    }
+    algorithm->set_checkpoint_file(
+        resume_file.empty() ? GeneticAlgorithm::DEFAULT_CHECKPOINT_FILE : resume_file);
     algorithm->run();
 
     vector<int> best_features;
@@ -12,6 +12,7 @@ namespace engine
 {
 class IEngine;
 class IMoveGenerator;
+class OpeningBook;
 } // namespace engine
 
 namespace diagnostics
@@ -19,6 +20,11 @@ namespace diagnostics
 class Timer;
 }
 
+namespace util
+{
+class Random;
+}
+
 namespace game_ui
 {
 using std::string;
@@ -29,19 +35,26 @@ class UserCommandExecuter
 {
   public:
     UserCommandExecuter(rules::IBoard *, engine::IEngine *, diagnostics::Timer *);
+    ~UserCommandExecuter();
 
     bool execute(const UserCommand &);
     void show_possible_moves();
     void make_user_move(const string &command);
     void think();
+    bool play_book_move();
     void train_by_genetic_algorithm(
-        uint population_size, uint generations_count, double mutation_probability);
+        uint population_size, uint generations_count, double mutation_probability,
+        const string &resume_file);
 
   private:
     diagnostics::Timer *timer;
     rules::IBoard *board;
     engine::IEngine *engine;
     engine::IMoveGenerator *move_generator;
+    engine::OpeningBook *book;
+    util::Random *random;
+
+    static const char *const DEFAULT_BOOK_FILE;
 };
 
 } // namespace game_ui
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <bitset>
 #include <random>
+#include <vector>
 
 namespace bits
 {
@@ -196,15 +197,6 @@ int lsb_position(bitboard bits)
     return position;
 }
 
-std::vector<bitboard> create_square_to_bitboard_map()
-{
-    bitboard one = 1;
-    std::vector<bitboard> result;
-    for (uint i = 0; i < BITS_IN_BITBOARD; ++i)
-        result.push_back(one << i);
-    return result;
-}
-
 bitboard random_bitboard(uint ones_count)
 {
     // We want to generate a bitboard with `ones_count` 1s at random positions
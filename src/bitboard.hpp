@@ -2,7 +2,6 @@
 #define BITBOARD_H_
 
 #include "type_aliases.hpp"
-#include <vector>
 
 namespace bits
 {
@@ -21,8 +20,30 @@ uint count_ones_adaptive(bitboard bits);
 int msb_position(bitboard bits);
 int lsb_position(bitboard bits);
 
-std::vector<bitboard> create_square_to_bitboard_map();
-const std::vector<bitboard> to_bitboard = create_square_to_bitboard_map();
+/*==============================================================================
+  Bitboards with a single square set, indexed by square. The table is built at
+  compile time, so it can be used during static initialization and in other
+  constant expressions (e.g. when computing the move tables of the pieces).
+  ==============================================================================*/
+struct SquareBitboards
+{
+    bitboard square[BITS_IN_BITBOARD];
+
+    constexpr bitboard operator[](uint index) const
+    {
+        return this->square[index];
+    }
+};
+
+constexpr SquareBitboards create_square_to_bitboard_map()
+{
+    SquareBitboards result = {};
+    for (uint i = 0; i < BITS_IN_BITBOARD; ++i)
+        result.square[i] = ONE << i;
+    return result;
+}
+
+constexpr SquareBitboards to_bitboard = create_square_to_bitboard_map();
 
 bitboard random_bitboard(uint ones_count);
 } // namespace bits
@@ -1,9 +1,12 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <thread>
 
 #include "AlphaBetaSearch.hpp"
-#include "IMoveGenerator.hpp"
+#include "Bitbases.hpp"
+#include "CommandLine.hpp"
+#include "CommandLineExecuter.hpp"
 #include "MaeBoard.hpp"
 #include "MoveGenerator.hpp"
 #include "PositionEvaluator.hpp"
@@ -22,29 +25,55 @@ using rules::Move;
 using rules::Piece;
 
 using engine::AlphaBetaSearch;
+using engine::Bitbases;
 using engine::IEngine;
-using engine::IMoveGenerator;
-using engine::IPositionEvaluator;
 using engine::MoveGenerator;
 using engine::PositionEvaluator;
 
+using game_ui::CommandLine;
+using game_ui::CommandLineExecuter;
 using game_ui::UserCommand;
 using game_ui::UserCommandExecuter;
 using game_ui::UserCommandReader;
 
 using diagnostics::Timer;
 
-int main()
+int main(int argc, char **argv)
 {
+    CommandLine command_line(argc, argv);
+    if (!command_line.is_interactive())
+        return CommandLineExecuter().execute(command_line);
+
+    // The NUMA placement of the transposition table: first touch by all the
+    // cores, or pages dealt to all the nodes in turn
+    std::string numa_policy = command_line.get_option("numa", std::string("first-touch"));
+    if (!command_line.is_valid() ||
+        (numa_policy != "first-touch" && numa_policy != "interleave"))
+    {
+        cerr << "usage: pawn [--numa first-touch|interleave]" << endl;
+        return 1;
+    }
+
     bool auto_play = true;
     bool xboard_mode = false;
 
     unique_ptr<IBoard> board(new MaeBoard());
-    unique_ptr<IPositionEvaluator> position_evaluator(new PositionEvaluator());
-    unique_ptr<IMoveGenerator> generator(new MoveGenerator());
-    unique_ptr<IEngine> engine(
+    unique_ptr<PositionEvaluator> position_evaluator(new PositionEvaluator());
+    unique_ptr<MoveGenerator> generator(new MoveGenerator());
+    unique_ptr<AlphaBetaSearch> search(
         new AlphaBetaSearch(position_evaluator.get(), generator.get()));
 
+    // Bitbases are optional, like the opening book
+    unique_ptr<Bitbases> bitbases(new Bitbases());
+    if (bitbases->load_directory("bitbases") > 0)
+        search->set_bitbases(bitbases.get());
+
+    // Fault the table in with all the cores now rather than during the first
+    // searches, spreading its pages over the NUMA nodes of the machine
+    search->prefault_transposition_table(
+        std::thread::hardware_concurrency(), numa_policy == "interleave");
+    unique_ptr<IEngine> engine(std::move(search));
+
     unique_ptr<Timer> timer(new Timer);
 
     UserCommand command;
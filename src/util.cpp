@@ -26,4 +26,51 @@ double random(double low, double high)
     return (rand() / static_cast<double>(RAND_MAX)) * (high - low) + low;
 }
 
+Random::Random(ullong seed)
+{
+    // SplitMix64 spreads any seed, even 0, over the whole state
+    for (ullong &word : this->state)
+        word = splitmix64(seed);
+}
+
+ullong Random::next()
+{
+    auto rotate_left = [](ullong x, int k) { return (x << k) | (x >> (64 - k)); };
+
+    ullong result = rotate_left(this->state[1] * 5, 7) * 9;
+    ullong t = this->state[1] << 17;
+
+    this->state[2] ^= this->state[0];
+    this->state[3] ^= this->state[1];
+    this->state[1] ^= this->state[2];
+    this->state[0] ^= this->state[3];
+    this->state[2] ^= t;
+    this->state[3] = rotate_left(this->state[3], 45);
+
+    return result;
+}
+
+// Return a number in [0, BOUND), which must not be 0
+ullong Random::next_below(ullong bound)
+{
+    return next() % bound;
+}
+
+// Return a number in [0, 1) with the 53 bits of precision of a double
+double Random::next_double()
+{
+    return (next() >> 11) * (1.0 / (1uLL << 53));
+}
+
+// The state is all it takes to continue the same sequence later on
+void Random::get_state(ullong state[STATE_SIZE]) const
+{
+    std::copy(this->state, this->state + STATE_SIZE, state);
+}
+
+void Random::set_state(const ullong state[STATE_SIZE])
+{
+    std::copy(state, state + STATE_SIZE, this->state);
+}
+
 } // namespace util
@@ -3,6 +3,8 @@
 
 #include "type_aliases.hpp"
 #include <climits>
+#include <istream>
+#include <ostream>
 
 namespace util
 {
@@ -18,6 +20,55 @@ double random(double low, double high);
 ullong random_ullong();
 bool is_odd(uint n);
 
+/*==============================================================================
+  Advance STATE and return the next number of the SplitMix64 sequence: a
+  small, fast generator whose output only depends on the initial STATE, so it
+  gives the same numbers on every platform and can run at compile time
+  ==============================================================================*/
+constexpr ullong splitmix64(ullong &state)
+{
+    ullong z = (state += 0x9E3779B97F4A7C15uLL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9uLL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBuLL;
+    return z ^ (z >> 31);
+}
+
+/*==============================================================================
+  Write VALUE to OUT, or read it from IN, as the bytes it is made of in memory,
+  for binary files that are only read back on the same kind of host
+  ==============================================================================*/
+template <class T> void write_binary(std::ostream &out, const T &value)
+{
+    out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <class T> bool read_binary(std::istream &in, T &value)
+{
+    return static_cast<bool>(in.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+
+/*==============================================================================
+  A fast pseudo-random number generator (xoshiro256**) for the learning code,
+  which draws many numbers and needs to reproduce a run from its seed. Unlike
+  rand(), every instance has its own state, so threads need no locking.
+  ==============================================================================*/
+class Random
+{
+  public:
+    explicit Random(ullong seed);
+
+    ullong next();
+    ullong next_below(ullong bound);
+    double next_double();
+
+    static const uint STATE_SIZE = 4;
+    void get_state(ullong state[STATE_SIZE]) const;
+    void set_state(const ullong state[STATE_SIZE]);
+
+  private:
+    ullong state[STATE_SIZE];
+};
+
 } // namespace util
 
 #endif // UTIL_H
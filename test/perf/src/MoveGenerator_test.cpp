@@ -0,0 +1,156 @@
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "../../catch.hpp"
+#include "Benchmark.hpp"
+#include "FenReader.hpp"
+#include "MaeBoard.hpp"
+#include "MoveGenerator.hpp"
+#include "PositionEvaluator.hpp"
+#include "microbenchmark.hpp"
+
+namespace
+{
+using engine::Benchmark;
+using engine::IMoveGenerator;
+using engine::MoveGenerator;
+using engine::PositionEvaluator;
+using rules::BoardSquare;
+using rules::IBoard;
+using rules::MaeBoard;
+using rules::Move;
+using serialization::FenReader;
+using std::cout;
+using std::endl;
+using std::vector;
+
+// Times over the corpus in every timed run, so that runs last a few milliseconds
+const uint ROUNDS = 200;
+
+/*==============================================================================
+  The positions of the search benchmark, which mix openings, middlegames and
+  endgames, with and without castling privileges and en-passant captures.
+  ==============================================================================*/
+vector<std::unique_ptr<MaeBoard>> load_corpus()
+{
+    vector<std::unique_ptr<MaeBoard>> boards;
+    for (auto &position : Benchmark::positions)
+    {
+        boards.emplace_back(new MaeBoard());
+        REQUIRE(FenReader(position, boards.back().get()).load_position());
+    }
+    return boards;
+}
+
+TEST_CASE("::engine::MoveGenerator (perf)", "[movegen][perf]")
+{
+    const ushort QUIESCENCE_MOVES =
+        IMoveGenerator::CAPTURES | IMoveGenerator::CHECKS |
+        IMoveGenerator::CHECK_EVASIONS | IMoveGenerator::PAWN_PROMOTIONS;
+
+    vector<std::unique_ptr<MaeBoard>> boards = load_corpus();
+    MoveGenerator generator;
+    PositionEvaluator evaluator;
+    vector<Move> moves;
+
+    // The legal moves of every position, to make and undo
+    vector<vector<Move>> legal_moves(boards.size());
+    ullong legal_moves_count = 0;
+    for (uint i = 0; i < boards.size(); ++i)
+    {
+        generator.generate_moves(boards[i].get(), moves);
+        for (Move &move : moves)
+            if (boards[i]->make_move(move, true) != IBoard::KING_LEFT_IN_CHECK)
+            {
+                boards[i]->undo_move();
+                legal_moves[i].push_back(move);
+            }
+        moves.clear();
+        legal_moves_count += legal_moves[i].size();
+    }
+
+    const ullong BOARD_OPERATIONS = ROUNDS * boards.size();
+    const ullong SQUARE_OPERATIONS = BOARD_OPERATIONS * rules::BOARD_SQUARES_COUNT;
+
+    perf::print_header("move generation benchmark", cout);
+
+    perf::print(
+        "generate_moves (all)", perf::measure(BOARD_OPERATIONS, [&]() {
+            ullong count = 0;
+            for (uint round = 0; round < ROUNDS; ++round)
+                for (auto &board : boards)
+                {
+                    moves.clear();
+                    generator.generate_moves(board.get(), moves);
+                    count += moves.size();
+                }
+            return count;
+        }),
+        cout);
+
+    perf::print(
+        "generate_moves (quiescence)", perf::measure(BOARD_OPERATIONS, [&]() {
+            ullong count = 0;
+            for (uint round = 0; round < ROUNDS; ++round)
+                for (auto &board : boards)
+                {
+                    moves.clear();
+                    generator.generate_moves(board.get(), moves, QUIESCENCE_MOVES);
+                    count += moves.size();
+                }
+            return count;
+        }),
+        cout);
+
+    perf::print(
+        "make_move + undo_move", perf::measure(ROUNDS * legal_moves_count, [&]() {
+            ullong count = 0;
+            for (uint round = 0; round < ROUNDS; ++round)
+                for (uint i = 0; i < boards.size(); ++i)
+                    for (Move move : legal_moves[i])
+                    {
+                        boards[i]->make_move(move, true);
+                        count += boards[i]->undo_move();
+                    }
+            return count;
+        }),
+        cout);
+
+    perf::print(
+        "attacks_to", perf::measure(SQUARE_OPERATIONS, [&]() {
+            ullong attackers = 0;
+            for (uint round = 0; round < ROUNDS; ++round)
+                for (auto &board : boards)
+                    for (uint square = 0; square < rules::BOARD_SQUARES_COUNT; ++square)
+                        attackers ^= board->attacks_to(BoardSquare(square), true);
+            return attackers;
+        }),
+        cout);
+
+    perf::print(
+        "is_king_in_check", perf::measure(BOARD_OPERATIONS, [&]() {
+            ullong checks = 0;
+            for (uint round = 0; round < ROUNDS; ++round)
+                for (auto &board : boards)
+                    checks += board->is_king_in_check();
+            return checks;
+        }),
+        cout);
+
+    perf::print(
+        "static_evaluation", perf::measure(BOARD_OPERATIONS, [&]() {
+            ullong scores = 0;
+            for (uint round = 0; round < ROUNDS; ++round)
+                for (auto &board : boards)
+                    scores += evaluator.static_evaluation(board.get());
+            return scores;
+        }),
+        cout);
+
+    cout << endl;
+    cout << "(" << boards.size() << " positions, " << legal_moves_count
+         << " legal moves)" << endl;
+}
+
+} // anonymous namespace
@@ -1,11 +1,10 @@
-#include <ctime>
 #include <functional>
-#include <iomanip>
 #include <iostream>
-#include <random>
+#include <vector>
 
 #include "../../catch.hpp"
 #include "bitboard.hpp"
+#include "microbenchmark.hpp"
 
 namespace
 {
@@ -14,20 +13,6 @@ using bits::random_bitboard;
 using std::cout;
 using std::endl;
 
-double benchmark_count_ones(
-    std::function<uint(bits::bitboard)> count_ones, std::vector<bits::bitboard> values)
-{
-    const uint TRIALS = 10;
-    clock_t start = clock();
-    for (auto value : values)
-    {
-        for (uint i = 0; i < TRIALS; i++)
-            REQUIRE(count_ones(value) != 0);
-    }
-    clock_t end = clock();
-    return (double)(end - start) / CLOCKS_PER_SEC;
-}
-
 std::vector<bits::bitboard> generate_bitboards()
 {
     std::vector<bits::bitboard> result;
@@ -43,31 +28,38 @@ std::vector<bits::bitboard> generate_bitboards()
     return result;
 }
 
-void print_aligned(const std::string &prefix, double value)
-{
-    cout << std::setw(20) << std::left << prefix << value << endl;
-}
-
 TEST_CASE("utils::count_ones (perf)", "[bits][perf]")
 {
-    std::vector<bits::bitboard> tests = generate_bitboards();
-    double sideways_time = benchmark_count_ones(&bits::count_ones, tests);
-    double std_time = benchmark_count_ones(&bits::count_ones_std, tests);
-    double baseline_time = benchmark_count_ones(&bits::count_ones_baseline, tests);
-    double shift_time = benchmark_count_ones(&bits::count_ones_shift, tests);
-    double adaptive_time = benchmark_count_ones(&bits::count_ones_adaptive, tests);
+    const std::vector<bits::bitboard> tests = generate_bitboards();
+    const std::vector<std::pair<const char *, std::function<uint(bits::bitboard)>>>
+        variants = {{"sideways sum", &bits::count_ones},
+                    {"std library", &bits::count_ones_std},
+                    {"baseline", &bits::count_ones_baseline},
+                    {"shift", &bits::count_ones_shift},
+                    {"adaptive", &bits::count_ones_adaptive}};
+
+    perf::print_header("utils::count_ones benchmark", cout);
 
-    cout << "+-----------------------------+" << endl;
-    cout << "| utils::count_ones benchmark |" << endl;
-    cout << "+-----------------------------+" << endl;
+    ullong expected = 0;
+    for (auto &variant : variants)
+    {
+        auto count_ones = variant.second;
+        auto batch = [&]() {
+            ullong ones = 0;
+            for (auto value : tests)
+                ones += count_ones(value);
+            return ones;
+        };
+
+        // All the variants count the same ones, outside of the timed runs
+        ullong ones = batch();
+        if (expected == 0)
+            expected = ones;
+        REQUIRE(ones == expected);
 
-    print_aligned("sideways sum: ", sideways_time);
-    print_aligned("std library: ", std_time);
-    print_aligned("baseline: ", baseline_time);
-    print_aligned("shift: ", shift_time);
-    print_aligned("adaptive: ", adaptive_time);
+        perf::print(variant.first, perf::measure(tests.size(), batch), cout);
+    }
     cout << endl;
-    cout << "(all times in seconds)" << endl;
 }
 
 } // anonymous namespace
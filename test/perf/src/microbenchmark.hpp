@@ -0,0 +1,90 @@
+#ifndef MICROBENCHMARK_H
+#define MICROBENCHMARK_H
+
+/*==============================================================================
+  Times small operations precisely enough to compare implementations: a
+  batch of operations is run a few times untimed, to warm up caches and
+  branch predictors, and then timed repeatedly with a monotonic clock. The
+  mean, standard deviation and minimum time per operation over the timed
+  repetitions tell how fast the operation is and how far to trust the number.
+
+  Batches return a value computed from the results of their operations,
+  which is stored in a volatile variable so that the compiler cannot drop
+  the operations as useless.
+  ==============================================================================*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <ostream>
+#include <string>
+
+#include "type_aliases.hpp"
+
+namespace perf
+{
+// In nanoseconds per operation
+struct Measurement
+{
+    double mean;
+    double deviation;
+    double minimum;
+};
+
+const uint WARMUP_RUNS = 3;
+const uint TIMED_RUNS = 15;
+
+/*==============================================================================
+  Measure BATCH, a function that performs OPERATIONS operations and returns a
+  value computed from their results.
+  ==============================================================================*/
+template <class Batch> Measurement measure(ullong operations, Batch batch)
+{
+    volatile ullong sink;
+    for (uint i = 0; i < WARMUP_RUNS; ++i)
+        sink = batch();
+
+    double times[TIMED_RUNS];
+    for (uint i = 0; i < TIMED_RUNS; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        sink = batch();
+        std::chrono::duration<double, std::nano> elapsed =
+            std::chrono::steady_clock::now() - start;
+        times[i] = elapsed.count() / operations;
+    }
+    (void)sink;
+
+    Measurement measurement = {};
+    measurement.minimum = *std::min_element(times, times + TIMED_RUNS);
+    for (double time : times)
+        measurement.mean += time / TIMED_RUNS;
+    for (double time : times)
+        measurement.deviation += (time - measurement.mean) * (time - measurement.mean);
+    measurement.deviation = std::sqrt(measurement.deviation / (TIMED_RUNS - 1));
+    return measurement;
+}
+
+inline void print_header(const std::string &title, std::ostream &out)
+{
+    std::string rule(title.size() + 4, '-');
+    out << "+" << rule << "+" << std::endl;
+    out << "|  " << title << "  |" << std::endl;
+    out << "+" << rule << "+" << std::endl;
+    out << std::setw(32) << std::left << "operation" << std::setw(12) << std::right
+        << "ns/op" << std::setw(10) << "+/-" << std::setw(12) << "min" << std::endl;
+}
+
+inline void print(
+    const std::string &name, const Measurement &measurement, std::ostream &out)
+{
+    out << std::setw(32) << std::left << name << std::right << std::fixed
+        << std::setprecision(2) << std::setw(12) << measurement.mean << std::setw(9)
+        << 100 * measurement.deviation / measurement.mean << "%" << std::setw(12)
+        << measurement.minimum << std::endl;
+}
+
+} // namespace perf
+
+#endif // MICROBENCHMARK_H
@@ -0,0 +1,89 @@
+#include "../../catch.hpp"
+#include "Bitbases.hpp"
+#include "FenReader.hpp"
+#include "MaeBoard.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+using engine::Bitbases;
+using rules::MaeBoard;
+using serialization::FenReader;
+
+// Generated once for all the sections; KPK brings in KQK, which its
+// promotions turn into
+const Bitbases &get_bitbases()
+{
+    static Bitbases bitbases;
+    static bool is_generated = false;
+    if (!is_generated)
+    {
+        std::ostringstream report;
+        uint threads = std::max(std::thread::hardware_concurrency(), 1u);
+        REQUIRE(bitbases.generate("KPK", threads, report));
+        is_generated = true;
+    }
+    return bitbases;
+}
+
+Bitbases::Result probe(const char *fen)
+{
+    MaeBoard board;
+    REQUIRE(FenReader(fen, &board).load_position());
+
+    Bitbases::Result result = Bitbases::INVALID;
+    REQUIRE(get_bitbases().probe(board, result));
+    return result;
+}
+
+TEST_CASE("::engine::Bitbases")
+{
+    SECTION("Rook pawns draw against a king in front of them", "[bitbases]")
+    {
+        REQUIRE(probe("k7/8/K7/P7/8/8/8/8 w - -") == Bitbases::DRAW);
+        REQUIRE(probe("k7/8/K7/P7/8/8/8/8 b - -") == Bitbases::DRAW);
+        REQUIRE(probe("8/k7/8/8/8/8/P7/K7 w - -") == Bitbases::DRAW);
+        REQUIRE(probe("7k/8/8/8/8/8/7P/7K w - -") == Bitbases::DRAW);
+    }
+
+    SECTION("The opposition decides pawn endings", "[bitbases]")
+    {
+        // Whoever has to move gives the opposition away
+        REQUIRE(probe("4k3/8/3KP3/8/8/8/8/8 w - -") == Bitbases::WIN);
+        REQUIRE(probe("4k3/8/3KP3/8/8/8/8/8 b - -") == Bitbases::DRAW);
+
+        // A king on the sixth row in front of its pawn wins anyway
+        REQUIRE(probe("4k3/8/4K3/4P3/8/8/8/8 w - -") == Bitbases::WIN);
+        REQUIRE(probe("4k3/8/4K3/4P3/8/8/8/8 b - -") == Bitbases::LOSS);
+    }
+
+    SECTION("Stalemates in the corner are draws", "[bitbases]")
+    {
+        REQUIRE(probe("k7/P7/1K6/8/8/8/8/8 b - -") == Bitbases::DRAW);
+        REQUIRE(probe("7k/7P/6K1/8/8/8/8/8 b - -") == Bitbases::DRAW);
+        REQUIRE(probe("k7/8/1Q6/8/8/8/8/K7 b - -") == Bitbases::DRAW);
+        REQUIRE(probe("7k/8/6Q1/8/8/8/8/7K b - -") == Bitbases::DRAW);
+    }
+
+    SECTION("A queen wins unless it is lost at once", "[bitbases]")
+    {
+        REQUIRE(probe("k7/8/8/8/8/8/8/KQ6 w - -") == Bitbases::WIN);
+        REQUIRE(probe("k7/8/8/8/8/8/8/KQ6 b - -") == Bitbases::LOSS);
+        REQUIRE(probe("8/8/8/8/3k4/3Q4/8/7K b - -") == Bitbases::DRAW);
+    }
+
+    SECTION("Black pawns are looked up with the colors swapped", "[bitbases]")
+    {
+        // The opposition positions above, mirrored
+        REQUIRE(probe("8/8/8/8/8/3kp3/8/4K3 b - -") == Bitbases::WIN);
+        REQUIRE(probe("8/8/8/8/8/3kp3/8/4K3 w - -") == Bitbases::DRAW);
+        REQUIRE(probe("8/8/8/8/4p3/4k3/8/4K3 b - -") == Bitbases::WIN);
+        REQUIRE(probe("8/8/8/8/4p3/4k3/8/4K3 w - -") == Bitbases::LOSS);
+        REQUIRE(probe("8/8/8/8/p7/k7/8/K7 b - -") == Bitbases::DRAW);
+    }
+}
+
+} // anonymous namespace
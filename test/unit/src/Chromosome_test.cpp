@@ -0,0 +1,94 @@
+#include "../../catch.hpp"
+#include "Chromosome.hpp"
+#include "util.hpp"
+
+#include <sstream>
+
+namespace
+{
+using learning::Chromosome;
+using std::string;
+using std::vector;
+
+TEST_CASE("::learning::Chromosome")
+{
+    // Eight 9-bit features take 72 genes, so the last ones straddle two words
+    vector<int> features = {80, 10, 20, 10, 511, 0, 257, 300};
+    Chromosome chromosome(features);
+
+    SECTION("Features survive encoding and decoding", "[chromosome]")
+    {
+        vector<int> decoded;
+        chromosome.decode(decoded);
+        REQUIRE(decoded == features);
+        REQUIRE(chromosome.features_count() == features.size());
+    }
+
+    SECTION("Children take half of the genes of each parent", "[chromosome][crossover]")
+    {
+        Chromosome other(vector<int>(features.size(), 0));
+        std::pair<Chromosome, Chromosome> children;
+        chromosome.reproduce(other, children);
+
+        string genes = chromosome.get_genes();
+        uint half = genes.size() / 2;
+        REQUIRE(
+            children.first.get_genes() ==
+            genes.substr(0, half) + string(genes.size() - half, '0'));
+        REQUIRE(children.second.get_genes() == string(half, '0') + genes.substr(half));
+    }
+
+    SECTION("Mutation is reproducible from the random seed", "[chromosome][mutation]")
+    {
+        Chromosome copy(chromosome);
+        util::Random random(1), same_random(1);
+
+        chromosome.mutate(0.25, random);
+        copy.mutate(0.25, same_random);
+        REQUIRE(chromosome == copy);
+        REQUIRE(!(chromosome == Chromosome(features)));
+
+        chromosome.mutate(0.0, random);
+        REQUIRE(chromosome == copy);
+    }
+
+    SECTION("Mutation flips each gene with a given probability", "[chromosome][mutation]")
+    {
+        util::Random random(1);
+        string genes = chromosome.get_genes();
+        double probability = 1.0 / Chromosome::BITS_PER_FEATURE;
+
+        // About one gene of every feature, on average
+        uint flips = 0, mutations = 1000;
+        for (uint i = 0; i < mutations; ++i)
+        {
+            Chromosome mutant(chromosome);
+            mutant.mutate(probability, random);
+            string mutant_genes = mutant.get_genes();
+            for (uint j = 0; j < genes.size(); ++j)
+                flips += (mutant_genes[j] != genes[j]);
+        }
+        double mean_flips = double(flips) / mutations;
+        REQUIRE(mean_flips == Approx(genes.size() * probability).epsilon(0.05));
+        REQUIRE(mean_flips == Approx(features.size()).epsilon(0.05));
+    }
+
+    SECTION("Chromosomes can be saved and read back", "[chromosome][checkpoint]")
+    {
+        chromosome.set_fitness(0.75);
+        chromosome.set_result(Chromosome::WIN);
+
+        std::stringstream file;
+        chromosome.write(file);
+
+        Chromosome copy;
+        REQUIRE(copy.read(file));
+        REQUIRE(copy == chromosome);
+        REQUIRE(copy.get_fitness() == 0.75);
+        REQUIRE(copy.get_result() == Chromosome::WIN);
+
+        REQUIRE(!copy.read(file));
+    }
+}
+
+} // anonymous namespace
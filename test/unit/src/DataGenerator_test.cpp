@@ -0,0 +1,53 @@
+#include "../../catch.hpp"
+#include "DataGenerator.hpp"
+#include "PositionRecord.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+namespace
+{
+using learning::DataGenerator;
+using learning::DataGeneratorResult;
+using serialization::PositionRecord;
+using serialization::PositionRecordReader;
+using serialization::PositionRecordWriter;
+
+TEST_CASE("::learning::DataGenerator")
+{
+    SECTION("Scores are recorded in centipawns", "[datagen]")
+    {
+        const char *file = "data_generator_test.bin";
+        std::remove(file);
+
+        PositionRecordWriter writer;
+        REQUIRE(writer.open(file));
+        std::ostringstream report;
+        DataGeneratorResult result = DataGenerator(1, 2, 0, 1).run(1, writer, report);
+        REQUIRE(writer.close());
+        REQUIRE(result.games == 1);
+
+        PositionRecordReader reader;
+        REQUIRE(reader.open(file));
+        REQUIRE(reader.size() == result.positions);
+        REQUIRE(reader.size() > 0);
+
+        // A few random moves into the game, neither side is far ahead
+        const PositionRecord &first = reader[0];
+        REQUIRE((first.flags & PositionRecord::HAS_SCORE));
+        REQUIRE(std::abs(first.score) < 300);
+
+        for (size_t i = 0; i < reader.size(); ++i)
+        {
+            int score = std::abs(reader[i].score);
+            bool is_mate = score == PositionRecord::MATE_SCORE;
+            REQUIRE((score <= PositionRecord::MAX_SCORE || is_mate));
+        }
+
+        reader.close();
+        std::remove(file);
+    }
+}
+
+} // anonymous namespace
@@ -0,0 +1,102 @@
+#include "../../catch.hpp"
+#include "EpdReader.hpp"
+#include "FenReader.hpp"
+#include "MaeBoard.hpp"
+
+namespace
+{
+using rules::BoardSquare;
+using rules::CastleSide;
+using rules::MaeBoard;
+using rules::Move;
+using rules::Piece;
+using serialization::EpdReader;
+using serialization::EpdRecord;
+using serialization::FenReader;
+
+const char *START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+TEST_CASE("::serialization::FenReader")
+{
+    MaeBoard board;
+
+    SECTION("Loading the start position matches the default board", "[fen][smoke]")
+    {
+        MaeBoard loaded;
+        REQUIRE(FenReader(START_FEN, &loaded).load_position());
+        REQUIRE(loaded.get_hash_key() == board.get_hash_key());
+        REQUIRE(loaded.get_hash_lock() == board.get_hash_lock());
+        REQUIRE(loaded.get_piece(BoardSquare::e1) == Piece::KING);
+        REQUIRE(loaded.get_piece_color(BoardSquare::d8) == Piece::BLACK);
+    }
+
+    SECTION("Turn, castling and en-passant fields are loaded", "[fen]")
+    {
+        REQUIRE(FenReader("4k2r/8/8/3pP3/8/8/8/R3K3 w Qk d6 0 1", &board).load_position());
+        REQUIRE(board.current_player() == Piece::WHITE);
+        REQUIRE(board.can_castle(Piece::WHITE, CastleSide::QUEEN_SIDE));
+        REQUIRE(!board.can_castle(Piece::WHITE, CastleSide::KING_SIDE));
+        REQUIRE(board.can_castle(Piece::BLACK, CastleSide::KING_SIDE));
+        REQUIRE(!board.can_castle(Piece::BLACK, CastleSide::QUEEN_SIDE));
+        REQUIRE(board.is_en_passant_on());
+        REQUIRE(board.get_en_passant_square() == bits::to_bitboard[BoardSquare::d6]);
+    }
+
+    SECTION("Malformed positions are rejected", "[fen]")
+    {
+        REQUIRE(!FenReader("", &board).load_position());
+        REQUIRE(!FenReader("8/8/8/8/8/8/8/8 w - -", &board).load_position());
+        REQUIRE(!FenReader("4k3/8/8/8/8/8/8/4K3 x - -", &board).load_position());
+        REQUIRE(!FenReader("4k3/9/8/8/8/8/8/4K3 w - -", &board).load_position());
+        REQUIRE(!FenReader("4k3/8/8/8/8/8/4K3 w - -", &board).load_position());
+        REQUIRE(!FenReader("4k3/08/8/8/8/8/8/4K3 w - -", &board).load_position());
+        REQUIRE(board.get_all_pieces() == 0);
+    }
+
+    SECTION("Positions where the side not to move is in check are rejected", "[fen]")
+    {
+        REQUIRE(!FenReader("4k3/8/8/8/8/8/8/4RK2 w - -", &board).load_position());
+        REQUIRE(!FenReader("4k3/3P4/8/8/8/8/8/4K3 w - -", &board).load_position());
+        REQUIRE(!FenReader("4r1k1/8/8/8/8/8/8/4K3 b - -", &board).load_position());
+
+        // The side to move may be in check
+        REQUIRE(FenReader("4k3/8/8/8/8/8/8/4RK2 b - -", &board).load_position());
+        REQUIRE(board.current_player() == Piece::BLACK);
+        REQUIRE(board.is_king_in_check());
+    }
+
+    SECTION("Black to move is hashed as after a move by white", "[fen]")
+    {
+        Move move("e2e4");
+        REQUIRE(board.make_move(move, false) == MaeBoard::NO_ERROR);
+
+        MaeBoard loaded;
+        const char *fen = "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1";
+        REQUIRE(FenReader(fen, &loaded).load_position());
+        REQUIRE(loaded.get_hash_key() == board.get_hash_key());
+        REQUIRE(loaded.get_hash_lock() == board.get_hash_lock());
+    }
+}
+
+TEST_CASE("::serialization::EpdReader")
+{
+    SECTION("Operations are split from the position", "[epd]")
+    {
+        EpdRecord record;
+        REQUIRE(EpdReader::parse("6k1/8/8/8/8/8/8/R5K1 w - - bm Ra8#; id \"mate 1\";", record));
+        REQUIRE(record.position == "6k1/8/8/8/8/8/8/R5K1 w - -");
+        REQUIRE(record.get_operation("bm") == "Ra8#");
+        REQUIRE(record.get_operation("id") == "mate 1");
+        REQUIRE(!record.has_operation("am"));
+    }
+
+    SECTION("FEN move counters are not mistaken for operations", "[epd]")
+    {
+        EpdRecord record;
+        REQUIRE(EpdReader::parse(START_FEN, record));
+        REQUIRE(record.position == "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq -");
+        REQUIRE(record.operations.empty());
+    }
+}
+
+} // anonymous namespace
@@ -0,0 +1,49 @@
+#include "../../catch.hpp"
+#include "FenReader.hpp"
+#include "MaeBoard.hpp"
+#include "Move.hpp"
+
+namespace
+{
+using rules::BoardSquare;
+using rules::IBoard;
+using rules::MaeBoard;
+using rules::Move;
+using rules::Piece;
+using serialization::FenReader;
+
+TEST_CASE("::rules::MaeBoard")
+{
+    MaeBoard board;
+    Move move("e2e4");
+    REQUIRE(board.make_move(move, true) == IBoard::NO_ERROR);
+
+    SECTION("A clone is independent of the original board", "[board][clone]")
+    {
+        std::unique_ptr<MaeBoard> clone = board.clone();
+        REQUIRE(clone->get_hash_key() == board.get_hash_key());
+        REQUIRE(clone->get_hash_lock() == board.get_hash_lock());
+        REQUIRE(clone->current_player() == Piece::BLACK);
+
+        Move reply("e7e5");
+        REQUIRE(clone->make_move(reply, true) == IBoard::NO_ERROR);
+        REQUIRE(clone->get_piece(BoardSquare::e5) == Piece::PAWN);
+        REQUIRE(board.get_piece(BoardSquare::e5) == Piece::NULL_PIECE);
+        REQUIRE(board.current_player() == Piece::BLACK);
+    }
+
+    SECTION("Moves made before copying can be taken back", "[board][clone]")
+    {
+        MaeBoard copy;
+        REQUIRE(FenReader("4k3/8/8/8/8/8/8/4K3 w - - 0 1", &copy).load_position());
+        copy.copy_from(board);
+        REQUIRE(copy.undo_move());
+
+        MaeBoard start;
+        REQUIRE(copy.get_hash_key() == start.get_hash_key());
+        REQUIRE(copy.get_piece(BoardSquare::e2) == Piece::PAWN);
+        REQUIRE(copy.get_repetition_count() == start.get_repetition_count());
+    }
+}
+
+} // anonymous namespace
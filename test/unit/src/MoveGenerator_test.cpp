@@ -0,0 +1,51 @@
+#include "../../catch.hpp"
+#include "FenReader.hpp"
+#include "MaeBoard.hpp"
+#include "MoveGenerator.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+using engine::IMoveGenerator;
+using engine::MoveGenerator;
+using rules::MaeBoard;
+using rules::Move;
+using rules::Piece;
+using serialization::FenReader;
+
+TEST_CASE("::engine::MoveGenerator")
+{
+    MaeBoard board;
+    MoveGenerator generator;
+    std::vector<Move> moves;
+
+    SECTION("En-passant captures take a pawn", "[movegen][en-passant]")
+    {
+        REQUIRE(FenReader("4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1", &board).load_position());
+
+        auto find_capture = [&]() {
+            return std::find_if(moves.begin(), moves.end(), [](const Move &move) {
+                return move.to_notation() == "e5d6";
+            });
+        };
+
+        generator.generate_moves(&board, moves);
+        auto capture = find_capture();
+        REQUIRE(capture != moves.end());
+        REQUIRE(capture->type() == Move::EN_PASSANT_CAPTURE);
+        REQUIRE(capture->captured_piece() == Piece::PAWN);
+
+        // Pawn takes pawn scores as any other equal trade
+        REQUIRE(capture->score() == 10);
+
+        moves.clear();
+        generator.generate_moves(&board, moves, IMoveGenerator::CAPTURES);
+        capture = find_capture();
+        REQUIRE(capture != moves.end());
+        REQUIRE(capture->captured_piece() == Piece::PAWN);
+    }
+}
+
+} // anonymous namespace
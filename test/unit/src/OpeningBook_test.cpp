@@ -0,0 +1,140 @@
+#include "../../catch.hpp"
+#include "FenReader.hpp"
+#include "MaeBoard.hpp"
+#include "Move.hpp"
+#include "OpeningBook.hpp"
+#include "util.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+namespace
+{
+using engine::OpeningBook;
+using rules::MaeBoard;
+using rules::Move;
+using serialization::FenReader;
+using std::vector;
+
+void write_big_endian(std::ostream &out, ullong value, uint size)
+{
+    for (uint i = size; i > 0; --i)
+        out.put((char)(value >> 8 * (i - 1)));
+}
+
+void write_entry(std::ostream &out, ullong key, ushort move, ushort weight)
+{
+    write_big_endian(out, key, 8);
+    write_big_endian(out, move, 2);
+    write_big_endian(out, weight, 2);
+    write_big_endian(out, 0, 4);
+}
+
+TEST_CASE("::engine::OpeningBook")
+{
+    MaeBoard board;
+    OpeningBook book;
+
+    SECTION("Keys depend on the turn, castling and capturable pawns", "[book]")
+    {
+        ullong start_key = OpeningBook::compute_key(board);
+        REQUIRE(start_key == OpeningBook::compute_key(MaeBoard()));
+
+        Move move("e2e4");
+        REQUIRE(board.make_move(move, false) == MaeBoard::NO_ERROR);
+        ullong key = OpeningBook::compute_key(board);
+        REQUIRE(key != start_key);
+
+        // No black pawn can take on e3, so the en-passant square does not count
+        REQUIRE(FenReader(
+                    "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3", &board)
+                    .load_position());
+        REQUIRE(OpeningBook::compute_key(board) == key);
+
+        REQUIRE(FenReader(
+                    "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b Kkq -", &board)
+                    .load_position());
+        REQUIRE(OpeningBook::compute_key(board) != key);
+    }
+
+    SECTION("Keys are those of Polyglot books", "[book]")
+    {
+        // The reference keys of the Polyglot book format
+        REQUIRE(OpeningBook::compute_key(board) == 0x463B96181691FC9CuLL);
+
+        Move move("e2e4");
+        REQUIRE(board.make_move(move, false) == MaeBoard::NO_ERROR);
+        REQUIRE(OpeningBook::compute_key(board) == 0x823C9B50FD114196uLL);
+
+        // The pawn on e5 can take on f6
+        REQUIRE(FenReader(
+                    "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6", &board)
+                    .load_position());
+        REQUIRE(OpeningBook::compute_key(board) == 0x22A48B5A8E47FF78uLL);
+
+        REQUIRE(FenReader(
+                    "rnbq1bnr/ppp1pkpp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR w - -", &board)
+                    .load_position());
+        REQUIRE(OpeningBook::compute_key(board) == 0x00FDD303C946BDD9uLL);
+    }
+
+    SECTION("Castling is written as the king taking its own rook", "[book]")
+    {
+        REQUIRE(FenReader("r3k2r/8/8/8/8/8/8/R3K2R w KQkq -", &board).load_position());
+
+        Move castle("e1g1"), decoded;
+        ushort code = OpeningBook::encode_move(castle, board);
+        REQUIRE((code & 63) == 7);
+        REQUIRE(OpeningBook::decode_move(code, board, decoded));
+        REQUIRE(decoded.to_notation() == "e1g1");
+
+        code = OpeningBook::encode_move(Move("e1c1"), board);
+        REQUIRE(OpeningBook::decode_move(code, board, decoded));
+        REQUIRE(decoded.to_notation() == "e1c1");
+    }
+
+    SECTION("Moves are looked up in the mapped file", "[book]")
+    {
+        const char *file = "opening_book_test.bin";
+        vector<ullong> keys = {1, OpeningBook::compute_key(board), ~0uLL};
+        std::sort(keys.begin(), keys.end());
+        {
+            ushort e4 = OpeningBook::encode_move(Move("e2e4"), board);
+            ushort d4 = OpeningBook::encode_move(Move("d2d4"), board);
+
+            std::ofstream out(file, std::ios::binary);
+            for (ullong key : keys)
+            {
+                write_entry(out, key, e4, 3);
+                if (key == OpeningBook::compute_key(board))
+                    write_entry(out, key, d4, 1);
+            }
+        }
+
+        REQUIRE(book.open(file));
+        REQUIRE(book.size() == 4);
+
+        vector<Move> moves;
+        vector<uint> weights;
+        book.get_moves(board, moves, weights);
+        REQUIRE(moves.size() == 2);
+        REQUIRE(moves[0].to_notation() == "e2e4");
+        REQUIRE(moves[1].to_notation() == "d2d4");
+        REQUIRE(weights == vector<uint>({3, 1}));
+
+        util::Random random(1);
+        Move move;
+        REQUIRE(book.get_move(board, random, move));
+        REQUIRE((move.to_notation() == "e2e4" || move.to_notation() == "d2d4"));
+
+        Move e4("e2e4");
+        REQUIRE(board.make_move(e4, false) == MaeBoard::NO_ERROR);
+        REQUIRE(!book.get_move(board, random, move));
+
+        book.close();
+        std::remove(file);
+    }
+}
+
+} // anonymous namespace
@@ -0,0 +1,42 @@
+#include "../../catch.hpp"
+#include "FenReader.hpp"
+#include "MaeBoard.hpp"
+#include "Perft.hpp"
+
+namespace
+{
+using engine::Perft;
+using engine::PerftResult;
+using rules::MaeBoard;
+using serialization::FenReader;
+
+TEST_CASE("::engine::Perft")
+{
+    MaeBoard board;
+    Perft perft(2, 16);
+
+    SECTION("The initial position has the known counts", "[perft][smoke]")
+    {
+        PerftResult result = perft.run(board, 3);
+        REQUIRE(result.moves.size() == 20);
+        REQUIRE(result.nodes == 8902);
+
+        // Counted again from the hash table
+        REQUIRE(perft.run(board, 3).nodes == 8902);
+        REQUIRE(perft.run(board, 0).nodes == 1);
+    }
+
+    SECTION("Castling and en passant are counted", "[perft]")
+    {
+        const char *kiwipete =
+            "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+        REQUIRE(FenReader(kiwipete, &board).load_position());
+        REQUIRE(perft.run(board, 3).nodes == 97862);
+
+        const char *endgame = "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1";
+        REQUIRE(FenReader(endgame, &board).load_position());
+        REQUIRE(perft.run(board, 4).nodes == 43238);
+    }
+}
+
+} // anonymous namespace
@@ -0,0 +1,79 @@
+#include "../../catch.hpp"
+#include "FenWriter.hpp"
+#include "MaeBoard.hpp"
+#include "Move.hpp"
+#include "PgnReader.hpp"
+#include "PgnWriter.hpp"
+
+#include <sstream>
+
+namespace
+{
+using rules::MaeBoard;
+using rules::Move;
+using serialization::FenWriter;
+using serialization::PgnGame;
+using serialization::PgnReader;
+using serialization::PgnWriter;
+
+TEST_CASE("::serialization::PgnReader")
+{
+    std::istringstream input(
+        "[Event \"Casual \\\"game\\\"\"]\n"
+        "[Result \"1-0\"]\n"
+        "\n"
+        "1. e4 e5 2.Nf3 {A comment\n"
+        "over two lines} Nc6 (2... d6 3. d4) 3. Bc4 $1 Nd4?! ; the rest is ignored\n"
+        "4. Nxe5 Qg5 5. Nxf7 Qxg2 6. Rf1 Qxe4+ 7. Be2 Nf3# 0-1\n"
+        "\n"
+        "[Event \"Unfinished\"]\n"
+        "[SetUp \"1\"]\n"
+        "[FEN \"4k3/8/8/8/8/8/4P3/4K3 b - - 0 40\"]\n"
+        "\n"
+        "40... Kd7 41. e4\n");
+    PgnReader reader(input);
+    PgnGame game;
+    MaeBoard board;
+    std::vector<Move> moves;
+
+    SECTION("Games are read one at a time and played on a board", "[pgn][smoke]")
+    {
+        REQUIRE(reader.next(game));
+        REQUIRE(game.get_tag("Event") == "Casual \"game\"");
+        REQUIRE(game.moves.size() == 14);
+        REQUIRE(game.moves[2] == "Nf3");
+        REQUIRE(game.moves[3] == "Nc6");
+        REQUIRE(game.result == "0-1");
+        REQUIRE(game.play(&board, moves));
+        REQUIRE(moves.back().to_notation() == "d4f3");
+
+        REQUIRE(reader.next(game));
+        REQUIRE(game.get_tag("Event") == "Unfinished");
+        REQUIRE(game.moves.size() == 2);
+        REQUIRE(game.result.empty());
+        REQUIRE(game.play(&board, moves));
+        REQUIRE(FenWriter::write(board).find("8/3k4/8/8/4P3/8/8/4K3 b - ") == 0);
+
+        REQUIRE(!reader.next(game));
+    }
+
+    SECTION("Written games read back the same", "[pgn]")
+    {
+        std::ostringstream output;
+        PgnWriter writer(output);
+        while (reader.next(game))
+            writer.write(game);
+
+        std::istringstream written(output.str());
+        PgnReader other_reader(written);
+        REQUIRE(other_reader.next(game));
+        REQUIRE(game.get_tag("Site") == "?");
+        REQUIRE(game.moves.size() == 14);
+        REQUIRE(other_reader.next(game));
+        REQUIRE(game.result == "*");
+        REQUIRE(game.moves.front() == "Kd7");
+        REQUIRE(output.str().find("40... Kd7 41. e4 *") != std::string::npos);
+    }
+}
+
+} // anonymous namespace
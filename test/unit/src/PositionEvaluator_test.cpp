@@ -0,0 +1,89 @@
+#include "../../catch.hpp"
+#include "FenReader.hpp"
+#include "MaeBoard.hpp"
+#include "PositionEvaluator.hpp"
+
+#include <vector>
+
+namespace
+{
+using engine::PositionEvaluator;
+using rules::MaeBoard;
+using serialization::FenReader;
+
+TEST_CASE("::engine::PositionEvaluator")
+{
+    MaeBoard board;
+    PositionEvaluator evaluator;
+    PositionEvaluator::FeatureVector features;
+
+    SECTION("Features are white's values minus black's", "[evaluation][features]")
+    {
+        evaluator.extract_features(&board, features);
+        for (int i = PositionEvaluator::PAWN_COUNT; i <= PositionEvaluator::QUEEN_COUNT;
+             ++i)
+            REQUIRE(features[i] == 0);
+        REQUIRE(features[PositionEvaluator::KING_SAFETY_VALUE] == 0);
+
+        REQUIRE(FenReader("4k3/8/8/8/8/8/8/R3K3 w - -", &board).load_position());
+        evaluator.extract_features(&board, features);
+        REQUIRE(features[PositionEvaluator::ROOK_COUNT] == 1);
+        REQUIRE(features[PositionEvaluator::PAWN_COUNT] == 0);
+        REQUIRE(features[PositionEvaluator::ROOK_MOBILITY] > 0);
+    }
+
+    SECTION("Features are extracted in bulk as one by one", "[evaluation][features]")
+    {
+        MaeBoard other;
+        REQUIRE(FenReader("4k3/8/8/8/8/8/8/R3K3 w - -", &other).load_position());
+        const MaeBoard *boards[] = {&board, &other};
+        PositionEvaluator::FeatureVector bulk[2];
+        evaluator.extract_features(boards, 2, bulk);
+
+        for (int i = 0; i < 2; ++i)
+        {
+            evaluator.extract_features(boards[i], features);
+            REQUIRE(bulk[i] == features);
+        }
+    }
+
+    SECTION("The evaluation is the dot product of features and weights", "[evaluation]")
+    {
+        REQUIRE(FenReader(
+                    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R b KQkq -",
+                    &board)
+                    .load_position());
+        evaluator.extract_features(&board, features);
+
+        int evaluation;
+        evaluator.evaluate_features(&features, 1, &evaluation);
+        REQUIRE(evaluation == evaluator.evaluate_features(features));
+
+        // Black is to move, so the search sees the evaluation from its side
+        REQUIRE(evaluator.static_evaluation(&board) == -evaluation);
+        REQUIRE(
+            evaluator.static_evaluation(&board) ==
+            -(evaluator.get_factor_weight(PositionEvaluator::MATERIAL) *
+                  evaluator.evaluate_material(&board) +
+              evaluator.get_factor_weight(PositionEvaluator::MOBILITY) *
+                  evaluator.evaluate_mobility(&board) +
+              evaluator.get_factor_weight(PositionEvaluator::CENTER_CONTROL) *
+                  evaluator.evaluate_center_control(&board) +
+              evaluator.get_factor_weight(PositionEvaluator::KING_SAFETY) *
+                  evaluator.evaluate_king_safety(&board)));
+    }
+
+    SECTION("Evaluations convert to centipawns by the weight of a pawn", "[evaluation]")
+    {
+        int pawn = evaluator.get_feature_weights()[PositionEvaluator::PAWN_COUNT];
+        REQUIRE(evaluator.to_centipawns(pawn) == 100);
+        REQUIRE(evaluator.to_centipawns(-3 * pawn / 2) == -150);
+
+        // Without a material weight there is no pawn to measure by
+        std::vector<int> weights = {0, 780, 916, 22};
+        evaluator.load_factor_weights(weights);
+        REQUIRE(evaluator.to_centipawns(1234) == 1234);
+    }
+}
+
+} // anonymous namespace
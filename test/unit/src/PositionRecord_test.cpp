@@ -0,0 +1,118 @@
+#include "../../catch.hpp"
+#include "FenReader.hpp"
+#include "FenWriter.hpp"
+#include "MaeBoard.hpp"
+#include "PositionRecord.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+namespace
+{
+using rules::MaeBoard;
+using serialization::FenReader;
+using serialization::FenWriter;
+using serialization::PositionRecord;
+using serialization::PositionRecordReader;
+using serialization::PositionRecordWriter;
+
+TEST_CASE("::serialization::PositionRecord")
+{
+    MaeBoard board;
+    PositionRecord record;
+
+    SECTION("Records hold the whole position", "[records][smoke]")
+    {
+        const char *fen = "r3k2r/pp3ppp/8/3pP3/8/8/PPP2PPP/R3K1NR w KQk d6 0 1";
+        REQUIRE(FenReader(fen, &board).load_position());
+
+        short score = -35;
+        REQUIRE(PositionRecord::pack(board, PositionRecord::DRAW, record, &score));
+        REQUIRE(sizeof(record) == 32);
+        REQUIRE(record.get_white_score() == 0.5);
+
+        MaeBoard other;
+        REQUIRE(record.unpack(&other));
+        REQUIRE(FenWriter::write(other) == fen);
+        REQUIRE(other.get_hash_key() == board.get_hash_key());
+        REQUIRE(record.score == -35);
+    }
+
+    SECTION("Records with more pieces than codes are rejected", "[records]")
+    {
+        REQUIRE(PositionRecord::pack(board, PositionRecord::DRAW, record, nullptr));
+        REQUIRE(record.unpack(&board));
+
+        // One more square occupied than there are piece codes
+        record.occupancy |= bits::to_bitboard[rules::BoardSquare::e4];
+        REQUIRE(!record.unpack(&board));
+        REQUIRE(board.get_all_pieces() == 0);
+    }
+
+    SECTION("Written records can be read back in place", "[records][persistence]")
+    {
+        const char *file = "position_record_test.bin";
+        std::remove(file);
+
+        PositionRecordWriter writer;
+        REQUIRE(writer.open(file));
+        bool is_written = PositionRecord::pack(board, PositionRecord::WHITE_WINS, record);
+        for (uint i = 0; i < 5000; ++i)
+            is_written = writer.write(record) && is_written;
+        REQUIRE(is_written);
+        REQUIRE(writer.close());
+
+        PositionRecordReader reader;
+        REQUIRE(reader.open(file));
+        REQUIRE(reader.size() == 5000);
+        REQUIRE(reader[4999].result == PositionRecord::WHITE_WINS);
+        REQUIRE(!(reader[4999].flags & PositionRecord::HAS_SCORE));
+        REQUIRE(reader[4999].unpack(&board));
+        REQUIRE(FenWriter::write(board) == FenReader::START_POSITION);
+
+        reader.close();
+        std::remove(file);
+    }
+
+    SECTION("Records appended after a partial one stay aligned", "[records][persistence]")
+    {
+        const char *file = "position_record_test.bin";
+        std::remove(file);
+
+        PositionRecordWriter writer;
+        REQUIRE(writer.open(file));
+        REQUIRE(PositionRecord::pack(board, PositionRecord::WHITE_WINS, record));
+        REQUIRE(writer.write(record));
+        REQUIRE(writer.close());
+
+        // As left by a writer killed in the middle of a record
+        std::ofstream(file, std::ios::binary | std::ios::app).write("partial", 7);
+
+        MaeBoard other;
+        REQUIRE(FenReader("4k3/8/8/8/8/8/8/4K2R w K - 0 1", &other).load_position());
+        REQUIRE(writer.open(file));
+        auto file_size = [&]() {
+            return std::ifstream(file, std::ios::binary | std::ios::ate).tellg();
+        };
+        REQUIRE(file_size() == 2 * sizeof(PositionRecord));
+
+        REQUIRE(PositionRecord::pack(other, PositionRecord::BLACK_WINS, record));
+        REQUIRE(writer.write(record));
+        REQUIRE(writer.close());
+
+        PositionRecordReader reader;
+        REQUIRE(reader.open(file));
+        REQUIRE(reader.size() == 2);
+        REQUIRE(reader[0].result == PositionRecord::WHITE_WINS);
+        REQUIRE(reader[0].unpack(&board));
+        REQUIRE(FenWriter::write(board) == FenReader::START_POSITION);
+        REQUIRE(reader[1].result == PositionRecord::BLACK_WINS);
+        REQUIRE(reader[1].unpack(&board));
+        REQUIRE(FenWriter::write(board) == "4k3/8/8/8/8/8/8/4K2R w K - 0 1");
+
+        reader.close();
+        std::remove(file);
+    }
+}
+
+} // anonymous namespace
@@ -0,0 +1,57 @@
+#include "../../catch.hpp"
+#include "FenReader.hpp"
+#include "MaeBoard.hpp"
+#include "Move.hpp"
+#include "SanNotation.hpp"
+
+namespace
+{
+using rules::MaeBoard;
+using rules::Move;
+using serialization::FenReader;
+using serialization::SanNotation;
+
+TEST_CASE("::serialization::SanNotation")
+{
+    MaeBoard board;
+
+    SECTION("Simple moves and captures", "[san][smoke]")
+    {
+        REQUIRE(SanNotation::to_san(&board, Move("e2e4")) == "e4");
+        REQUIRE(SanNotation::to_san(&board, Move("g1f3")) == "Nf3");
+        REQUIRE(SanNotation::to_san(&board, Move("e2e5")) == "");
+
+        REQUIRE(FenReader("4k3/8/8/3p4/4P3/8/8/4K3 w - -", &board).load_position());
+        REQUIRE(SanNotation::to_san(&board, Move("e4d5")) == "exd5");
+    }
+
+    SECTION("Ambiguous moves name the file or rank they start from", "[san]")
+    {
+        REQUIRE(FenReader("4k3/8/8/8/8/8/8/R4RK1 w - -", &board).load_position());
+        REQUIRE(SanNotation::to_san(&board, Move("a1d1")) == "Rad1");
+
+        REQUIRE(FenReader("4k3/8/8/R7/8/8/8/R3K3 w - -", &board).load_position());
+        REQUIRE(SanNotation::to_san(&board, Move("a1a3")) == "R1a3");
+    }
+
+    SECTION("Castling, promotions and checks", "[san]")
+    {
+        REQUIRE(FenReader("6k1/P4ppp/8/8/8/8/8/R3K2R w KQ -", &board).load_position());
+        REQUIRE(SanNotation::to_san(&board, Move("e1g1")) == "O-O");
+        REQUIRE(SanNotation::to_san(&board, Move("e1c1")) == "O-O-O");
+        REQUIRE(SanNotation::to_san(&board, Move("a7a8")) == "a8=Q#");
+        REQUIRE(SanNotation::to_san(&board, Move("a1a6")) == "Ra6");
+    }
+
+    SECTION("Parsing ignores annotations and accepts coordinates", "[san]")
+    {
+        Move move;
+        REQUIRE(SanNotation::parse("Nf3!", &board, move));
+        REQUIRE(move == Move("g1f3"));
+        REQUIRE(SanNotation::parse("e2e4", &board, move));
+        REQUIRE(move == Move("e2e4"));
+        REQUIRE(!SanNotation::parse("Ke2", &board, move));
+    }
+}
+
+} // anonymous namespace
@@ -0,0 +1,122 @@
+#include "../../catch.hpp"
+#include "FenReader.hpp"
+#include "MaeBoard.hpp"
+#include "PositionEvaluator.hpp"
+#include "TexelTuner.hpp"
+
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+using engine::PositionEvaluator;
+using learning::TexelTuner;
+using rules::MaeBoard;
+using rules::Piece;
+using serialization::FenReader;
+using std::string;
+using std::vector;
+
+/*==============================================================================
+  Positions a side is up some material in, each labeled with as many wins,
+  draws and losses for white as make a larger advantage win more often, and
+  their mirrors with black up the same material. Every advantage loses or
+  draws now and then, so there are weights that predict the results best.
+  ==============================================================================*/
+string synthetic_dataset()
+{
+    struct Sample
+    {
+        const char *white_up;
+        const char *black_up;
+        uint wins;
+        uint draws;
+        uint losses;
+    };
+    const Sample SAMPLES[] = {
+        {"4k3/8/8/8/8/8/8/4K3 w - -", "4k3/8/8/8/8/8/8/4K3 b - -", 0, 4, 0},
+        {"4k3/pp6/8/8/8/8/PPP5/4K3 w - -", "4k3/ppp5/8/8/8/8/PP6/4K3 b - -", 4, 4, 2},
+        {"4k3/8/8/8/8/8/8/1N2K3 w - -", "1n2k3/8/8/8/8/8/8/4K3 b - -", 7, 2, 1},
+        {"4k3/8/8/8/8/8/8/R3K3 w - -", "r3k3/8/8/8/8/8/8/4K3 b - -", 18, 1, 1},
+        {"4k3/8/8/8/8/8/8/3QK3 w - -", "3qk3/8/8/8/8/8/8/4K3 b - -", 38, 1, 1}};
+
+    std::ostringstream dataset;
+    auto add = [&](const char *position, uint count, const char *result) {
+        for (uint i = 0; i < count; ++i)
+            dataset << position << " c9 \"" << result << "\";" << std::endl;
+    };
+    for (const Sample &sample : SAMPLES)
+    {
+        add(sample.white_up, sample.wins, "1-0");
+        add(sample.white_up, sample.draws, "1/2-1/2");
+        add(sample.white_up, sample.losses, "0-1");
+        add(sample.black_up, sample.losses, "1-0");
+        add(sample.black_up, sample.draws, "1/2-1/2");
+        add(sample.black_up, sample.wins, "0-1");
+    }
+    return dataset.str();
+}
+
+TEST_CASE("::learning::TexelTuner")
+{
+    TexelTuner tuner(2);
+    std::istringstream dataset(synthetic_dataset());
+    std::ostringstream report;
+
+    SECTION("Tuning reduces the error until the weights settle", "[tuning]")
+    {
+        REQUIRE(tuner.load(dataset) == 168);
+
+        tuner.tune(0, 1.0, report);
+        double initial_error = tuner.get_error();
+
+        tuner.tune(400, 2.0, report);
+        double error = tuner.get_error();
+        REQUIRE(error < initial_error);
+
+        vector<int> weights = tuner.get_factor_weights();
+        vector<int> values = tuner.get_piece_values();
+        REQUIRE(values[Piece::PAWN] == 100);
+        REQUIRE(values[Piece::PAWN] < values[Piece::KNIGHT]);
+        REQUIRE(values[Piece::KNIGHT] < values[Piece::ROOK]);
+        REQUIRE(values[Piece::ROOK] < values[Piece::QUEEN]);
+
+        // Further steps barely improve the fit, nor move the weights much
+        tuner.tune(100, 2.0, report);
+        REQUIRE(tuner.get_error() <= error + 1e-6);
+        REQUIRE(error - tuner.get_error() < (initial_error - error) / 10);
+        for (uint i = 0; i < weights.size(); ++i)
+            REQUIRE(std::abs(tuner.get_factor_weights()[i] - weights[i]) < 40);
+        for (uint i = 0; i < values.size(); ++i)
+            REQUIRE(std::abs(tuner.get_piece_values()[i] - values[i]) < 40);
+    }
+
+    SECTION("Tuned piece values are those the evaluator uses", "[tuning]")
+    {
+        REQUIRE(tuner.load(dataset) == 168);
+        tuner.tune(50, 2.0, report);
+
+        PositionEvaluator evaluator;
+        vector<int> weights = tuner.get_factor_weights();
+        evaluator.load_factor_weights(weights);
+        evaluator.load_piece_values(tuner.get_piece_values());
+        for (Piece::Type piece = Piece::PAWN; piece <= Piece::QUEEN; ++piece)
+            REQUIRE(evaluator.get_piece_value(piece) == tuner.get_piece_values()[piece]);
+
+        // A queen up is worth the tuned queen value
+        MaeBoard board;
+        REQUIRE(FenReader("4k3/8/8/8/8/8/8/3QK3 w - -", &board).load_position());
+        PositionEvaluator::FeatureVector features;
+        evaluator.extract_features(&board, features);
+        REQUIRE(features[PositionEvaluator::QUEEN_COUNT] == 1);
+
+        int queen_weight = weights[PositionEvaluator::MATERIAL] *
+                           tuner.get_piece_values()[Piece::QUEEN];
+        REQUIRE(evaluator.get_feature_weights()[PositionEvaluator::QUEEN_COUNT] ==
+                queen_weight);
+    }
+}
+
+} // anonymous namespace
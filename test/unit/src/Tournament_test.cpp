@@ -0,0 +1,81 @@
+#include "../../catch.hpp"
+#include "FenReader.hpp"
+#include "Tournament.hpp"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+using engine::SprtSettings;
+using engine::Tournament;
+using engine::TournamentResult;
+using serialization::FenReader;
+using std::string;
+using std::vector;
+
+TEST_CASE("::engine::TournamentResult")
+{
+    SprtSettings sprt = {0.0, 10.0, 0.05, 0.05};
+    TournamentResult result = {};
+
+    SECTION("The SPRT bounds follow from the error rates", "[tournament][sprt]")
+    {
+        REQUIRE(sprt.get_lower_bound() == Approx(-2.944).epsilon(0.001));
+        REQUIRE(sprt.get_upper_bound() == Approx(2.944).epsilon(0.001));
+    }
+
+    SECTION("Winning pairs favor H1 and losing pairs favor H0", "[tournament][sprt]")
+    {
+        REQUIRE(result.get_log_likelihood_ratio(sprt) == 0.0);
+
+        // A single won pair is not enough to decide
+        result.pair_scores[4] = 1;
+        result.pairs = 1;
+        REQUIRE(result.get_log_likelihood_ratio(sprt) > 0.0);
+        REQUIRE(result.get_log_likelihood_ratio(sprt) < sprt.get_upper_bound());
+
+        result.pair_scores[4] = 100;
+        result.pair_scores[2] = 100;
+        result.pairs = 200;
+        REQUIRE(result.get_log_likelihood_ratio(sprt) > sprt.get_upper_bound());
+
+        result.pair_scores[4] = 0;
+        result.pair_scores[0] = 100;
+        REQUIRE(result.get_log_likelihood_ratio(sprt) < sprt.get_lower_bound());
+    }
+
+    SECTION("Matches where every pair ends the same are decided", "[tournament][sprt]")
+    {
+        // Pairs won 2-0 accept H1, pairs split 1-1 accept H0
+        result.pair_scores[4] = 20;
+        result.pairs = 20;
+        REQUIRE(result.get_log_likelihood_ratio(sprt) > sprt.get_upper_bound());
+
+        result.pair_scores[4] = 0;
+        result.pair_scores[2] = 100;
+        result.pairs = 100;
+        REQUIRE(result.get_log_likelihood_ratio(sprt) < sprt.get_lower_bound());
+    }
+}
+
+TEST_CASE("::engine::Tournament")
+{
+    SECTION("A one-sided match stops early", "[tournament][sprt]")
+    {
+        // A baseline that values material negatively throws its pieces away
+        Tournament tournament(1, 1, 0);
+        tournament.set_players({502, 780, 916, 22}, {-502, 780, 916, 22});
+
+        std::ostringstream report;
+        vector<string> openings = {FenReader::START_POSITION};
+        TournamentResult result = tournament.run(openings, 100, report);
+
+        REQUIRE(result.decision == TournamentResult::H1_ACCEPTED);
+        REQUIRE(result.pairs < 100);
+        REQUIRE(result.wins > result.losses);
+    }
+}
+
+} // anonymous namespace
@@ -0,0 +1,65 @@
+#include "../../catch.hpp"
+#include "TranspositionTable.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+namespace
+{
+using engine::BoardEntry;
+using engine::TranspositionTable;
+using rules::BoardKey;
+using rules::Move;
+
+TEST_CASE("::engine::TranspositionTable")
+{
+    TranspositionTable table(16);
+    BoardKey key = {12345, 67890};
+    Move move("e2e4");
+    move.set_type(Move::SIMPLE_MOVE);
+    BoardEntry entry = {35, 4, engine::EXACT, move}, stored;
+
+    SECTION("Deeper searches of a board replace shallower ones", "[hash]")
+    {
+        REQUIRE(!table.get(key, stored));
+        REQUIRE(table.add(key, entry));
+
+        entry.depth = 2;
+        REQUIRE(!table.add(key, entry));
+        REQUIRE(table.get(key, stored));
+        REQUIRE(stored.depth == 4);
+        REQUIRE(stored.score == 35);
+        REQUIRE(stored.best_move.to_notation() == "e2e4");
+        REQUIRE(stored.best_move.type() == Move::SIMPLE_MOVE);
+
+        table.clear();
+        REQUIRE(!table.get(key, stored));
+        REQUIRE(table.size() == 0);
+    }
+
+    SECTION("Saved tables can be loaded by another one", "[hash][persistence]")
+    {
+        const char *file = "transposition_table_test.tt";
+        table.add(key, entry);
+        REQUIRE(table.save(file));
+
+        TranspositionTable other(32);
+        REQUIRE(other.load(file));
+        REQUIRE(other.capacity() == table.capacity());
+        REQUIRE(other.get(key, stored));
+        REQUIRE(stored.score == 35);
+
+        // Images written by other versions of the program are refused
+        {
+            std::fstream image(file, std::ios::binary | std::ios::in | std::ios::out);
+            image.seekp(8);
+            image.put(99);
+        }
+        REQUIRE(!other.load(file));
+        REQUIRE(other.get(key, stored));
+
+        std::remove(file);
+    }
+}
+
+} // anonymous namespace